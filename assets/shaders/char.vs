@@ -8,8 +8,11 @@ out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoords;
 
-uniform mat4 u_viewMat;
-uniform mat4 u_projMat;
+// Per-frame camera, uploaded once by the Renderer (uniform buffer binding 0)
+layout(std140) uniform Camera {
+    mat4 u_viewMat;
+    mat4 u_projMat;
+};
 
 uniform vec3 u_position;
 uniform vec3 u_scale;
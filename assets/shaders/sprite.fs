@@ -0,0 +1,19 @@
+#version 330 core
+
+in vec2 TexCoords;            // from your vertex shader
+flat in vec4 AtlasRect;       // xy = region offset, zw = region size (page UVs)
+uniform sampler2D u_texture;  // bound to GL_TEXTURE0
+
+out vec4 FragColor;
+
+void main() {
+    if (AtlasRect.z >= 1.0 && AtlasRect.w >= 1.0) {
+        FragColor = texture(u_texture, TexCoords);  // whole texture: GL_REPEAT tiles it
+        return;
+    }
+    // Tile inside the region. Gradients come from the unwrapped coordinates
+    // so the mip level doesn't jump at each tile seam.
+    vec2 uv = AtlasRect.xy + fract(TexCoords) * AtlasRect.zw;
+    FragColor = textureGrad(u_texture, uv, dFdx(TexCoords) * AtlasRect.zw,
+                            dFdy(TexCoords) * AtlasRect.zw);
+}
@@ -0,0 +1,35 @@
+#version 330 core
+
+// Shared unit quad, corners at ±0.5
+layout(location = 0) in vec2 a_corner;
+
+// Per-instance data, streamed by SpriteRenderer (one entry per sprite)
+layout(location = 1) in vec3  i_position;
+layout(location = 2) in vec2  i_scale;
+layout(location = 3) in vec4  i_uvRect;      // xy = UV offset, zw = UV size (tiles when > 1)
+layout(location = 4) in float i_screenSpace; // 0 = world space, 1 = screen space (NDC)
+layout(location = 5) in vec4  i_atlasRect;   // texture's region of its atlas page; (0,0,1,1) if none
+
+out vec2 TexCoords;       // in the texture's own UVs, unwrapped
+flat out vec4 AtlasRect;
+
+// Per-frame camera, uploaded once by the Renderer (uniform buffer binding 0)
+layout(std140) uniform Camera {
+    mat4 u_viewMat;
+    mat4 u_projMat;
+};
+
+void main() {
+    // Same result as the old per-object T * S model matrix
+    vec3 worldPos = i_position + vec3(a_corner * i_scale, 0.0);
+
+    TexCoords = i_uvRect.xy + (a_corner + 0.5) * i_uvRect.zw;
+    AtlasRect = i_atlasRect;
+
+    if (i_screenSpace > 0.5) {
+        // Interpret position/scale in NDC so it stays fixed on screen
+        gl_Position = vec4(worldPos.xy, 0.0, 1.0);
+    } else {
+        gl_Position = u_projMat * u_viewMat * vec4(worldPos, 1.0);
+    }
+}
@@ -0,0 +1,100 @@
+// atlasBench.cc
+// Packs 48 synthetic level textures (32-256 texels a side) into atlas pages
+// and reports occupancy and build time, then what it buys the sprite path:
+// 2,000 platforms over those textures built into SpriteBatch draw ranges,
+// one Texture each vs. submitted under their atlas page the way Renderer
+// does. Also checks every packed texel and gutter against its source.
+#include "bench.h"
+#include "renderer/spriteBatch.h"
+#include "renderer/textureAtlas.h"
+#include "renderer/texture.h"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+namespace {
+constexpr int kTextures = 48;
+constexpr int kPlatforms = 2000;
+constexpr int kPageSize = 2048;
+constexpr int kPadding = 8;
+
+int wrap(int v, int n) {
+    return ((v % n) + n) % n;
+}
+}  // namespace
+
+INK_BENCH(atlas) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> side(32, 256);
+    std::vector<std::vector<unsigned char>> pixels(kTextures);
+    std::vector<AtlasSource> sources(kTextures);
+    for (int i = 0; i < kTextures; ++i) {
+        AtlasSource &src = sources[i];
+        src.name = "tex" + std::to_string(i);
+        src.width = side(rng);
+        src.height = side(rng);
+        pixels[i].resize(std::size_t(src.width) * src.height * 4);
+        for (std::size_t b = 0; b < pixels[i].size(); ++b)
+            pixels[i][b] = static_cast<unsigned char>(rng());
+        src.rgba = pixels[i].data();
+    }
+
+    TextureAtlas atlas;
+    const double buildMs = Bench::timeMs(1, [&] {
+        atlas = buildTextureAtlas(sources, kPageSize, kPadding);
+    });
+    std::size_t pageTexels = 0;
+    for (const AtlasPage &page: atlas.pages)
+        pageTexels += std::size_t(page.width) * page.height;
+
+    // Every region texel, gutter included, must be its (wrapped) source texel.
+    std::size_t mismatches = 0;
+    for (std::size_t r = 0; r < atlas.regions.size(); ++r) {
+        const AtlasRegion &region = atlas.regions[r];
+        const AtlasSource &src = sources[r];  // no rejects, so regions are in source order
+        const AtlasPage &page = atlas.pages[region.page];
+        const int x0 = static_cast<int>(region.uvRect[0] * page.width + 0.5f);
+        const int y0 = static_cast<int>(region.uvRect[1] * page.height + 0.5f);
+        for (int y = -kPadding; y < src.height + kPadding; ++y) {
+            for (int x = -kPadding; x < src.width + kPadding; ++x) {
+                const unsigned char *a =
+                        page.rgba.data() + (std::size_t(y0 + y) * page.width + x0 + x) * 4;
+                const unsigned char *b =
+                        src.rgba + (std::size_t(wrap(y, src.height)) * src.width +
+                                    wrap(x, src.width)) * 4;
+                mismatches += std::memcmp(a, b, 4) != 0;
+            }
+        }
+    }
+
+    // Draw ranges for the same sprites with and without the atlas.
+    std::vector<Texture> separate(kTextures), pages(atlas.pages.size()), regions(kTextures);
+    for (std::size_t r = 0; r < atlas.regions.size(); ++r) {
+        regions[r].m_atlasPage = &pages[atlas.regions[r].page];
+        std::copy(atlas.regions[r].uvRect, atlas.regions[r].uvRect + 4, regions[r].m_atlasRect);
+    }
+    std::uniform_real_distribution<float> pos(-50.0f, 50.0f);
+    std::uniform_int_distribution<int> pick(0, kTextures - 1);
+    SpriteBatch without, with;
+    for (int i = 0; i < kPlatforms; ++i) {
+        const int t = pick(rng);
+        const SpriteInstance instance{glm::vec3(pos(rng), pos(rng), 0.0f), glm::vec2(2.0f, 0.3f),
+                                      glm::vec4(0.0f, 0.0f, 2.0f, 0.3f), 0.0f};
+        without.submit(nullptr, &separate[t], instance);
+        SpriteInstance atlased = instance;
+        const float *r = regions[t].m_atlasRect;
+        atlased.atlasRect = glm::vec4(r[0], r[1], r[2], r[3]);
+        with.submit(nullptr, regions[t].m_atlasPage, atlased);
+    }
+    without.build();
+    with.build();
+
+    Bench::report("textures packed", double(atlas.regions.size()), "");
+    Bench::report("pages", double(atlas.pages.size()), "");
+    Bench::report("occupancy", 100.0 * double(atlas.usedTexels) / double(pageTexels), "%");
+    Bench::report("build", buildMs, "ms");
+    Bench::report("texel mismatches", double(mismatches), "");
+    Bench::report("draw ranges, separate textures", double(without.batches().size()), "");
+    Bench::report("draw ranges, atlas", double(with.batches().size()), "");
+}
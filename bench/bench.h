@@ -0,0 +1,205 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+// Tiny headless benchmark harness.
+// - INK_BENCH(name) registers a case; InkBench runs every case whose name
+//   contains the first command-line argument (or all of them).
+// - Cases print their own rows via Bench::report() so each one can choose
+//   what is worth measuring (ms per tick, pairs tested, ...).
+// - INK_BENCH_ARGS(name, args...) registers one case per argument in the
+//   style of Google Benchmark: the body gets a Bench::State, does its setup,
+//   then loops `for (auto _: state)` over the timed part. The harness picks
+//   the iteration count and reports time per iteration (and items/s when
+//   the case calls setItemsProcessed()).
+// - Bench::check() is for correctness conditions (SIMD against scalar, a
+//   network against reference outputs): a failed check prints a FAILED row
+//   and makes InkBench exit non-zero, so CI catches it.
+// - `InkBench [filter] [--min-time=ms] [--csv=file]`: --csv also writes
+//   every reported row as "case,label,value,unit" for CI to compare runs.
+namespace Bench {
+
+struct Case {
+    const char *name;
+    std::function<void()> fn;
+};
+
+std::vector<Case> &registry();
+
+inline bool add(const char *name, std::function<void()> fn) {
+    registry().push_back({name, std::move(fn)});
+    return true;
+}
+
+struct Options {
+    double minTimeMs = 200.0;  // per INK_BENCH_ARGS case and argument
+    std::FILE *csv = nullptr;
+    const char *currentCase = "";
+    int failedChecks = 0;
+};
+
+Options &options();
+
+/// Heap allocations (global operator new) made so far by this process;
+/// diff two reads to count a section's.
+std::size_t allocations();
+
+/// Bytes allocated through operator new and not yet freed (glibc only; 0
+/// elsewhere). Unlike RSS it drops as soon as memory is freed, so sections
+/// run one after another can be compared.
+std::size_t liveHeapBytes();
+
+/// Wall-clock milliseconds spent in `fn`, averaged over `iterations` calls.
+template <class Fn>
+double timeMs(int iterations, Fn &&fn) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        fn();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+}
+
+/// One result row: "<case> <label> <value> <unit>".
+inline void report(const std::string &label, double value, const char *unit) {
+    std::printf("  %-40s %14.4f %s\n", label.c_str(), value, unit);
+    if (options().csv) {
+        std::fprintf(options().csv, "%s,%s,%.6f,%s\n", options().currentCase, label.c_str(), value,
+                     unit);
+    }
+}
+
+/// A correctness condition; reports `label` as 1 if it holds, else 0 plus
+/// a FAILED line, and the run exits non-zero. Returns `ok`.
+inline bool check(const std::string &label, bool ok) {
+    report(label, ok ? 1.0 : 0.0, "");
+    if (!ok) {
+        std::printf("  FAILED: %s\n", label.c_str());
+        ++options().failedChecks;
+    }
+    return ok;
+}
+
+/// Timing loop state for INK_BENCH_ARGS cases. Iterations run until at least
+/// options().minTimeMs of timed work has accumulated (and at least once).
+class State {
+    using Clock = std::chrono::steady_clock;
+
+public:
+    explicit State(int64_t arg) : m_arg(arg) {}
+
+    int64_t arg() const {
+        return m_arg;
+    }
+
+    /// Exclude setup inside the loop from the measurement.
+    void pauseTiming() {
+        m_elapsed += Clock::now() - m_start;
+        m_paused = true;
+    }
+    void resumeTiming() {
+        m_paused = false;
+        m_start = Clock::now();
+    }
+
+    /// Work items handled over all iterations (e.g. entities ticked).
+    void setItemsProcessed(int64_t items) {
+        m_items = items;
+    }
+
+    int64_t iterations() const {
+        return m_iterations;
+    }
+    double elapsedMs() const {
+        return std::chrono::duration<double, std::milli>(m_elapsed).count();
+    }
+    double itemsPerSecond() const {
+        return m_items > 0 && m_elapsed.count() > 0 ? m_items / (elapsedMs() * 1e-3) : 0.0;
+    }
+
+    // The loop variable; its user-provided destructor keeps
+    // `for (auto _: state)` clear of unused-variable warnings.
+    struct Value {
+        ~Value() {}
+    };
+    struct Iterator {
+        State *state;
+        bool operator!=(const Iterator &) const {
+            return state->keepRunning();
+        }
+        void operator++() {}
+        Value operator*() const {
+            return {};
+        }
+    };
+    Iterator begin() {
+        m_start = Clock::now();
+        return {this};
+    }
+    Iterator end() {
+        return {this};
+    }
+
+private:
+    bool keepRunning() {
+        if (m_iterations > 0) {
+            const auto running = m_paused ? Clock::duration{} : Clock::now() - m_start;
+            if (m_elapsed + running >=
+                std::chrono::duration<double, std::milli>(options().minTimeMs)) {
+                m_elapsed += running;
+                m_paused = true;
+                return false;
+            }
+        }
+        ++m_iterations;
+        return true;
+    }
+
+    int64_t m_arg;
+    int64_t m_iterations = 0;
+    int64_t m_items = 0;
+    bool m_paused = false;
+    Clock::time_point m_start;
+    Clock::duration m_elapsed{};
+};
+
+inline bool addArgs(const char *name, std::initializer_list<int64_t> args, void (*fn)(State &)) {
+    std::vector<int64_t> list(args);
+    return add(name, [name, list, fn] {
+        for (int64_t arg: list) {
+            State state(arg);
+            fn(state);
+            const std::string label = std::string(name) + "/" + std::to_string(arg);
+            std::printf("  %-40s %14.4f ms/iter  %8lld iters", label.c_str(),
+                        state.elapsedMs() / double(state.iterations()),
+                        static_cast<long long>(state.iterations()));
+            if (state.itemsPerSecond() > 0.0)
+                std::printf("  %12.0f items/s", state.itemsPerSecond());
+            std::printf("\n");
+            if (options().csv) {
+                std::fprintf(options().csv, "%s,%s,%.6f,ms/iter\n", name, label.c_str(),
+                             state.elapsedMs() / double(state.iterations()));
+            }
+        }
+    });
+}
+
+}  // namespace Bench
+
+#define INK_BENCH_CAT2(a, b) a##b
+#define INK_BENCH_CAT(a, b) INK_BENCH_CAT2(a, b)
+#define INK_BENCH(name)                                                                            \
+    static void name();                                                                            \
+    static const bool INK_BENCH_CAT(name, _registered) = Bench::add(#name, name);                  \
+    static void name()
+#define INK_BENCH_ARGS(name, ...)                                                                  \
+    static void name(Bench::State &state);                                                         \
+    static const bool INK_BENCH_CAT(name, _registered) =                                           \
+            Bench::addArgs(#name, {__VA_ARGS__}, name);                                            \
+    static void name(Bench::State &state)
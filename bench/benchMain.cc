@@ -0,0 +1,95 @@
+// benchMain.cc
+#include "bench.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace {
+std::atomic<std::size_t> g_allocations{0};
+std::atomic<std::size_t> g_liveBytes{0};
+
+// Bytes malloc actually handed out for `p`; 0 where we cannot ask.
+std::size_t blockBytes(void *p) {
+#if defined(__GLIBC__)
+    return malloc_usable_size(p);
+#else
+    (void) p;
+    return 0;
+#endif
+}
+}  // namespace
+
+// Counts every heap allocation in InkBench, for Bench::allocations(), and
+// the bytes still allocated, for Bench::liveHeapBytes().
+void *operator new(std::size_t size) {
+    ++g_allocations;
+    if (void *p = std::malloc(size ? size : 1)) {
+        g_liveBytes.fetch_add(blockBytes(p), std::memory_order_relaxed);
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept {
+    if (p)
+        g_liveBytes.fetch_sub(blockBytes(p), std::memory_order_relaxed);
+    std::free(p);
+}
+void operator delete(void *p, std::size_t) noexcept {
+    operator delete(p);
+}
+
+std::size_t Bench::allocations() {
+    return g_allocations.load(std::memory_order_relaxed);
+}
+
+std::size_t Bench::liveHeapBytes() {
+    return g_liveBytes.load(std::memory_order_relaxed);
+}
+
+std::vector<Bench::Case> &Bench::registry() {
+    static std::vector<Case> cases;
+    return cases;
+}
+
+Bench::Options &Bench::options() {
+    static Options opts;
+    return opts;
+}
+
+int main(int argc, char **argv) {
+    const char *filter = "";
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--min-time=", 11) == 0) {
+            Bench::options().minTimeMs = std::atof(argv[i] + 11);
+        } else if (std::strncmp(argv[i], "--csv=", 6) == 0) {
+            Bench::options().csv = std::fopen(argv[i] + 6, "w");
+            if (!Bench::options().csv) {
+                std::fprintf(stderr, "[bench] cannot write %s\n", argv[i] + 6);
+                return 1;
+            }
+        } else {
+            filter = argv[i];
+        }
+    }
+
+    for (const auto &c: Bench::registry()) {
+        if (std::strstr(c.name, filter) == nullptr)
+            continue;
+        std::printf("[bench] %s\n", c.name);
+        Bench::options().currentCase = c.name;
+        c.fn();
+    }
+    if (Bench::options().csv)
+        std::fclose(Bench::options().csv);
+    if (Bench::options().failedChecks > 0) {
+        std::fprintf(stderr, "[bench] %d check(s) failed\n", Bench::options().failedChecks);
+        return 1;
+    }
+    return 0;
+}
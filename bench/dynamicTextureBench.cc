@@ -0,0 +1,110 @@
+// dynamicTextureBench.cc
+// A drawing canvas at 64, 256 and 1024 texels a side through
+// TextureManager::updateDynamicTexture: 600 frames, a brush dab on every
+// other one and nothing new in between (pen hovering). "before" uploads the
+// whole image every frame as CanvasOverlay used to; "after" passes the
+// version stamp and dirty rectangle. The backend copies each upload into a
+// shadow image, which must end up equal to the CPU canvas. Only the CPU
+// side is measured; GL and the pixel-buffer pair need a window.
+#include "bench.h"
+#include "renderer/renderBackend.h"
+#include "renderer/textureManager.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace {
+constexpr int kFrames = 600;
+
+// Null backend that also keeps what a GPU would hold.
+class ShadowBackend : public NullRenderBackend {
+public:
+    std::size_t updateTexture(Texture &texture, const unsigned char *rgba,
+                              const TextureRegion &region, bool regenerateMipmaps) override {
+        shadow.resize(static_cast<std::size_t>(texture.m_width) * texture.m_height * 4);
+        const std::size_t rowBytes = static_cast<std::size_t>(region.width) * 4;
+        for (int row = region.y; row < region.y + region.height; ++row) {
+            const std::size_t offset =
+                    (static_cast<std::size_t>(row) * texture.m_width + region.x) * 4;
+            std::memcpy(shadow.data() + offset, rgba + offset, rowBytes);
+        }
+        ++uploads;
+        const std::size_t b =
+                NullRenderBackend::updateTexture(texture, rgba, region, regenerateMipmaps);
+        bytes += b;
+        return b;
+    }
+
+    std::vector<unsigned char> shadow;
+    std::size_t uploads = 0, bytes = 0;
+};
+
+// Square brush dab of `radius` texels at (cx, cy), clipped to the canvas.
+TextureRegion dab(std::vector<unsigned char> &rgba, int size, int cx, int cy, int radius,
+                  unsigned char v) {
+    TextureRegion r;
+    r.x = std::max(cx - radius, 0);
+    r.y = std::max(cy - radius, 0);
+    r.width = std::min(cx + radius + 1, size) - r.x;
+    r.height = std::min(cy + radius + 1, size) - r.y;
+    for (int y = r.y; y < r.y + r.height; ++y)
+        std::memset(rgba.data() + (static_cast<std::size_t>(y) * size + r.x) * 4, v,
+                    static_cast<std::size_t>(r.width) * 4);
+    return r;
+}
+}  // namespace
+
+INK_BENCH(dynamicTexture) {
+    TextureManager &manager = *TextureManager::instance();
+    for (int size: {64, 256, 1024}) {
+        const std::string name = "bench_canvas_" + std::to_string(size);
+        const int radius = std::max(1, size / 64);
+        struct Run {
+            std::size_t uploads = 0, bytes = 0;
+            double ms = 0.0;
+            bool matches = false;
+        } before, after;
+
+        for (bool versioned: {false, true}) {
+            auto backend = std::make_shared<ShadowBackend>();
+            manager.setBackend(backend);
+            std::vector<unsigned char> rgba(static_cast<std::size_t>(size) * size * 4, 16);
+            manager.createDynamicTexture(name, size, size, rgba.data());
+            backend->shadow = rgba;
+
+            uint64_t version = 1;
+            const double ms = Bench::timeMs(1, [&] {
+                for (int frame = 0; frame < kFrames; ++frame) {
+                    TextureRegion dirty;
+                    if (frame % 2 == 0) {  // the stroke moves on a diagonal, wrapping
+                        const int step = frame / 2;
+                        dirty = dab(rgba, size, (step * 3) % size, (step * 7) % size, radius,
+                                    static_cast<unsigned char>(64 + step % 192));
+                        ++version;
+                    }
+                    if (versioned) {
+                        manager.updateDynamicTexture(name, rgba.data(), version, dirty);
+                    } else {
+                        manager.updateDynamicTexture(name, rgba.data());
+                    }
+                }
+            });
+            Run &run = versioned ? after : before;
+            run.uploads = backend->uploads;
+            run.bytes = backend->bytes;
+            run.ms = ms;
+            run.matches = backend->shadow == rgba;
+        }
+
+        const std::string label = std::to_string(size) + "x" + std::to_string(size);
+        Bench::report(label + " before: uploads", double(before.uploads), "");
+        Bench::report(label + " before: bytes per frame", double(before.bytes) / kFrames, "B");
+        Bench::report(label + " before: CPU per frame", before.ms * 1000.0 / kFrames, "us");
+        Bench::report(label + " after: uploads", double(after.uploads), "");
+        Bench::report(label + " after: bytes per frame", double(after.bytes) / kFrames, "B");
+        Bench::report(label + " after: CPU per frame", after.ms * 1000.0 / kFrames, "us");
+        Bench::report(label + " after: GPU copy matches", after.matches ? 1.0 : 0.0, "");
+    }
+    manager.setBackend(nullptr);
+}
@@ -0,0 +1,140 @@
+// entityStoreBench.cc
+// Tick cost of the ComponentStore passes vs the previous layout: one heap
+// object per entity behind a shared_ptr, with a virtual update() doing
+// gravity, integration and hitbox sync. Both sides use the same broadphase
+// so the difference is storage and iteration only.
+#include "bench.h"
+#include "core/entityManager.h"
+
+#include <algorithm>
+#include <random>
+
+namespace {
+constexpr float kDt = 1.0f / 60.0f;
+
+// Mirrors the old GameObject: scattered fields, virtual per-entity update.
+struct LegacyBody {
+    virtual ~LegacyBody() = default;
+    virtual void update(float dt) {
+        if (mass > 0.0f)
+            velocity.y -= 1.0f * dt * mass;
+        position += glm::vec3(velocity * speed * dt, 0.0f);
+        hitbox.updatePosition(position);
+    }
+
+    glm::vec3 position;
+    glm::vec2 velocity{0.0f};
+    glm::vec2 scale;
+    Hitbox hitbox;
+    float mass = 0.0f;
+    float speed = 1.0f;
+    bool dynamic = false;
+    std::string name;  // stands in for the rest of a real entity's state
+};
+
+struct Spawn {
+    glm::vec3 position;
+    glm::vec2 size;
+    bool dynamic;
+};
+
+// One in five entities moves; the rest are platforms along a long level.
+std::vector<Spawn> makeSpawns(std::size_t count) {
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> x(0.0f, count * 1.5f);
+    std::uniform_real_distribution<float> y(-3.0f, 3.0f);
+    std::uniform_real_distribution<float> w(0.2f, 3.0f);
+    std::vector<Spawn> spawns(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const bool dynamic = i % 5 == 0;
+        spawns[i] = {glm::vec3(x(rng), y(rng), 0.0f),
+                     dynamic ? glm::vec2(0.2f) : glm::vec2(w(rng), 0.3f), dynamic};
+    }
+    return spawns;
+}
+
+double legacyTick(const std::vector<Spawn> &spawns) {
+    std::vector<std::shared_ptr<LegacyBody>> bodies;
+    for (const auto &s: spawns) {
+        auto b = std::make_shared<LegacyBody>();
+        b->position = s.position;
+        b->scale = s.size;
+        b->hitbox = Hitbox(s.size, s.position);
+        b->dynamic = s.dynamic;
+        b->mass = s.dynamic ? 0.2f : 0.0f;
+        bodies.push_back(b);
+    }
+    // Heap order no longer matches iteration order after a level has been
+    // edited and entities spawned at runtime; approximate that here.
+    std::shuffle(bodies.begin(), bodies.end(), std::mt19937(5));
+
+    auto bp = Broadphase::create(BroadphaseType::sweepAndPrune);
+    for (uint32_t i = 0; i < bodies.size(); ++i) {
+        if (!bodies[i]->dynamic)
+            bp->addStatic(i, bodies[i]->hitbox.bounds());
+    }
+    bp->bake();
+
+    std::vector<BroadphaseProxy> movers;
+    std::vector<BroadphasePair> pairs;
+    return Bench::timeMs(60, [&] {
+        for (auto &b: bodies) {
+            if (b->dynamic)
+                b->update(kDt);
+        }
+        movers.clear();
+        for (uint32_t i = 0; i < bodies.size(); ++i) {
+            if (bodies[i]->dynamic)
+                movers.push_back({i, bodies[i]->hitbox.bounds()});
+        }
+        bp->setDynamic(movers);
+        bp->collectPairs(pairs);
+        for (const auto &[a, b]: pairs) {
+            LegacyBody &A = *bodies[a];
+            LegacyBody &B = *bodies[b];
+            if (!A.hitbox.intersects(B.hitbox))
+                continue;
+            auto resolve = [](LegacyBody &self, const LegacyBody &other) {
+                const glm::vec2 r = self.hitbox.getCollisionResolution(other.hitbox);
+                self.position += glm::vec3(r, 0.0f);
+                if (r.x != 0.0f)
+                    self.velocity.x = 0.0f;
+                if (r.y != 0.0f)
+                    self.velocity.y = 0.0f;
+            };
+            if (A.dynamic)
+                resolve(A, B);
+            if (B.dynamic)
+                resolve(B, A);
+        }
+    });
+}
+
+double storeTick(const std::vector<Spawn> &spawns) {
+    EntityManager em(BroadphaseType::sweepAndPrune);
+    em.components().reserve(spawns.size());
+    for (const auto &s: spawns) {
+        BodyDesc desc;
+        desc.position = s.position;
+        desc.scale = s.size;
+        desc.hitboxSize = s.size;
+        desc.mass = s.dynamic ? 0.2f : 0.0f;
+        desc.flags = BodyFlags::hitboxActive | BodyFlags::collides |
+                     (s.dynamic ? BodyFlags::movesOnCollision : BodyFlags::isStatic);
+        em.spawnBody(desc);
+    }
+    em.bakeStatic();
+    return Bench::timeMs(60, [&] {
+        em.update(kDt);
+    });
+}
+}  // namespace
+
+INK_BENCH(entityStore) {
+    for (std::size_t n: {10000u, 100000u}) {
+        const auto spawns = makeSpawns(n);
+        std::printf(" %zu entities (%zu dynamic)\n", n, n / 5);
+        Bench::report("shared_ptr + virtual update ms/tick", legacyTick(spawns), "ms");
+        Bench::report("component store passes ms/tick", storeTick(spawns), "ms");
+    }
+}
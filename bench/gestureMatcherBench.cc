@@ -0,0 +1,270 @@
+// gestureMatcherBench.cc
+// 660 synthetic single strokes (60 each of dots, horizontal, vertical and
+// diagonal lines, circles, squares, triangles, zigzags, spirals, curves and
+// random scribbles) at random spots and sizes, with hand wobble, a random
+// drawing direction and, for closed shapes, a random start point; each
+// goes through StrokeSimplifier like a recorded stroke. GestureMatcher
+// runs with the shipped assets/gestures templates. Reports how many
+// strokes per kind the fast path answers (scribbles should fall back), how
+// many answers are wrong, and the time per stroke of the fast path against
+// the raster paths it skips: rasterize + the stub classifier, and
+// rasterize + StrokePreprocess + a TinyCnn of the planned size (M5). Time
+// saved is averaged over all strokes, so strokes that fall back pay for
+// the attempt. Last, every 11th stroke goes through a RecognizerService
+// with the default 0.3 s follow-up wait: release to its first answer,
+// matched strokes (from submitFinal() itself) against the rest (the
+// worker's provisional result).
+#include "bench.h"
+#include "core/gestureMatcher.h"
+#include "core/recognizer.h"
+#include "core/recognizerService.h"
+#include "core/strokePreprocess.h"
+#include "core/strokeRaster.h"
+#include "core/strokeSimplifier.h"
+#include "core/tinyCnn.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <thread>
+
+namespace {
+constexpr int kPerKind = 60;
+constexpr float kPi = 3.14159265f;
+
+const char *const kKinds[] = {"dot",    "horizontal", "vertical", "diagonal", "circle", "square",
+                              "triangle", "zigzag",   "spiral",   "curve",    "scribble"};
+constexpr int kKindCount = int(sizeof(kKinds) / sizeof(kKinds[0]));
+
+struct Sample {
+    std::vector<glm::vec2> points;  // simplified
+    int kind = 0;
+};
+
+std::vector<glm::vec2> polygon(const std::vector<glm::vec2> &corners, int perSide) {
+    std::vector<glm::vec2> out;
+    for (std::size_t i = 0; i + 1 < corners.size(); ++i) {
+        for (int k = 0; k < perSide; ++k)
+            out.push_back(glm::mix(corners[i], corners[i + 1], float(k) / perSide));
+    }
+    out.push_back(corners.back());
+    return out;
+}
+
+// Shape `kind` in a unit box, y down.
+std::vector<glm::vec2> shape(int kind, std::mt19937 &rng) {
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<glm::vec2> p;
+    switch (kind) {
+    case 0:  // dot: a tap with a little wobble
+        for (int i = 0; i < 4; ++i)
+            p.emplace_back(0.5f + 0.02f * unit(rng), 0.5f + 0.02f * unit(rng));
+        return p;
+    case 1:
+        return polygon({{0.0f, 0.5f}, {1.0f, 0.5f}}, 24);
+    case 2:
+        return polygon({{0.5f, 0.0f}, {0.5f, 1.0f}}, 24);
+    case 3:
+        return polygon({{0.0f, 0.0f}, {1.0f, 1.0f}}, 24);
+    case 4:
+        for (int i = 0; i <= 48; ++i) {
+            const float a = 2.0f * kPi * i / 48;
+            p.emplace_back(0.5f + 0.5f * std::cos(a), 0.5f + 0.5f * std::sin(a));
+        }
+        return p;
+    case 5:
+        return polygon({{0, 0}, {1, 0}, {1, 1}, {0, 1}, {0, 0}}, 12);
+    case 6:
+        return polygon({{0.5f, 0.0f}, {1.0f, 0.87f}, {0.0f, 0.87f}, {0.5f, 0.0f}}, 14);
+    case 7:
+        return polygon({{0.0f, 1.0f}, {0.25f, 0.0f}, {0.5f, 1.0f}, {0.75f, 0.0f}, {1.0f, 1.0f}},
+                       10);
+    case 8:
+        for (int i = 0; i <= 96; ++i) {
+            const float a = 4.0f * kPi * i / 96, r = 0.5f * i / 96;
+            p.emplace_back(0.5f + r * std::cos(a), 0.5f + r * std::sin(a));
+        }
+        return p;
+    case 9: {  // half circle opening down, up, left or right
+        const float a0 = 0.5f * kPi * float(rng() % 4);
+        for (int i = 0; i <= 32; ++i) {
+            const float a = a0 + kPi * i / 32;
+            p.emplace_back(0.5f + 0.5f * std::cos(a), 0.5f + 0.5f * std::sin(a));
+        }
+        return p;
+    }
+    default: {  // scribble: a random walk with momentum
+        glm::vec2 at(0.5f), v(0.0f);
+        for (int i = 0; i < 60; ++i) {
+            v = 0.7f * v + 0.08f * glm::vec2(unit(rng) - 0.5f, unit(rng) - 0.5f);
+            at = glm::clamp(at + v, 0.0f, 1.0f);
+            p.push_back(at);
+        }
+        return p;
+    }
+    }
+}
+
+std::vector<Sample> makeSamples() {
+    std::mt19937 rng(25);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::normal_distribution<float> jitter(0.0f, 1.0f);
+    std::vector<Sample> samples;
+    for (int kind = 0; kind < kKindCount; ++kind) {
+        for (int n = 0; n < kPerKind; ++n) {
+            std::vector<glm::vec2> p = shape(kind, rng);
+            const bool closed = kind >= 4 && kind <= 6;
+            if (closed) {  // start anywhere along the outline
+                std::rotate(p.begin(), p.begin() + rng() % (p.size() - 1), p.end() - 1);
+                p.back() = p.front();
+            }
+            if (rng() % 2)
+                std::reverse(p.begin(), p.end());
+
+            const float size = kind == 0 ? 0.02f : 0.06f + 0.2f * unit(rng);
+            const glm::vec2 origin(0.1f + 0.6f * unit(rng), 0.1f + 0.6f * unit(rng));
+            const float tilt = 0.12f * (unit(rng) - 0.5f);  // about +-3.5 degrees
+            const glm::mat2 rotate(std::cos(tilt), std::sin(tilt), -std::sin(tilt), std::cos(tilt));
+            // Hand wobble: a slow drift of a few percent of the size, plus
+            // sensor noise of about a pixel at 1280 px.
+            const glm::vec2 phase(6.283f * unit(rng), 6.283f * unit(rng));
+            std::vector<glm::vec2> stroke;
+            for (std::size_t i = 0; i < p.size(); ++i) {
+                const float t = float(i) / float(p.size());
+                const glm::vec2 drift(std::sin(5.0f * t + phase.x), std::sin(7.0f * t + phase.y));
+                const glm::vec2 noise = 0.0008f * glm::vec2(jitter(rng), jitter(rng));
+                stroke.push_back(origin + size * (rotate * (p[i] - 0.5f) + 0.5f + 0.025f * drift) +
+                                 noise);
+            }
+            samples.push_back(Sample{StrokeSimplifier::simplify(stroke), kind});
+        }
+    }
+    return samples;
+}
+
+std::vector<float> randomWeights(std::mt19937 &rng, std::size_t count, int fanIn) {
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    const float limit = std::sqrt(6.0f / float(fanIn));
+    std::vector<float> w(count);
+    for (float &v: w)
+        v = unit(rng) * limit;
+    return w;
+}
+
+// docs/drawing_recognition_plan.md's classifier, as in tinyCnnBench.
+TinyCnn makeNet() {
+    constexpr int kOut = StrokePreprocess::kOutput;
+    std::mt19937 rng(2024);
+    TinyCnn net(TinyCnn::Shape{1, kOut, kOut});
+    net.addConv2d(8, 3, 1, randomWeights(rng, 8 * 9, 9), randomWeights(rng, 8, 9));
+    net.addRelu();
+    net.addMaxPool(2);
+    net.addConv2d(16, 3, 1, randomWeights(rng, 16 * 8 * 9, 72), randomWeights(rng, 16, 72));
+    net.addRelu();
+    net.addMaxPool(2);
+    net.addDense(64, randomWeights(rng, 64 * 16 * 7 * 7, 784), randomWeights(rng, 64, 784));
+    net.addRelu();
+    net.addDense(10, randomWeights(rng, 10 * 64, 64), randomWeights(rng, 10, 64));
+    net.addSoftmax();
+    return net;
+}
+
+double percentile(std::vector<double> v, double p) {
+    if (v.empty())
+        return 0.0;
+    std::sort(v.begin(), v.end());
+    return v[std::min(v.size() - 1, static_cast<std::size_t>(p * (v.size() - 1) + 0.5))];
+}
+}  // namespace
+
+INK_BENCH(gestureMatcher) {
+    const auto samples = makeSamples();
+    GestureMatcher matcher;
+    if (!matcher.load(std::string(SHADER_DIR) + "../gestures/templates.json")) {
+        std::printf("  could not load the gesture templates\n");
+        return;
+    }
+    std::printf("  %zu strokes, %zu templates\n", samples.size(), matcher.templateCount());
+
+    int resolved[kKindCount] = {}, wrong = 0, total = 0;
+    for (const Sample &s: samples) {
+        const auto p = matcher.match(GestureMatcher::makePath(s.points));
+        if (!p)
+            continue;
+        ++resolved[s.kind];
+        ++total;
+        wrong += p->label != kKinds[s.kind];
+    }
+    for (int kind = 0; kind < kKindCount; ++kind) {
+        Bench::report(std::string(kKinds[kind]) + " resolved by fast path",
+                      100.0 * resolved[kind] / kPerKind, "%");
+    }
+    const double fraction = double(total) / samples.size();
+    Bench::report("all strokes resolved by fast path", 100.0 * fraction, "%");
+    Bench::report("fast path answers with the wrong label", double(wrong), "");
+
+    volatile float sink = 0.0f;
+    const double n = double(samples.size());
+    const double fastUs = 1000.0 * Bench::timeMs(20, [&] {
+        int hits = 0;
+        for (const Sample &s: samples)
+            hits += matcher.match(GestureMatcher::makePath(s.points)).has_value();
+        sink = float(hits);
+    }) / n;
+    StrokeRaster raster;
+    const double stubUs = 1000.0 * Bench::timeMs(20, [&] {
+        float acc = 0.0f;
+        for (const Sample &s: samples) {
+            raster.clear();
+            raster.extend(s.points);
+            acc += Recognizer::classify(raster.pixels()).confidence;
+        }
+        sink = acc;
+    }) / n;
+    TinyCnn net = makeNet();
+    const double cnnUs = 1000.0 * Bench::timeMs(5, [&] {
+        float acc = 0.0f;
+        for (const Sample &s: samples) {
+            raster.clear();
+            raster.extend(s.points);
+            const auto m = StrokePreprocess::measure(raster.pixels());
+            StrokePreprocess::resample(raster.pixels(), m, net.input());
+            acc += net.forward()[0];
+        }
+        sink = acc;
+    }) / n;
+    Bench::report("fast path per stroke", fastUs, "us");
+    Bench::report("raster + stub classifier per stroke", stubUs, "us");
+    Bench::report("raster + preprocess + TinyCnn per stroke", cnnUs, "us");
+    Bench::report("saved per stroke vs stub path", fraction * stubUs - fastUs, "us");
+    Bench::report("saved per stroke vs CNN path", fraction * cnnUs - fastUs, "us");
+
+    RecognizerService::Settings settings;
+    settings.gestureTemplates = std::string(SHADER_DIR) + "../gestures/templates.json";
+    RecognizerService service(settings);
+    std::vector<double> matchedMs, fallbackMs;
+    uint64_t stroke = 0;
+    for (std::size_t i = 0; i < samples.size(); i += 11) {
+        raster.clear();
+        raster.extend(samples[i].points);
+        service.submitFinal(raster, samples[i].points);
+        ++stroke;
+        for (bool answered = false; !answered;) {
+            while (auto result = service.poll()) {
+                if (result->stroke != stroke || !result->provisional)
+                    continue;  // finals of earlier symbols
+                const double ms = std::chrono::duration<double, std::milli>(
+                        RecognizerService::Clock::now() - result->submitted).count();
+                (result->matched ? matchedMs : fallbackMs).push_back(ms);
+                answered = true;
+            }
+            std::this_thread::yield();
+        }
+    }
+    Bench::report("service: release -> first answer p50, fast path",
+                  percentile(matchedMs, 0.5), "ms");
+    Bench::report("service: release -> first answer p50, raster path",
+                  percentile(fallbackMs, 0.5), "ms");
+}
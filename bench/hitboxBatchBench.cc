@@ -0,0 +1,117 @@
+// hitboxBatchBench.cc
+// One character-sized box against a few hundred nearby platforms, the
+// per-mover narrow range the broadphase hands out. Compares the Hitbox
+// path (intersects + getCollisionResolution per platform) with overlapBatch
+// at each SIMD level, after checking every level reproduces the Hitbox
+// results bit for bit.
+#include "bench.h"
+#include "entities/hitboxBatch.h"
+
+#include <cstring>
+#include <random>
+
+namespace {
+constexpr std::size_t kPlatforms = 512;
+constexpr int kQueries = 2000;
+
+// Platforms packed around the origin, snapped to a 0.25 grid so touching
+// edges and equal-penetration ties (the tie-break order) both show up.
+std::vector<Hitbox> makePlatforms() {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> pos(-16, 16);
+    std::uniform_int_distribution<int> size(1, 8);
+    std::vector<Hitbox> platforms;
+    for (std::size_t i = 0; i < kPlatforms; ++i) {
+        platforms.emplace_back(glm::vec2(size(rng) * 0.25f, size(rng) * 0.25f),
+                               glm::vec3(pos(rng) * 0.25f, pos(rng) * 0.25f, 0.0f));
+    }
+    return platforms;
+}
+
+std::vector<Hitbox> makeQueries() {
+    std::mt19937 rng(8);
+    std::uniform_int_distribution<int> pos(-20, 20);
+    std::uniform_real_distribution<float> jitter(-0.1f, 0.1f);
+    std::vector<Hitbox> queries;
+    for (int i = 0; i < kQueries; ++i) {
+        // Half on the grid (ties, touching), half off it.
+        const float j = i % 2 ? jitter(rng) : 0.0f;
+        queries.emplace_back(glm::vec2(0.5f),
+                             glm::vec3(pos(rng) * 0.25f + j, pos(rng) * 0.25f - j, 0.0f));
+    }
+    return queries;
+}
+
+// Returns the number of mismatching entries (mask bit or resolution bits).
+std::size_t verify(const std::vector<Hitbox> &platforms, const std::vector<Hitbox> &queries,
+                   const AabbBatch &batch, SimdLevel level) {
+    std::vector<uint64_t> mask(overlapMaskWords(kPlatforms));
+    std::vector<glm::vec2> resolution(kPlatforms);
+    std::size_t mismatches = 0;
+    for (const auto &q: queries) {
+        // Odd offsets/counts exercise unaligned loads and the scalar tail.
+        for (std::size_t first: {std::size_t(0), std::size_t(3)}) {
+            const std::size_t count = kPlatforms - first - 2;
+            overlapBatch(q.bounds(), batch, first, count, mask.data(), resolution.data(), level);
+            for (std::size_t i = 0; i < count; ++i) {
+                const Hitbox &p = platforms[first + i];
+                const bool hit = q.intersects(p);
+                const glm::vec2 expected = hit ? q.getCollisionResolution(p) : glm::vec2(0.0f);
+                const bool bit = (mask[i / 64] >> (i % 64)) & 1;
+                if (bit != hit || std::memcmp(&expected, &resolution[i], sizeof(glm::vec2)) != 0)
+                    ++mismatches;
+            }
+        }
+    }
+    return mismatches;
+}
+}  // namespace
+
+INK_BENCH(hitboxBatch) {
+    const auto platforms = makePlatforms();
+    const auto queries = makeQueries();
+    AabbBatch batch;
+    for (const auto &p: platforms)
+        batch.push_back(p.bounds());
+
+    std::printf(" %zu platforms x %d queries, best level: %s\n", kPlatforms, kQueries,
+                simdLevelName(bestSimdLevel()));
+
+    volatile float sink = 0.0f;
+    Bench::report("Hitbox intersects + resolution us/query", 1000.0 * Bench::timeMs(1, [&] {
+        float acc = 0.0f;
+        for (const auto &q: queries) {
+            for (const auto &p: platforms) {
+                if (q.intersects(p))
+                    acc += q.getCollisionResolution(p).x;
+            }
+        }
+        sink = acc;
+    }) / kQueries, "us");
+
+    std::vector<uint64_t> mask(overlapMaskWords(kPlatforms));
+    std::vector<glm::vec2> resolution(kPlatforms);
+    for (SimdLevel level: {SimdLevel::scalar, SimdLevel::sse2, SimdLevel::avx2}) {
+        if (!simdLevelSupported(level))
+            continue;
+        const std::string name = simdLevelName(level);
+        const std::size_t mismatches = verify(platforms, queries, batch, level);
+        Bench::report(name + " mismatches vs Hitbox", double(mismatches), "");
+        Bench::check(name + " bit-identical to Hitbox", mismatches == 0);
+        Bench::report(name + " mask + resolution us/query", 1000.0 * Bench::timeMs(1, [&] {
+            float acc = 0.0f;
+            for (const auto &q: queries) {
+                overlapBatch(q.bounds(), batch, 0, kPlatforms, mask.data(), resolution.data(),
+                             level);
+                acc += resolution[0].x;
+            }
+            sink = acc;
+        }) / kQueries, "us");
+        Bench::report(name + " mask only us/query", 1000.0 * Bench::timeMs(1, [&] {
+            std::size_t hits = 0;
+            for (const auto &q: queries)
+                hits += overlapBatch(q.bounds(), batch, 0, kPlatforms, mask.data(), nullptr, level);
+            sink = float(hits);
+        }) / kQueries, "us");
+    }
+}
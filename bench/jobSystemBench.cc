@@ -0,0 +1,100 @@
+// jobSystemBench.cc
+// Stress run of the fixed-step tick on 50k bodies with 1..N workers. Each
+// run starts from the same spawn list; after the timed ticks the store is
+// compared with the single-worker run, which must match bit for bit.
+#include "bench.h"
+#include "core/entityManager.h"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <thread>
+
+namespace {
+constexpr float kDt = 1.0f / 60.0f;
+constexpr std::size_t kEntities = 50000;
+constexpr int kTicks = 120;
+
+struct Snapshot {
+    std::vector<glm::vec3> position;
+    std::vector<glm::vec2> velocity;
+    std::size_t contacts = 0;
+};
+
+// Half the bodies move: falling crates dropped over a long strip of platforms.
+void populate(EntityManager &em) {
+    std::mt19937 rng(2024);
+    std::uniform_real_distribution<float> x(0.0f, kEntities * 0.5f);
+    std::uniform_real_distribution<float> y(-3.0f, 3.0f);
+    std::uniform_real_distribution<float> w(0.3f, 3.0f);
+    std::uniform_real_distribution<float> vx(-1.0f, 1.0f);
+    em.components().reserve(kEntities);
+    for (std::size_t i = 0; i < kEntities; ++i) {
+        const bool dynamic = i % 2 == 0;
+        BodyDesc desc;
+        desc.position = glm::vec3(x(rng), y(rng), 0.0f);
+        desc.scale = desc.hitboxSize = dynamic ? glm::vec2(0.2f) : glm::vec2(w(rng), 0.3f);
+        desc.velocity = dynamic ? glm::vec2(vx(rng), 0.0f) : glm::vec2(0.0f);
+        desc.mass = dynamic ? 0.2f : 0.0f;
+        desc.flags = BodyFlags::hitboxActive | BodyFlags::collides |
+                     (dynamic ? BodyFlags::movesOnCollision : BodyFlags::isStatic);
+        em.spawnBody(desc);
+    }
+    em.bakeStatic();
+}
+
+double run(BroadphaseType type, unsigned workers, Snapshot &out) {
+    EntityManager em(type);
+    populate(em);
+    JobSystem jobs(workers);
+    em.setJobSystem(&jobs);
+
+    out.contacts = 0;
+    const double ms = Bench::timeMs(kTicks, [&] {
+        em.update(kDt);
+        out.contacts += em.getCollisionStats().contacts;
+    });
+    out.position = em.components().position;
+    out.velocity = em.components().velocity;
+    return ms;
+}
+
+template <class T>
+bool sameBits(const std::vector<T> &a, const std::vector<T> &b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+}
+}  // namespace
+
+INK_BENCH(jobSystem) {
+    // At least 4 workers so the determinism check covers stealing even on
+    // small machines (the speedup column is meaningless when oversubscribed).
+    const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    const unsigned maxWorkers = std::max(4u, hw);
+    std::vector<unsigned> counts;
+    for (unsigned n = 1; n < maxWorkers; n *= 2)
+        counts.push_back(n);
+    counts.push_back(maxWorkers);
+    std::printf(" %u hardware threads\n", hw);
+
+    for (BroadphaseType type: {BroadphaseType::sweepAndPrune, BroadphaseType::spatialHash}) {
+        std::printf(" %zu entities, %d ticks, %s\n", kEntities, kTicks,
+                    type == BroadphaseType::sweepAndPrune ? "sweepAndPrune" : "spatialHash");
+        Snapshot reference;
+        const double base = run(type, 1, reference);
+        Bench::report("1 worker ms/tick", base, "ms");
+
+        for (unsigned n: counts) {
+            if (n == 1)
+                continue;
+            Snapshot snap;
+            const double ms = run(type, n, snap);
+            const bool same = snap.contacts == reference.contacts &&
+                              sameBits(snap.position, reference.position) &&
+                              sameBits(snap.velocity, reference.velocity);
+            const std::string label = std::to_string(n) + " workers";
+            Bench::report(label + " ms/tick", ms, "ms");
+            Bench::report(label + " speedup", base / ms, "x");
+            Bench::report(label + " matches 1 worker", same ? 1.0 : 0.0, "");
+        }
+    }
+}
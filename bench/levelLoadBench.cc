@@ -0,0 +1,97 @@
+// levelLoadBench.cc
+// Load time of a 100k-object level from the JSON authoring format versus
+// the cooked .inkl (mmap + bulk static sprites), plus the one-off cook.
+// Both loads go into a fresh EntityManager with the null render backend.
+#include "bench.h"
+#include "core/entityManager.h"
+#include "core/levelCooker.h"
+#include "core/levelLoader.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace {
+constexpr std::size_t kObjects = 100000;
+constexpr int kRuns = 3;
+constexpr const char *kTextures[] = {"bench_level_a", "bench_level_b", "bench_level_c"};
+
+struct QuietCout {
+    std::streambuf *saved = std::cout.rdbuf(nullptr);
+    ~QuietCout() {
+        std::cout.rdbuf(saved);
+    }
+};
+
+// One player, then platforms over three textures; every 100th one moves.
+void writeLevel(const std::filesystem::path &path) {
+    std::ofstream out(path);
+    out << R"({"levelName":"bench","objects":[)";
+    out << R"({"type":"character","texture":")" << kTextures[0]
+        << R"(","position":[0,2,0],"scale":[0.2,0.2]})";
+    for (std::size_t i = 1; i < kObjects; ++i) {
+        out << R"(,{"type":"platform","subtype":")" << (i % 100 == 0 ? "moving" : "stationary")
+            << R"(","texture":")" << kTextures[i % 3] << R"(","position":[)" << (i % 1000) * 2.0f
+            << "," << (i / 1000) * 1.5f << R"(,0],"scale":[1.5,0.3]})";
+    }
+    out << "]}\n";
+}
+
+struct LoadResult {
+    double ms = 0.0;
+    std::size_t bodies = 0;
+    std::size_t drawables = 0;
+};
+
+template <class Load>
+LoadResult timeLoad(Load &&load) {
+    LoadResult result;
+    for (int run = 0; run < kRuns; ++run) {
+        EntityManager em(BroadphaseType::sweepAndPrune);
+        result.ms += Bench::timeMs(1, [&] { load(em); }) / kRuns;
+        RenderSnapshot snapshot;
+        em.buildRenderSnapshot(snapshot);
+        result.bodies = em.components().size();
+        result.drawables = snapshot.items.size();
+    }
+    return result;
+}
+}  // namespace
+
+INK_BENCH(levelLoad) {
+    auto tm = TextureManager::instance();
+    for (const char *name: kTextures) {
+        if (!tm->hasTexture(name))
+            tm->createDynamicTexture(name, 16, 16);
+    }
+    const auto dir = std::filesystem::temp_directory_path();
+    const auto json = dir / "ink_bench_level_100k.json";
+    const auto cooked = dir / "ink_bench_level_100k.inkl";
+
+    LoadResult fromJson, fromCooked;
+    double cookMs = 0.0;
+    {
+        QuietCout quiet;
+        writeLevel(json);
+        cookMs = Bench::timeMs(1, [&] { cookLevel(json.string(), cooked.string()); });
+        fromJson = timeLoad(
+                [&](EntityManager &em) { loadLevelFromFile(json.string(), tm, &em); });
+        fromCooked = timeLoad(
+                [&](EntityManager &em) { loadCookedLevel(cooked.string(), tm, &em); });
+    }
+
+    Bench::report("json load (100k objects)", fromJson.ms, "ms");
+    Bench::report("cooked load (100k objects)", fromCooked.ms, "ms");
+    Bench::report("speedup", fromJson.ms / fromCooked.ms, "x");
+    Bench::report("cook (one-off)", cookMs, "ms");
+    Bench::report("json bytes", double(std::filesystem::file_size(json)), "B");
+    Bench::report("cooked bytes", double(std::filesystem::file_size(cooked)), "B");
+    // Both paths must produce the same world.
+    Bench::report("bodies (json)", double(fromJson.bodies), "");
+    Bench::report("bodies (cooked)", double(fromCooked.bodies), "");
+    Bench::report("drawables (json)", double(fromJson.drawables), "");
+    Bench::report("drawables (cooked)", double(fromCooked.drawables), "");
+
+    std::filesystem::remove(json);
+    std::filesystem::remove(cooked);
+}
@@ -0,0 +1,195 @@
+// levelStreamBench.cc
+// Synthetic endless level: a focus point runs right at 20 units/s while a
+// LevelStreamer loads chunks ahead of it and evicts them behind. Reports
+// per-tick time (streamer update + tick + snapshot), the worst hitches, the
+// most bodies ever resident and the peak live heap, then the same distance
+// loaded up front for comparison. Memory is live heap bytes from the
+// bench's operator new hook, not RSS: the up-front run starts after the
+// streamed one has freed its memory, and RSS would count those reused
+// pages as no growth.
+#include "bench.h"
+#include "core/entityManager.h"
+#include "core/levelStreamer.h"
+#include "renderer/textureManager.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+
+namespace {
+constexpr float kDt = 1.0f / 60.0f;
+constexpr float kSpeed = 20.0f;  // world units per second
+constexpr int kTicks = 6000;
+constexpr float kChunkSize = 16.0f;
+constexpr int kPlatformsPerChunk = 256;
+constexpr int kMovers = 64;
+const glm::vec2 kViewHalfExtents(4.0f, 3.0f);
+constexpr const char *kTextures[] = {"bench_stream_a", "bench_stream_b"};
+
+// Deterministic platforms per chunk, in every direction forever.
+class EndlessChunkSource : public ChunkSource {
+public:
+    float chunkSize() const override {
+        return kChunkSize;
+    }
+    void load(ChunkCoord coord, std::vector<ChunkPlatform> &out) override {
+        std::mt19937 rng(static_cast<uint32_t>(coord.x) * 73856093u ^
+                         static_cast<uint32_t>(coord.y) * 19349663u);
+        std::uniform_real_distribution<float> u(0.0f, kChunkSize);
+        std::uniform_real_distribution<float> w(0.3f, 2.0f);
+        for (int i = 0; i < kPlatformsPerChunk; ++i) {
+            out.push_back({glm::vec3(coord.x * kChunkSize + u(rng), coord.y * kChunkSize + u(rng),
+                                     0.0f),
+                           glm::vec2(w(rng), 0.3f), static_cast<uint32_t>(i % 2)});
+        }
+    }
+    uint32_t textureCount() const override {
+        return 2;
+    }
+    const char *textureName(uint32_t index) const override {
+        return kTextures[index];
+    }
+};
+
+// Live heap above `base`, in MB.
+double heapMb(std::size_t base) {
+    const std::size_t live = Bench::liveHeapBytes();
+    return live > base ? double(live - base) / (1024.0 * 1024.0) : 0.0;
+}
+
+// Small dynamic bodies kept around the focus so collision sees the statics.
+std::vector<EntityHandle> spawnMovers(EntityManager &em) {
+    std::vector<EntityHandle> movers;
+    BodyDesc desc;
+    desc.scale = desc.hitboxSize = glm::vec2(0.2f);
+    desc.mass = 0.2f;
+    desc.flags = BodyFlags::hitboxActive | BodyFlags::collides | BodyFlags::movesOnCollision;
+    for (int i = 0; i < kMovers; ++i)
+        movers.push_back(em.spawnBody(desc));
+    return movers;
+}
+
+void followFocus(EntityManager &em, const std::vector<EntityHandle> &movers, glm::vec2 focus) {
+    ComponentStore &store = em.components();
+    for (std::size_t i = 0; i < movers.size(); ++i) {
+        const uint32_t d = store.denseIndex(movers[i]);
+        store.position[d] = glm::vec3(focus.x + float(i % 8) - 4.0f, focus.y + float(i / 8) - 4.0f,
+                                      0.0f);
+    }
+}
+
+struct TickStats {
+    double p50 = 0.0, p99 = 0.0, max = 0.0;
+    int hitches = 0;  // ticks over 4x the median
+};
+
+TickStats summarize(std::vector<double> ms) {
+    std::sort(ms.begin(), ms.end());
+    TickStats s;
+    s.p50 = ms[ms.size() / 2];
+    s.p99 = ms[ms.size() * 99 / 100];
+    s.max = ms.back();
+    s.hitches = static_cast<int>(ms.end() - std::upper_bound(ms.begin(), ms.end(), 4.0 * s.p50));
+    return s;
+}
+}  // namespace
+
+INK_BENCH(levelStream) {
+    auto tm = TextureManager::instance();
+    for (const char *name: kTextures) {
+        if (!tm->hasTexture(name))
+            tm->createDynamicTexture(name, 16, 16);
+    }
+
+    // Streamed: only the neighbourhood of the focus is ever resident. Both
+    // broadphases, since evictions remove statics from each differently.
+    for (auto [type, name]: {std::pair{BroadphaseType::sweepAndPrune, "sweepAndPrune"},
+                             std::pair{BroadphaseType::spatialHash, "spatialHash"}}) {
+        std::vector<double> tickMs;
+        tickMs.reserve(kTicks);
+        std::size_t maxBodies = 0;
+        const std::size_t base = Bench::liveHeapBytes();
+        double peak = 0.0;
+        LevelStreamer::Stats streamed;
+        {
+            EntityManager em(type);
+            const auto movers = spawnMovers(em);
+            em.bakeStatic();
+            LevelStreamer streamer(std::make_unique<EndlessChunkSource>(), em);
+            RenderSnapshot snapshot;
+            glm::vec2 focus(0.0f);
+            streamer.loadNow(focus, kViewHalfExtents, *tm);
+
+            for (int t = 0; t < kTicks; ++t) {
+                focus.x += kSpeed * kDt;
+                tickMs.push_back(Bench::timeMs(1, [&] {
+                    streamer.update(focus, kViewHalfExtents);
+                    followFocus(em, movers, focus);
+                    em.update(kDt);
+                    em.buildRenderSnapshot(snapshot);
+                }));
+                streamer.uploadTextures(*tm, 2);  // the render thread's share
+                maxBodies = std::max(maxBodies, em.components().size());
+                peak = std::max(peak, heapMb(base));
+            }
+            streamed = streamer.stats();
+        }
+        const TickStats s = summarize(tickMs);
+        const std::string prefix = std::string("streamed (") + name + "): ";
+        Bench::report(prefix + "distance", kSpeed * kDt * kTicks, "units");
+        Bench::report(prefix + "chunks loaded", double(streamed.chunksLoaded), "");
+        Bench::report(prefix + "chunks evicted", double(streamed.chunksEvicted), "");
+        Bench::report(prefix + "max bodies resident", double(maxBodies), "");
+        Bench::report(prefix + "live heap (peak)", peak, "MB");
+        Bench::report(prefix + "tick p50", s.p50, "ms");
+        Bench::report(prefix + "tick p99", s.p99, "ms");
+        Bench::report(prefix + "tick max", s.max, "ms");
+        Bench::report(prefix + "hitches (> 4x p50)", double(s.hitches), "ticks");
+    }
+
+    // Up front: every chunk the run passed through, resident all the time.
+    const int chunksX = static_cast<int>(kSpeed * kDt * kTicks / kChunkSize) + 2;
+    std::vector<double> upfrontMs;
+    std::size_t upfrontBodies = 0;
+    double upfrontPeak = 0.0;
+    {
+        upfrontMs.reserve(600);
+        const std::size_t upfrontBase = Bench::liveHeapBytes();
+        EntityManager em(BroadphaseType::sweepAndPrune);
+        const auto movers = spawnMovers(em);
+        EndlessChunkSource source;
+        std::vector<ChunkPlatform> platforms;
+        for (int y = -1; y <= 0; ++y) {
+            for (int x = -1; x < chunksX; ++x)
+                source.load({x, y}, platforms);
+        }
+        auto mesh = std::make_shared<Mesh>();
+        mesh->m_texture = tm->getTexture(kTextures[0]);
+        Mesh *shared = em.retainMesh(mesh);
+        std::vector<EntityManager::StaticSprite> sprites;
+        for (const ChunkPlatform &p: platforms)
+            sprites.push_back({p.position, p.scale, glm::vec4(0.0f, 0.0f, p.scale), shared});
+        em.spawnStaticSprites(sprites.data(), sprites.size());
+        em.bakeStatic();
+        upfrontBodies = em.components().size();
+
+        RenderSnapshot snapshot;
+        glm::vec2 focus(0.0f);
+        for (int t = 0; t < 600; ++t) {
+            focus.x += kSpeed * kDt;
+            upfrontMs.push_back(Bench::timeMs(1, [&] {
+                followFocus(em, movers, focus);
+                em.update(kDt);
+                em.buildRenderSnapshot(snapshot);
+            }));
+            upfrontPeak = std::max(upfrontPeak, heapMb(upfrontBase));
+        }
+    }
+    const TickStats u = summarize(upfrontMs);
+
+    Bench::report("up front: bodies (rows y -1..0 only)", double(upfrontBodies), "");
+    Bench::report("up front: live heap (peak)", upfrontPeak, "MB");
+    Bench::report("up front: tick p50", u.p50, "ms");
+    Bench::report("up front: tick p99", u.p99, "ms");
+}
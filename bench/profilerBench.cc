@@ -0,0 +1,65 @@
+// profilerBench.cc
+// Cost of one INK_PROFILE_SCOPE (record + drain) from several threads at
+// once, and the size of the resulting trace. Build with -DINK_PROFILE=ON;
+// otherwise the zones compile out and this case only says so.
+#include "bench.h"
+#include "core/profiler.h"
+
+#include <filesystem>
+#include <iostream>
+#include <thread>
+
+#if INK_PROFILE
+namespace {
+constexpr int kThreads = 4;
+constexpr int kZonesPerFrame = 1000;  // per thread; well under the ring size
+constexpr int kFrames = 10;        // undrained frames must fit one ring
+
+void work(int frame) {
+    for (int i = 0; i < kZonesPerFrame / 2; ++i) {
+        INK_PROFILE_SCOPE("bench outer");
+        INK_PROFILE_SCOPE("bench inner");
+        (void) frame;
+    }
+}
+}  // namespace
+
+INK_BENCH(profiler) {
+    Profiler &profiler = Profiler::instance();
+
+    // Single thread: record, then drain as the render loop would.
+    const double recordMs = Bench::timeMs(kFrames, [] { work(0); });
+    profiler.endFrame();
+    const double drainMs = Bench::timeMs(kFrames, [&] {
+        work(0);
+        profiler.endFrame();
+    }) - recordMs;
+
+    // Several threads recording, drained every frame.
+    const double frameMs = Bench::timeMs(kFrames, [&] {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t)
+            threads.emplace_back([t] {
+                INK_PROFILE_THREAD("bench worker");
+                work(t);
+            });
+        for (auto &t: threads)
+            t.join();
+        profiler.endFrame();
+    });
+
+    const auto path = std::filesystem::temp_directory_path() / "ink_profiler_bench.json";
+    profiler.writeChromeTrace(path.string());
+    profiler.printSummary(std::cout);
+
+    Bench::report("record ns/zone (1 thread)", recordMs * 1e6 / kZonesPerFrame, "ns");
+    Bench::report("drain ns/zone", drainMs * 1e6 / kZonesPerFrame, "ns");
+    Bench::report("frame ms (4 threads + drain)", frameMs, "ms");
+    Bench::report("dropped events", double(profiler.droppedEvents()), "");
+    Bench::report("trace bytes", double(std::filesystem::file_size(path)), "B");
+}
+#else
+INK_BENCH(profiler) {
+    std::printf(" INK_PROFILE is off: zones compile to nothing\n");
+}
+#endif
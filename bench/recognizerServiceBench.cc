@@ -0,0 +1,103 @@
+// recognizerServiceBench.cc
+// 30 strokes drawn at 60 Hz frames (0.15 s each, 0.05 s apart). Every
+// frame the "render thread" grows the stroke's raster, submitLive()s it and
+// drains poll(); at release it submitFinal()s. Reports release-to-prediction
+// latency (when the worker had it, and when a per-frame poll() saw it),
+// live predictions per stroke (15 Hz: the first at once, then one every
+// 67 ms), and the render thread's time in submit/poll calls next to
+// classifying synchronously at release as it used to
+// (Recognizer::submitRaster). On a single core the worker preempts the
+// render thread, so its classify time can show up in the latter's p99.
+// Stroke grouping is off (no follow-up wait), so every stroke is a symbol
+// classified at release; strokeGrouperBench covers grouping.
+#include "bench.h"
+#include "core/recognizer.h"
+#include "core/recognizerService.h"
+#include "core/strokeRaster.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace {
+constexpr int kStrokes = 30;
+constexpr int kDrawFrames = 9;  // 0.15 s
+constexpr int kGapFrames = 3;   // 0.05 s
+constexpr int kPointsPerFrame = 16;
+constexpr auto kFrame = std::chrono::microseconds(16667);
+
+using Clock = RecognizerService::Clock;
+
+double msBetween(Clock::time_point a, Clock::time_point b) {
+    return std::chrono::duration<double, std::milli>(b - a).count();
+}
+
+double percentile(std::vector<double> v, double p) {
+    std::sort(v.begin(), v.end());
+    return v[std::min(v.size() - 1, static_cast<std::size_t>(p * (v.size() - 1) + 0.5))];
+}
+
+glm::vec2 strokePoint(int stroke, int i) {
+    const float t = float(i) / (kDrawFrames * kPointsPerFrame);
+    const float a = 0.7f * stroke;
+    return glm::vec2(0.5f + 0.35f * t * std::cos(a) + 0.05f * std::sin(12.0f * t),
+                     0.5f + 0.35f * t * std::sin(a) + 0.05f * std::cos(9.0f * t));
+}
+}  // namespace
+
+INK_BENCH(recognizerService) {
+    RecognizerService::Settings settings;
+    settings.grouping.followUpSeconds = 0.0;
+    settings.gestureTemplates.clear();  // rasters only, no fast path
+    RecognizerService service(settings);
+    std::vector<double> workerLatency, seenLatency, renderUs;
+    std::size_t live = 0;
+    double syncUs = 0.0;
+
+    StrokeRaster raster;
+    std::vector<glm::vec2> points;
+    auto frameTime = Clock::now();
+    auto frame = [&](auto &&work) {
+        const auto start = Clock::now();
+        work();
+        while (auto result = service.poll()) {
+            if (result->final) {
+                workerLatency.push_back(msBetween(result->submitted, result->classified));
+                seenLatency.push_back(msBetween(result->submitted, Clock::now()));
+            } else if (!result->provisional) {
+                ++live;
+            }
+        }
+        renderUs.push_back(1000.0 * msBetween(start, Clock::now()));
+        frameTime += kFrame;
+        std::this_thread::sleep_until(frameTime);
+    };
+
+    for (int s = 0; s < kStrokes; ++s) {
+        raster.clear();
+        points.clear();
+        for (int f = 0; f < kDrawFrames; ++f) {
+            for (int i = 0; i < kPointsPerFrame; ++i)
+                points.push_back(strokePoint(s, f * kPointsPerFrame + i));
+            raster.extend(points);
+            frame([&] { service.submitLive(raster); });
+        }
+        frame([&] { service.submitFinal(raster); });
+        syncUs += 1000.0 * Bench::timeMs(1, [&] { Recognizer::instance()->submitRaster(raster); });
+        for (int f = 1; f < kGapFrames; ++f)
+            frame([] {});
+    }
+    for (int f = 0; f < 6 && workerLatency.size() < kStrokes; ++f)
+        frame([] {});  // let the last prediction arrive
+
+    Bench::report("final predictions", double(workerLatency.size()), "");
+    Bench::report("release -> prediction ready p50", percentile(workerLatency, 0.5), "ms");
+    Bench::report("release -> prediction ready p99", percentile(workerLatency, 0.99), "ms");
+    Bench::report("release -> seen by poll() p50", percentile(seenLatency, 0.5), "ms");
+    Bench::report("release -> seen by poll() p99", percentile(seenLatency, 0.99), "ms");
+    Bench::report("live predictions per stroke", double(live) / kStrokes, "");
+    Bench::report("render thread in service calls p50", percentile(renderUs, 0.5), "us");
+    Bench::report("render thread in service calls p99", percentile(renderUs, 0.99), "us");
+    Bench::report("sync classify at release (before)", syncUs / kStrokes, "us");
+}
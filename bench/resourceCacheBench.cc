@@ -0,0 +1,58 @@
+// resourceCacheBench.cc
+// Stall of spawning 1,000 drawn platforms. Before the shared quad and the
+// ResourceCache, each Platform read platform.vs/.fs from disk, compiled and
+// linked its own program and created a VBO/IBO/VAO; now it gets a sprite
+// mesh and shares the one cached program. Compile/link and buffer creation
+// need a GL context, so the "before" row only counts the file reads and is
+// a lower bound. The texture comes from NullRenderBackend; platforms only
+// hold it.
+#include "bench.h"
+#include "core/entityManager.h"
+#include "entities/platform.h"
+#include "renderer/renderBackend.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+constexpr int kPlatforms = 1000;
+
+std::string readFile(const std::string &path) {
+    std::ifstream file(path);
+    std::stringstream ss;
+    ss << file.rdbuf();
+    return ss.str();
+}
+}  // namespace
+
+INK_BENCH(resourceCache) {
+    NullRenderBackend backend;
+    const std::shared_ptr<Texture> texture = backend.createDynamicTexture(64, 64, nullptr);
+
+    // Platform logs every spawn; keep it out of the timing and the output.
+    std::streambuf *coutBuf = std::cout.rdbuf(nullptr);
+
+    std::size_t shaderBytes = 0;
+    const double beforeMs = Bench::timeMs(1, [&] {
+        for (int i = 0; i < kPlatforms; ++i) {
+            shaderBytes += readFile(std::string(SHADER_DIR) + "platform.vs").size();
+            shaderBytes += readFile(std::string(SHADER_DIR) + "platform.fs").size();
+        }
+    });
+
+    EntityManager em(BroadphaseType::sweepAndPrune);
+    const double afterMs = Bench::timeMs(1, [&] {
+        for (int i = 0; i < kPlatforms; ++i) {
+            em.add<Platform>(PlatformType::stationary, texture,
+                             glm::vec3(1.5f * i, 0.0f, 0.0f), 0.0f, glm::vec2(1.0f, 0.3f), true);
+        }
+    });
+
+    std::cout.rdbuf(coutBuf);
+    std::printf(" %d drawn platforms\n", kPlatforms);
+    Bench::report("before: shader file reads only", beforeMs, "ms");
+    Bench::report("before: shader bytes read", double(shaderBytes), "B");
+    Bench::report("after: spawn through EntityManager", afterMs, "ms");
+    Bench::report("after: per platform", afterMs * 1000.0 / kPlatforms, "us");
+}
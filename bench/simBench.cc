@@ -0,0 +1,147 @@
+// simBench.cc
+// Regression suite for the headless simulation (InkSim, null render
+// backend): tick cost, level load, stroke-to-platform latency and
+// recognizer throughput, each at several scales. Rows are ms per iteration;
+// run with --csv=<file> on CI and compare against a previous run.
+#include "bench.h"
+#include "core/drawnPlatform.h"
+#include "core/entityManager.h"
+#include "core/levelLoader.h"
+#include "core/recognizer.h"
+#include "core/strokeRecorder.h"
+#include "entities/platform.h"
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+
+namespace {
+constexpr float kDt = 1.0f / 60.0f;
+constexpr const char *kTexture = "bench_tile";
+
+// Entities and the loader log every spawn; keep that out of the timings.
+struct QuietCout {
+    std::streambuf *saved = std::cout.rdbuf(nullptr);
+    ~QuietCout() {
+        std::cout.rdbuf(saved);
+    }
+};
+
+// Registers the bench texture without touching disk (null backend).
+std::shared_ptr<Texture> benchTexture() {
+    auto tm = TextureManager::instance();
+    if (!tm->hasTexture(kTexture))
+        tm->createDynamicTexture(kTexture, 16, 16);
+    return tm->getTexture(kTexture);
+}
+
+// A long strip of platforms with one body in five falling onto it.
+void populate(EntityManager &em, std::size_t count) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> x(0.0f, count * 1.5f);
+    std::uniform_real_distribution<float> y(-3.0f, 3.0f);
+    std::uniform_real_distribution<float> w(0.3f, 3.0f);
+    em.components().reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const bool dynamic = i % 5 == 0;
+        BodyDesc desc;
+        desc.position = glm::vec3(x(rng), y(rng), 0.0f);
+        desc.scale = desc.hitboxSize = dynamic ? glm::vec2(0.2f) : glm::vec2(w(rng), 0.3f);
+        desc.mass = dynamic ? 0.2f : 0.0f;
+        desc.flags = BodyFlags::hitboxActive | BodyFlags::collides |
+                     (dynamic ? BodyFlags::movesOnCollision : BodyFlags::isStatic);
+        em.spawnBody(desc);
+    }
+    em.bakeStatic();
+}
+
+// Level JSON in the format levelLoader reads: `count` platforms and a player.
+std::filesystem::path writeLevel(std::size_t count) {
+    const auto path = std::filesystem::temp_directory_path() /
+                      ("ink_bench_level_" + std::to_string(count) + ".json");
+    std::ofstream out(path);
+    out << R"({"levelName":"bench","objects":[)";
+    out << R"({"type":"character","texture":")" << kTexture
+        << R"(","position":[0,2,0],"scale":[0.2,0.2]})";
+    for (std::size_t i = 0; i < count; ++i) {
+        out << R"(,{"type":"platform","texture":")" << kTexture << R"(","position":[)"
+            << i * 1.5f << ",0,0],\"scale\":[1.5,0.3]}";
+    }
+    out << "]}\n";
+    return path;
+}
+
+// A wavy left-to-right stroke of `count` samples in normalized coordinates.
+std::vector<glm::vec2> makeStroke(std::size_t count) {
+    std::vector<glm::vec2> points(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const float t = count > 1 ? float(i) / float(count - 1) : 0.0f;
+        points[i] = glm::vec2(0.3f + 0.4f * t, 0.5f + 0.05f * std::sin(t * 12.0f));
+    }
+    return points;
+}
+}  // namespace
+
+// One fixed-step update over `arg` bodies.
+INK_BENCH_ARGS(simTick, 1000, 10000, 50000) {
+    EntityManager em(BroadphaseType::sweepAndPrune);
+    populate(em, static_cast<std::size_t>(state.arg()));
+    for (auto _: state) {
+        em.update(kDt);
+    }
+    state.setItemsProcessed(state.iterations() * state.arg());
+}
+
+// Parse a level file with `arg` platforms and spawn it into a fresh manager.
+INK_BENCH_ARGS(simLevelLoad, 100, 1000, 10000) {
+    QuietCout quiet;
+    benchTexture();
+    const auto path = writeLevel(static_cast<std::size_t>(state.arg()));
+    for (auto _: state) {
+        EntityManager em(BroadphaseType::sweepAndPrune);
+        loadLevelFromFile(path.string(), TextureManager::instance(), &em);
+    }
+    state.setItemsProcessed(state.iterations() * state.arg());
+    std::filesystem::remove(path);
+}
+
+// Mouse release to platform in the world, for a stroke of `arg` samples:
+// recorder hand-off, recognition, placement and spawn into a 1,000-body
+// level. Feeding the pressed samples is input capture and is not timed.
+INK_BENCH_ARGS(simStrokeToPlatform, 16, 64, 256) {
+    QuietCout quiet;
+    auto texture = benchTexture();
+    EntityManager em(BroadphaseType::sweepAndPrune);
+    populate(em, 1000);
+    StrokeRecorder *recorder = StrokeRecorder::instance();
+    const auto stroke = makeStroke(static_cast<std::size_t>(state.arg()));
+    double now = 0.0;
+
+    for (auto _: state) {
+        state.pauseTiming();
+        for (const glm::vec2 &p: stroke)
+            recorder->feed(true, p, now += 1.0 / 120.0);
+        state.resumeTiming();
+
+        recorder->feed(false, glm::vec2(0.0f), now += 1.0 / 120.0);
+        auto s = recorder->popCompletedStroke();
+        Recognizer::instance()->submitStroke(s->points);
+        Recognizer::instance()->popNewPrediction();
+        const DrawnPlatform placed = placeDrawnPlatform(s->points, glm::vec3(0.0f));
+        em.add<Platform>(PlatformType::stationary, texture, placed.position, 0.0f, placed.size,
+                         true);
+    }
+}
+
+// Recognizer throughput for strokes of `arg` samples.
+INK_BENCH_ARGS(simRecognizer, 32, 128, 512, 2048) {
+    const auto stroke = makeStroke(static_cast<std::size_t>(state.arg()));
+    Recognizer *recognizer = Recognizer::instance();
+    for (auto _: state) {
+        recognizer->submitStroke(stroke);
+        recognizer->popNewPrediction();
+    }
+    state.setItemsProcessed(state.iterations());
+}
@@ -0,0 +1,67 @@
+// spriteBatchBench.cc
+// Draw calls and state changes for a 10k-platform level, per-object path vs
+// SpriteBatch. The batch plan is what SpriteRenderer turns into GL calls one
+// to one, so counting ranges here needs no GL context. Shader and texture
+// pointers are only batch keys, so placeholder addresses stand in for them.
+#include "bench.h"
+#include "renderer/spriteBatch.h"
+
+#include <random>
+
+namespace {
+constexpr std::size_t kPlatforms = 10000;
+constexpr std::size_t kTextures = 4;  // a level rarely uses more tile sets
+
+struct Placeholder {
+    char byte;
+};
+}  // namespace
+
+INK_BENCH(spriteBatch) {
+    Placeholder shaderKey{}, textureKeys[kTextures + 2] = {};
+    auto *shader = reinterpret_cast<Shader *>(&shaderKey);
+    auto texture = [&](std::size_t i) {
+        return reinterpret_cast<const Texture *>(&textureKeys[i]);
+    };
+
+    // Platforms in level order with random tile sets, a player and the overlay.
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> x(0.0f, kPlatforms * 1.5f);
+    std::uniform_real_distribution<float> y(-3.0f, 3.0f);
+    std::uniform_int_distribution<std::size_t> tex(0, kTextures - 1);
+    std::vector<std::pair<const Texture *, SpriteInstance>> frame;
+    for (std::size_t i = 0; i < kPlatforms; ++i) {
+        const glm::vec2 scale(1.5f, 0.3f);
+        frame.push_back({texture(tex(rng)),
+                         {glm::vec3(x(rng), y(rng), 0.0f), scale, glm::vec4(0, 0, scale), 0.0f}});
+    }
+    frame.push_back({texture(kTextures), {glm::vec3(0.0f), glm::vec2(0.2f), glm::vec4(0, 0, 1, 1), 0.0f}});
+    frame.push_back({texture(kTextures + 1),
+                     {glm::vec3(-0.8f, 0.8f, 0.0f), glm::vec2(0.2f), glm::vec4(0, 0, 1, 1), 1.0f}});
+
+    // Old path: every object binds its VAO, shader and texture and draws.
+    std::printf(" %zu sprites, %zu textures\n", frame.size(), kTextures + 2);
+    Bench::report("per-object draw calls", double(frame.size()), "");
+    Bench::report("per-object shader + texture binds", double(2 * frame.size()), "");
+
+    SpriteBatch batch;
+    const double ms = Bench::timeMs(100, [&] {
+        batch.clear();
+        for (const auto &[t, inst]: frame)
+            batch.submit(shader, t, inst);
+        batch.build();
+    });
+
+    std::size_t textureBinds = 0;
+    const Texture *bound = nullptr;
+    for (const auto &range: batch.batches()) {
+        textureBinds += range.texture != bound;
+        bound = range.texture;
+    }
+    Bench::report("batched draw calls", double(batch.batches().size()), "");
+    Bench::report("batched shader binds", 1.0, "");
+    Bench::report("batched texture binds", double(textureBinds), "");
+    Bench::report("instance bytes streamed", double(batch.instances().size() * sizeof(SpriteInstance)),
+                  "B");
+    Bench::report("submit + sort + pack ms/frame", ms, "ms");
+}
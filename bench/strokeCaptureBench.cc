@@ -0,0 +1,140 @@
+// strokeCaptureBench.cc
+// Replays recorded input event streams into StrokeRecorder two ways: the
+// way poll() sees them (cursor read once per 60 Hz frame) and the way the
+// attach() callbacks do (every motion event, through cursorMoved /
+// buttonChanged). Streams are a fast 150 ms flick and a slow 1.5 s curve,
+// from a 125 Hz and a 1000 Hz mouse. Reports samples per stroke, the
+// longest straight segment left in the stroke, and heap allocations made
+// while capturing (the completed-stroke copy is counted separately).
+#include "bench.h"
+#include "core/strokeRecorder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace {
+constexpr double kFrameInterval = 1.0 / 60.0;
+
+/// One recorded GLFW event, as the callbacks would have received it.
+struct ReplayEvent {
+    enum Type { Move, Press, Release } type;
+    glm::vec2 point;  // normalized window coordinates (Move)
+    double time;
+};
+
+/// A press, `duration` seconds of motion along `path` at `rateHz`, a release.
+template <class Path>
+std::vector<ReplayEvent> record(Path path, double duration, double rateHz) {
+    std::vector<ReplayEvent> events;
+    const double start = 1.0;
+    events.push_back({ReplayEvent::Move, path(0.0), start});
+    events.push_back({ReplayEvent::Press, glm::vec2(0.0f), start});
+    const int samples = static_cast<int>(duration * rateHz);
+    for (int i = 1; i <= samples; ++i) {
+        const double t = double(i) / samples;
+        events.push_back({ReplayEvent::Move, path(t), start + i / rateHz});
+    }
+    events.push_back({ReplayEvent::Release, glm::vec2(0.0f), start + duration + 1e-4});
+    return events;
+}
+
+glm::vec2 flick(double t) {  // most of a circle, 0.3 of the window across
+    const float a = static_cast<float>(t * 5.5);
+    return glm::vec2(0.5f + 0.15f * std::cos(a), 0.5f + 0.15f * std::sin(a));
+}
+
+glm::vec2 curve(double t) {
+    const float s = static_cast<float>(t);
+    return glm::vec2(0.2f + 0.6f * s, 0.5f + 0.2f * std::sin(6.0f * s));
+}
+
+/// Frame-rate capture: at each frame, feed() with the button and cursor
+/// state the last event before it left behind, as poll() would read them.
+void replayPolled(const std::vector<ReplayEvent> &events, StrokeRecorder &recorder) {
+    bool pressed = false;
+    glm::vec2 cursor(0.0f);
+    std::size_t next = 0;
+    for (double frame = events.front().time; next < events.size(); frame += kFrameInterval) {
+        for (; next < events.size() && events[next].time <= frame; ++next) {
+            const ReplayEvent &e = events[next];
+            if (e.type == ReplayEvent::Move)
+                cursor = e.point;
+            else
+                pressed = e.type == ReplayEvent::Press;
+        }
+        recorder.feed(pressed, cursor, frame);
+    }
+    recorder.feed(false, cursor, events.back().time);
+}
+
+/// Event capture: every event goes in as the callbacks deliver it.
+void replayEvents(const std::vector<ReplayEvent> &events, StrokeRecorder &recorder) {
+    for (const ReplayEvent &e: events) {
+        if (e.type == ReplayEvent::Move)
+            recorder.cursorMoved(e.point, e.time);
+        else
+            recorder.buttonChanged(e.type == ReplayEvent::Press, e.time);
+    }
+}
+
+struct Capture {
+    std::size_t samples = 0;
+    float longestSegment = 0.0f;  // normalized window units
+    std::size_t captureAllocations = 0, popAllocations = 0;
+};
+
+template <class Replay>
+Capture capture(const std::vector<ReplayEvent> &events, Replay replay) {
+    StrokeRecorder &recorder = *StrokeRecorder::instance();
+    Capture c;
+    std::size_t before = Bench::allocations();
+    replay(events, recorder);
+    c.captureAllocations = Bench::allocations() - before;
+
+    before = Bench::allocations();
+    const std::optional<StrokeRecorder::Stroke> stroke = recorder.popCompletedStroke();
+    c.popAllocations = Bench::allocations() - before;
+    if (!stroke)
+        return c;
+    c.samples = stroke->points.size();
+    for (std::size_t i = 1; i < stroke->points.size(); ++i)
+        c.longestSegment = std::max(c.longestSegment,
+                                    glm::length(stroke->points[i] - stroke->points[i - 1]));
+    return c;
+}
+}  // namespace
+
+INK_BENCH(strokeCapture) {
+    struct Stream {
+        const char *name;
+        std::vector<ReplayEvent> events;
+    };
+    const Stream streams[] = {
+            {"flick 150ms @125Hz", record(flick, 0.15, 125.0)},
+            {"flick 150ms @1000Hz", record(flick, 0.15, 1000.0)},
+            {"curve 1.5s @125Hz", record(curve, 1.5, 125.0)},
+            {"curve 1.5s @1000Hz", record(curve, 1.5, 1000.0)},
+    };
+    for (const Stream &stream: streams) {
+        const Capture polled = capture(stream.events, replayPolled);
+        const Capture events = capture(stream.events, replayEvents);
+        const std::string name = stream.name;
+        Bench::report(name + ": polled samples", double(polled.samples), "");
+        Bench::report(name + ": event samples", double(events.samples), "");
+        Bench::report(name + ": polled longest segment", polled.longestSegment, "");
+        Bench::report(name + ": event longest segment", events.longestSegment, "");
+        Bench::report(name + ": capture allocations",
+                      double(polled.captureAllocations + events.captureAllocations), "");
+        Bench::report(name + ": pop allocations", double(events.popAllocations), "");
+    }
+
+    // Per-event cost on the callback path, which runs inside glfwPollEvents().
+    const std::vector<ReplayEvent> burst = record(curve, 10.0, 1000.0);
+    StrokeRecorder &recorder = *StrokeRecorder::instance();
+    const double ms = Bench::timeMs(20, [&] {
+        replayEvents(burst, recorder);
+        recorder.popCompletedStroke();
+    });
+    Bench::report("event + pop, per event", ms * 1e6 / double(burst.size()), "ns");
+}
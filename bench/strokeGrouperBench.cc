@@ -0,0 +1,201 @@
+// strokeGrouperBench.cc
+// A drawing session of 200 symbols of one to three strokes (line, plus,
+// equals, cross, arrow) at random spots: strokes of a symbol 0.08-0.25 s
+// apart, symbols 0.6-1.2 s apart, except one in four that follows within
+// 0.25 s but far away. For a range of follow-up waits (the latency budget)
+// the grouper is driven at 60 Hz frames on a simulated clock, the way
+// RecognizerService drives it, and reports the share of symbols grouped
+// exactly and the release-to-classify latency the wait costs. Then
+// throughput: the session's strokes through a live RecognizerService one
+// at a time (hand-over, wake-up, classify, poll). Last, a
+// service with the default 0.3 s wait gets 16 strokes on a grid: release
+// to provisional result against release to final result.
+#include "bench.h"
+#include "core/recognizerService.h"
+#include "core/strokeGrouper.h"
+#include "core/strokeRaster.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <thread>
+
+namespace {
+constexpr int kSymbols = 200;
+constexpr double kFrame = 1.0 / 60.0;
+
+using Clock = StrokeGrouper::Clock;
+
+struct SimStroke {
+    StrokeRaster raster;
+    double start = 0.0, end = 0.0;
+    int symbol = 0;
+};
+
+struct Symbol {
+    uint64_t first = 0;  // stroke numbers, 1-based like RecognizerService's
+    uint32_t strokes = 0;
+};
+
+std::vector<glm::vec2> segment(glm::vec2 a, glm::vec2 b) {
+    std::vector<glm::vec2> points;
+    for (int i = 0; i <= 16; ++i)
+        points.push_back(glm::mix(a, b, i / 16.0f));
+    return points;
+}
+
+// Strokes of one symbol centred on `c`, `s` across.
+std::vector<std::vector<glm::vec2>> symbolStrokes(int kind, glm::vec2 c, float s) {
+    const float h = 0.5f * s;
+    switch (kind) {
+    case 0:  // line
+        return {segment(c - glm::vec2(h, -h), c + glm::vec2(h, -h))};
+    case 1:  // plus
+        return {segment(c - glm::vec2(h, 0), c + glm::vec2(h, 0)),
+                segment(c - glm::vec2(0, h), c + glm::vec2(0, h))};
+    case 2:  // equals
+        return {segment(c + glm::vec2(-h, -0.3f * h), c + glm::vec2(h, -0.3f * h)),
+                segment(c + glm::vec2(-h, 0.3f * h), c + glm::vec2(h, 0.3f * h))};
+    case 3:  // cross
+        return {segment(c - glm::vec2(h, h), c + glm::vec2(h, h)),
+                segment(c + glm::vec2(-h, h), c + glm::vec2(h, -h))};
+    default:  // arrow: shaft, then both halves of the head
+        return {segment(c - glm::vec2(h, 0), c + glm::vec2(h, 0)),
+                segment(c + glm::vec2(h, 0), c + glm::vec2(0.4f * h, -0.5f * h)),
+                segment(c + glm::vec2(h, 0), c + glm::vec2(0.4f * h, 0.5f * h))};
+    }
+}
+
+void makeSession(std::vector<SimStroke> &strokes, std::vector<Symbol> &symbols) {
+    std::mt19937 rng(24);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    double t = 0.0;
+    glm::vec2 last(0.5f);
+    for (int n = 0; n < kSymbols; ++n) {
+        const bool quick = n > 0 && unit(rng) < 0.25f;
+        glm::vec2 c;
+        do {
+            c = glm::vec2(0.15f + 0.7f * unit(rng), 0.15f + 0.7f * unit(rng));
+        } while (quick && glm::length(c - last) < 0.35f);
+        last = c;
+        t += quick ? 0.1 + 0.15 * unit(rng) : 0.6 + 0.6 * unit(rng);
+
+        symbols.push_back(Symbol{strokes.size() + 1, 0});
+        for (const auto &points: symbolStrokes(n % 5, c, 0.08f + 0.06f * unit(rng))) {
+            if (symbols.back().strokes > 0)
+                t += 0.08 + 0.17 * unit(rng);
+            SimStroke stroke;
+            stroke.raster.extend(points);
+            stroke.start = t;
+            t += 0.12 + 0.18 * unit(rng);
+            stroke.end = t;
+            stroke.symbol = n;
+            strokes.push_back(std::move(stroke));
+            ++symbols.back().strokes;
+        }
+    }
+}
+
+// The simulated clock: seconds since the session started.
+Clock::time_point at(double seconds) {
+    return Clock::time_point(
+            std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds)));
+}
+double seconds(Clock::time_point t) {
+    return std::chrono::duration<double>(t.time_since_epoch()).count();
+}
+
+double percentile(std::vector<double> v, double p) {
+    std::sort(v.begin(), v.end());
+    return v[std::min(v.size() - 1, static_cast<std::size_t>(p * (v.size() - 1) + 0.5))];
+}
+}  // namespace
+
+INK_BENCH(strokeGrouper) {
+    std::vector<SimStroke> strokes;
+    std::vector<Symbol> symbols;
+    makeSession(strokes, symbols);
+    std::printf("  %zu symbols, %zu strokes\n", symbols.size(), strokes.size());
+
+    for (double followUp: {0.0, 0.1, 0.2, 0.3, 0.5}) {
+        StrokeGrouper::Settings settings;
+        settings.followUpSeconds = followUp;
+        StrokeGrouper grouper(settings);
+        std::vector<StrokeGrouper::Group> ready;
+        std::vector<double> latencyMs;
+        std::size_t next = 0, correct = 0;
+        const double end = strokes.back().end + 1.0;
+        for (double now = 0.0; now < end; now += kFrame) {
+            // Releases since the last frame, then the stroke being drawn
+            // (what RecognizerService learns from live submissions).
+            for (; next < strokes.size() && strokes[next].end <= now; ++next) {
+                grouper.add(next + 1, strokes[next].raster.pixels(), at(strokes[next].start),
+                            at(strokes[next].end));
+            }
+            if (next < strokes.size() && strokes[next].start <= now)
+                grouper.begin(next + 1, at(strokes[next].start));
+
+            ready.clear();
+            grouper.takeReady(at(now), ready);
+            for (const auto &group: ready) {
+                const Symbol &truth = symbols[strokes[group.firstStroke - 1].symbol];
+                correct += group.firstStroke == truth.first && group.strokes == truth.strokes;
+                latencyMs.push_back(1000.0 * (now - seconds(group.released)));
+            }
+        }
+        char name[32];
+        std::snprintf(name, sizeof(name), "follow-up %.1f s:", followUp);
+        Bench::report(std::string(name) + " symbols grouped right",
+                      100.0 * correct / symbols.size(), "%");
+        Bench::report(std::string(name) + " release -> classify p50", percentile(latencyMs, 0.5),
+                      "ms");
+    }
+
+    // No follow-up wait here, so every stroke comes back as a symbol at once.
+    RecognizerService::Settings settings;
+    settings.grouping.followUpSeconds = 0.0;
+    settings.gestureTemplates.clear();  // rasters only, no fast path
+    RecognizerService service(settings);
+    const double ms = Bench::timeMs(1, [&] {
+        for (const auto &stroke: strokes) {
+            service.submitFinal(stroke.raster);
+            while (!service.poll())
+                std::this_thread::yield();
+        }
+    });
+    Bench::report("service, one symbol at a time, symbols/s", strokes.size() / (ms / 1000.0), "");
+
+    // Default wait: every release gets a provisional result before its final one.
+    RecognizerService::Settings waiting;
+    waiting.gestureTemplates.clear();
+    RecognizerService delayed(waiting);
+    constexpr std::size_t kGrid = 16;
+    std::vector<double> provisionalMs, finalMs;
+    uint64_t lastFinal = 0;
+    auto drain = [&] {
+        while (auto result = delayed.poll()) {
+            const double resultMs = std::chrono::duration<double, std::milli>(
+                    result->classified - result->submitted).count();
+            (result->final ? finalMs : provisionalMs).push_back(resultMs);
+            if (result->final)
+                lastFinal = result->stroke;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    };
+    for (std::size_t i = 0; i < kGrid; ++i) {
+        const glm::vec2 c(0.125f + 0.25f * (i % 4), 0.125f + 0.25f * (i / 4));
+        StrokeRaster raster;
+        raster.extend(segment(c - glm::vec2(0.05f, 0.0f), c + glm::vec2(0.05f, 0.0f)));
+        delayed.submitFinal(raster);
+        while (provisionalMs.size() <= i)  // one stroke at a time, as drawn
+            drain();
+    }
+    while (lastFinal < kGrid)  // neighbours may join, so fewer symbols than strokes
+        drain();
+    Bench::report("follow-up 0.3 s: symbols from the 16 strokes", double(finalMs.size()), "");
+    Bench::report("follow-up 0.3 s: release -> provisional p50", percentile(provisionalMs, 0.5),
+                  "ms");
+    Bench::report("follow-up 0.3 s: release -> final p50", percentile(finalMs, 0.5), "ms");
+}
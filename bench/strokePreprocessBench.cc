@@ -0,0 +1,209 @@
+// strokePreprocessBench.cc
+// 500 stroke rasters (dots, lines, arcs, scribbles at random spots and
+// sizes). "before" is the two double-precision passes Recognizer::classify
+// used to make for centroid and second moments; "after" is
+// StrokePreprocess::measure at each SIMD level, which must agree with the
+// scalar one exactly and with the old passes to rounding, and must leave
+// every classify() label unchanged. Then the full MNIST-style preprocess
+// (measure + resample) into a TinyCnn input, and where the resampled
+// strokes land: centre of mass (should be the frame centre) and longer
+// ink side (should be about kFit).
+#include "bench.h"
+#include "core/recognizer.h"
+#include "core/strokePreprocess.h"
+#include "core/strokeRaster.h"
+#include "core/tinyCnn.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <string>
+
+namespace {
+constexpr int kStrokes = 500;
+constexpr int kSize = StrokeRaster::kSize;
+constexpr int kOut = StrokePreprocess::kOutput;
+
+std::vector<StrokeRaster> makeStrokes() {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<StrokeRaster> rasters(kStrokes);
+    for (int s = 0; s < kStrokes; ++s) {
+        const glm::vec2 centre(0.2f + 0.6f * unit(rng), 0.2f + 0.6f * unit(rng));
+        const float size = 0.02f + 0.3f * unit(rng);
+        const float angle = 6.283f * unit(rng);
+        std::vector<glm::vec2> points;
+        for (int i = 0; i < 64; ++i) {
+            const float t = i / 63.0f;
+            glm::vec2 p;
+            switch (s % 4) {
+            case 0:  // dot
+                p = centre;
+                break;
+            case 1:  // line
+                p = centre + size * (t - 0.5f) * glm::vec2(std::cos(angle), std::sin(angle));
+                break;
+            case 2:  // arc
+                p = centre + size * glm::vec2(std::cos(angle + 4.0f * t),
+                                              std::sin(angle + 4.0f * t));
+                break;
+            default:  // scribble
+                p = centre + size * glm::vec2(std::sin(7.0f * t + angle), std::cos(11.0f * t));
+                break;
+            }
+            points.push_back(glm::clamp(p, 0.0f, 1.0f));
+        }
+        rasters[s].extend(points);
+    }
+    return rasters;
+}
+
+// Recognizer::classify's moment loops before this change.
+struct TwoPass {
+    double sum, cx, cy, ixx, iyy;
+};
+TwoPass twoPass(const unsigned char *pixels) {
+    TwoPass r{};
+    for (int y = 0; y < kSize; ++y) {
+        for (int x = 0; x < kSize; ++x) {
+            const double w = pixels[y * kSize + x] / 255.0;
+            r.sum += w;
+            r.cx += w * x;
+            r.cy += w * y;
+        }
+    }
+    if (r.sum <= 1e-3)
+        return r;
+    r.cx /= r.sum;
+    r.cy /= r.sum;
+    for (int y = 0; y < kSize; ++y) {
+        for (int x = 0; x < kSize; ++x) {
+            const double w = pixels[y * kSize + x] / 255.0;
+            const double dx = x - r.cx, dy = y - r.cy;
+            r.ixx += w * dy * dy;
+            r.iyy += w * dx * dx;
+        }
+    }
+    return r;
+}
+
+// The old classify() on top of twoPass(), for label agreement.
+std::string classifyTwoPass(const unsigned char *pixels) {
+    const TwoPass t = twoPass(pixels);
+    if (t.sum <= 1e-3)
+        return "none";
+    const double anisotropy = std::abs(t.ixx - t.iyy) / (t.ixx + t.iyy + 1e-6);
+    if (t.sum < 40.0)
+        return "dot";
+    if (anisotropy > 0.4)
+        return t.iyy > t.ixx ? "horizontal" : "vertical";
+    return "curve";
+}
+
+double relativeError(double a, double b) {
+    return std::abs(a - b) / std::max(1.0, std::abs(b));
+}
+}  // namespace
+
+INK_BENCH(strokePreprocess) {
+    const auto rasters = makeStrokes();
+    volatile double sink = 0.0;
+
+    const double beforeUs = 1000.0 * Bench::timeMs(1, [&] {
+        double acc = 0.0;
+        for (const auto &r: rasters)
+            acc += twoPass(r.pixels()).ixx;
+        sink = acc;
+    }) / kStrokes;
+    Bench::report("before: two double passes per stroke", beforeUs, "us");
+
+    // Exact agreement across levels; old moments to rounding.
+    std::vector<StrokePreprocess::Moments> scalar;
+    double worst = 0.0;
+    for (const auto &r: rasters) {
+        const auto m = StrokePreprocess::measure(r.pixels(), SimdLevel::scalar);
+        const TwoPass t = twoPass(r.pixels());
+        if (!m.empty()) {
+            worst = std::max({worst, relativeError(m.mass / 255.0, t.sum),
+                              relativeError(m.centroidX(), t.cx),
+                              relativeError(m.centroidY(), t.cy),
+                              relativeError(m.varianceY() / 255.0, t.ixx),
+                              relativeError(m.varianceX() / 255.0, t.iyy)});
+        }
+        scalar.push_back(m);
+    }
+    Bench::report("max relative difference vs two passes", worst, "");
+    Bench::check("agrees with two passes to rounding", worst < 1e-9);
+
+    for (SimdLevel level:
+         {SimdLevel::scalar, SimdLevel::sse2, SimdLevel::avx2, SimdLevel::neon}) {
+        if (!simdLevelSupported(level))
+            continue;
+        const std::string name = simdLevelName(level);
+        std::size_t mismatches = 0;
+        for (int s = 0; s < kStrokes; ++s) {
+            const auto m = StrokePreprocess::measure(rasters[s].pixels(), level);
+            const auto &e = scalar[s];
+            mismatches += m.minX != e.minX || m.maxX != e.maxX || m.minY != e.minY ||
+                          m.maxY != e.maxY || m.mass != e.mass || m.sumX != e.sumX ||
+                          m.sumY != e.sumY || m.sumXX != e.sumXX || m.sumYY != e.sumYY ||
+                          m.sumXY != e.sumXY;
+        }
+        Bench::report(name + " mismatches vs scalar", double(mismatches), "");
+        Bench::check(name + " identical to scalar", mismatches == 0);
+        const double us = 1000.0 * Bench::timeMs(20, [&] {
+            uint64_t acc = 0;
+            for (const auto &r: rasters)
+                acc += StrokePreprocess::measure(r.pixels(), level).sumXX;
+            sink = double(acc);
+        }) / kStrokes;
+        Bench::report(name + " measure per stroke", us, "us");
+        Bench::report(name + " speedup", beforeUs / us, "x");
+    }
+
+    std::size_t labelChanges = 0;
+    for (const auto &r: rasters)
+        labelChanges += Recognizer::classify(r.pixels()).label != classifyTwoPass(r.pixels());
+    Bench::report("classify labels changed", double(labelChanges), "");
+    Bench::check("classify labels unchanged", labelChanges == 0);
+
+    // The whole preprocess, written straight into a net's input tensor.
+    TinyCnn net(TinyCnn::Shape{1, kOut, kOut});
+    const double preprocessUs = 1000.0 * Bench::timeMs(20, [&] {
+        for (const auto &r: rasters) {
+            const auto m = StrokePreprocess::measure(r.pixels());
+            StrokePreprocess::resample(r.pixels(), m, net.input());
+        }
+    }) / kStrokes;
+    Bench::report("measure + resample to 28x28 per stroke", preprocessUs, "us");
+
+    double centreError = 0.0, side = 0.0;
+    int counted = 0;
+    std::vector<float> out(kOut * kOut);
+    for (const auto &r: rasters) {
+        const auto m = StrokePreprocess::measure(r.pixels());
+        if (m.empty())
+            continue;
+        StrokePreprocess::resample(r.pixels(), m, out.data());
+        double mass = 0.0, cx = 0.0, cy = 0.0;
+        int minX = kOut, maxX = -1, minY = kOut, maxY = -1;
+        for (int y = 0; y < kOut; ++y) {
+            for (int x = 0; x < kOut; ++x) {
+                const float v = out[y * kOut + x];
+                mass += v;
+                cx += v * (x + 0.5);
+                cy += v * (y + 0.5);
+                if (v > 0.0f) {
+                    minX = std::min(minX, x), maxX = std::max(maxX, x);
+                    minY = std::min(minY, y), maxY = std::max(maxY, y);
+                }
+            }
+        }
+        centreError += std::hypot(cx / mass - kOut / 2, cy / mass - kOut / 2);
+        side += std::max(maxX - minX, maxY - minY) + 1;
+        ++counted;
+    }
+    Bench::report("resampled centre of mass off centre, mean", centreError / counted, "px");
+    Bench::report("resampled longer ink side, mean", side / counted, "px");
+}
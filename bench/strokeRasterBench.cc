@@ -0,0 +1,119 @@
+// strokeRasterBench.cc
+// The drawing canvas over one long stroke: a 5 s scribble from a 1000 Hz
+// mouse fed to StrokeRecorder, with the canvas refreshed every 60 Hz frame.
+// "before" redraws the whole stroke into the RGBA buffer each frame, as
+// CanvasOverlay::update used to; "after" is CanvasOverlay::rasterizeStroke
+// (online simplification, persistent raster, new segments and the dirty
+// rectangle only). At the end the recognizer classifies the overlay's
+// raster instead of drawing the simplified stroke again. The overlay also
+// drew the moving tail at each frame, all within the simplifier's
+// tolerance, so the two rasters differ only by stair-stepping; the
+// mismatch count and the label show by how much.
+#include "bench.h"
+#include "core/drawing.h"
+#include "core/recognizer.h"
+#include "core/strokeRaster.h"
+#include "core/strokeRecorder.h"
+#include "entities/canvasOverlay.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+constexpr int kSamples = 5000;        // 5 s at 1000 Hz
+constexpr int kSamplesPerFrame = 16;  // ~60 Hz frames
+constexpr int kCanvas = StrokeRaster::kSize;
+
+using Clock = std::chrono::steady_clock;
+
+glm::vec2 scribble(int i) {
+    const float t = float(i) / kSamples;
+    return glm::vec2(0.15f + 0.7f * t + 0.05f * std::cos(60.0f * t),
+                     0.5f + 0.25f * std::sin(9.0f * t) + 0.05f * std::sin(60.0f * t));
+}
+
+// The overlay's old per-tick work: clear, then every segment again.
+void redrawAll(const std::vector<glm::vec2> &points, std::vector<unsigned char> &rgba) {
+    Raster::ImageRgba img{rgba.data(), kCanvas, kCanvas};
+    Raster::clear(img, 16, 255);
+    auto toCanvas = [](const glm::vec2 &p) {
+        const glm::vec2 n = glm::clamp(p, 0.0f, 1.0f);
+        return glm::ivec2(int(n.x * (kCanvas - 1) + 0.5f),
+                          int((1.0f - n.y) * (kCanvas - 1) + 0.5f));
+    };
+    glm::ivec2 a = toCanvas(points.front());
+    Raster::drawDisc(img, a.x, a.y, 1);
+    for (std::size_t i = 1; i < points.size(); ++i) {
+        const glm::ivec2 b = toCanvas(points[i]);
+        Raster::drawLine(img, a.x, a.y, b.x, b.y, 1);
+        a = b;
+    }
+}
+
+double microsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+}  // namespace
+
+INK_BENCH(strokeRaster) {
+    StrokeRecorder &recorder = *StrokeRecorder::instance();
+    CanvasOverlay overlay;
+    overlay.rasterizeStroke();  // settle the initial blank canvas
+
+    StrokeRecorder::Cursor cursor;
+    std::vector<glm::vec2> mirror;
+    std::vector<unsigned char> rgba(kCanvas * kCanvas * 4);
+    double beforeUs = 0.0, afterUs = 0.0, beforeLastUs = 0.0, afterLastUs = 0.0;
+    int frames = 0;
+
+    recorder.cursorMoved(scribble(0), 0.0);
+    recorder.buttonChanged(true, 0.0);
+    for (int i = 1; i <= kSamples; ++i) {
+        recorder.cursorMoved(scribble(i), i * 1e-3);
+        if (i % kSamplesPerFrame != 0)
+            continue;
+        recorder.readCurrentPoints(cursor, mirror);
+        auto start = Clock::now();
+        redrawAll(mirror, rgba);
+        beforeLastUs = microsSince(start);
+        beforeUs += beforeLastUs;
+
+        start = Clock::now();
+        overlay.rasterizeStroke();
+        afterLastUs = microsSince(start);
+        afterUs += afterLastUs;
+        ++frames;
+    }
+    recorder.buttonChanged(false, kSamples * 1e-3);
+    const std::optional<StrokeRecorder::Stroke> stroke = recorder.popCompletedStroke();
+
+    Recognizer &recognizer = *Recognizer::instance();
+    const double redrawSubmitUs =
+            1000.0 * Bench::timeMs(100, [&] { recognizer.submitStroke(stroke->simplified); });
+    const std::string redrawLabel = recognizer.popNewPrediction()->label;
+    const StrokeRaster *shared = nullptr;
+    const double finishSubmitUs = 1000.0 * Bench::timeMs(1, [&] {
+        shared = &overlay.finishStroke(*stroke);
+        recognizer.submitRaster(*shared);
+    });
+    const std::string sharedLabel = recognizer.popNewPrediction()->label;
+
+    StrokeRaster reference;
+    reference.extend(stroke->simplified);
+    std::size_t mismatches = 0;
+    for (int i = 0; i < kCanvas * kCanvas; ++i)
+        mismatches += reference.pixels()[i] != shared->pixels()[i];
+
+    Bench::report("stroke points", double(stroke->points.size()), "");
+    Bench::report("simplified points", double(stroke->simplified.size()), "");
+    Bench::report("frames", double(frames), "");
+    Bench::report("before: full redraw per frame (avg)", beforeUs / frames, "us");
+    Bench::report("before: full redraw, last frame", beforeLastUs, "us");
+    Bench::report("after: incremental per frame (avg)", afterUs / frames, "us");
+    Bench::report("after: incremental, last frame", afterLastUs, "us");
+    Bench::report("recognizer: redraw + classify", redrawSubmitUs, "us");
+    Bench::report("recognizer: finishStroke + classify", finishSubmitUs, "us");
+    Bench::report("raster mismatches vs simplified redraw", double(mismatches), "");
+    Bench::report("same label", redrawLabel == sharedLabel ? 1.0 : 0.0, "");
+}
@@ -0,0 +1,178 @@
+// strokeRecorderBench.cc
+// Stress: a producer thread draws one 10,000-point stroke (a point every
+// 20 us, like a high-rate tablet) while a consumer thread ticks every
+// 250 us reading the in-progress stroke, as CanvasOverlay does every
+// frame. "before" is the old recorder, a mutex-guarded vector
+// copied whole each tick (copyCurrentPoints) and popped with
+// vector::erase; "after" is StrokeRecorder's point log read by cursor.
+// Reports bytes copied per tick, time blocked on the lock on both sides
+// (before only; the point log has no lock), and checks the consumer's copy
+// ends up equal to the completed stroke. Both recorders drop points closer
+// than StrokeRecorder's dedupe distance, so they keep the same points.
+#include "bench.h"
+#include "core/strokeRecorder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <thread>
+
+namespace {
+constexpr int kPoints = 10000;
+constexpr auto kPointInterval = std::chrono::microseconds(20);
+constexpr auto kTickInterval = std::chrono::microseconds(250);
+
+using Clock = std::chrono::steady_clock;
+
+glm::vec2 strokePoint(int i) {
+    const float t = float(i) / kPoints;
+    return glm::vec2(0.5f + 0.4f * std::cos(20.0f * t), 0.5f + 0.4f * std::sin(31.0f * t));
+}
+
+void waitUntil(Clock::time_point t) {
+    while (Clock::now() < t)
+        std::this_thread::yield();
+}
+
+// The recorder's hand-off before the point log, reduced to what the
+// overlay and the app touched.
+class MutexRecorder {
+public:
+    void feed(bool pressed, const glm::vec2 &p) {
+        std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+        m_producerBlockedNs += lockTimed(lock);
+        if (pressed) {
+            // The same dedupe as StrokeRecorder, so both keep the same points
+            const glm::vec2 d = p - m_last;
+            if (!m_current.empty() && d.x * d.x + d.y * d.y < 1e-7f)
+                return;
+            m_last = p;
+            m_current.push_back(p);
+        } else if (!m_current.empty()) {
+            m_completed.push_back(std::move(m_current));
+            m_current.clear();
+        }
+    }
+    std::vector<glm::vec2> copyCurrentPoints() {
+        std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+        m_consumerBlockedNs += lockTimed(lock);
+        return m_current;
+    }
+    std::vector<glm::vec2> popCompleted() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<glm::vec2> s = std::move(m_completed.front());
+        m_completed.erase(m_completed.begin());
+        return s;
+    }
+
+    std::atomic<int64_t> m_producerBlockedNs{0}, m_consumerBlockedNs{0};
+    std::atomic<int64_t> m_contended{0};
+
+private:
+    int64_t lockTimed(std::unique_lock<std::mutex> &lock) {
+        if (lock.try_lock())
+            return 0;
+        ++m_contended;
+        const auto start = Clock::now();
+        lock.lock();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    }
+
+    std::mutex m_mutex;
+    std::vector<glm::vec2> m_current;
+    glm::vec2 m_last{0.0f};  // m_current's last point
+    std::vector<std::vector<glm::vec2>> m_completed;
+};
+
+struct Run {
+    std::size_t ticks = 0;
+    double bytesPerTick = 0.0, maxBytesPerTick = 0.0;
+    std::size_t finalPoints = 0;  // what the consumer saw last
+    std::size_t completedPoints = 0;
+};
+
+// Producer on a thread, `tick` on this one until the producer is done.
+template <class Produce, class Tick>
+Run stress(Produce produce, Tick tick) {
+    std::atomic<bool> done{false};
+    std::thread producer([&] {
+        produce();
+        done = true;
+    });
+    Run run;
+    double bytes = 0.0;
+    for (auto next = Clock::now(); !done; next += kTickInterval) {
+        waitUntil(next);
+        const std::size_t b = tick(run);
+        bytes += double(b);
+        run.maxBytesPerTick = std::max(run.maxBytesPerTick, double(b));
+        ++run.ticks;
+    }
+    producer.join();
+    run.bytesPerTick = bytes / double(std::max<std::size_t>(run.ticks, 1));
+    return run;
+}
+}  // namespace
+
+INK_BENCH(strokeRecorder) {
+    // Before: whole-stroke copy under a mutex every tick.
+    MutexRecorder before;
+    Run b = stress(
+            [&] {
+                auto t = Clock::now();
+                for (int i = 0; i < kPoints; ++i, t += kPointInterval) {
+                    waitUntil(t);
+                    before.feed(true, strokePoint(i));
+                }
+            },
+            [&](Run &run) {
+                const auto pts = before.copyCurrentPoints();
+                run.finalPoints = pts.size();
+                return pts.size() * sizeof(glm::vec2);
+            });
+    before.feed(false, glm::vec2(0.0f));
+    b.completedPoints = before.popCompleted().size();
+
+    // After: cursor reads of the point log, no lock on either side.
+    StrokeRecorder *recorder = StrokeRecorder::instance();
+    recorder->feed(false, glm::vec2(0.0f), 0.0);
+    StrokeRecorder::Cursor cursor;
+    std::vector<glm::vec2> mirror;
+    Run a = stress(
+            [&] {
+                auto t = Clock::now();
+                for (int i = 0; i < kPoints; ++i, t += kPointInterval) {
+                    waitUntil(t);
+                    recorder->feed(true, strokePoint(i), i * 20e-6);
+                }
+            },
+            [&](Run &run) {
+                const std::size_t added = recorder->readCurrentPoints(cursor, mirror);
+                run.finalPoints = mirror.size();
+                return added * sizeof(glm::vec2);
+            });
+    recorder->readCurrentPoints(cursor, mirror);  // whatever arrived after the last tick
+    a.finalPoints = mirror.size();
+    recorder->feed(false, glm::vec2(0.0f), 1.0);
+    const std::vector<glm::vec2> completed = recorder->popCompletedStroke()->points;
+    a.completedPoints = completed.size();
+    const bool mirrorMatches = mirror == completed;
+
+    Bench::report("stroke points", kPoints, "");
+    Bench::report("before: ticks", double(b.ticks), "");
+    Bench::report("before: bytes copied per tick (avg)", b.bytesPerTick, "B");
+    Bench::report("before: bytes copied per tick (max)", b.maxBytesPerTick, "B");
+    Bench::report("before: contended lock acquisitions", double(before.m_contended), "");
+    Bench::report("before: producer blocked", before.m_producerBlockedNs / 1e6, "ms");
+    Bench::report("before: consumer blocked", before.m_consumerBlockedNs / 1e6, "ms");
+    Bench::report("before: completed stroke points", double(b.completedPoints), "");
+    Bench::report("after: ticks", double(a.ticks), "");
+    Bench::report("after: bytes copied per tick (avg)", a.bytesPerTick, "B");
+    Bench::report("after: bytes copied per tick (max)", a.maxBytesPerTick, "B");
+    Bench::report("after: consumer mirror points", double(a.finalPoints), "");
+    Bench::report("after: completed stroke points", double(a.completedPoints), "");
+    Bench::check("after: mirror matches completed stroke", mirrorMatches);
+    Bench::check("before and after keep the same points", b.completedPoints == a.completedPoints);
+}
@@ -0,0 +1,143 @@
+// strokeSimplifierBench.cc
+// Recorded 1000 Hz mouse strokes (positions snapped to a 1280x720 window's
+// pixels, as GLFW reports them) through StrokeSimplifier: point counts, the
+// farthest any raw point ends up from the simplified line, how the 64x64
+// rasters differ (only Bresenham stair-steps if no pixel is >1 px off), and
+// what the consumers pay downstream - the recognizer's 64x64 raster and
+// Recognizer::submitStroke on raw vs. simplified points, plus the $1-style
+// resample.
+#include "bench.h"
+#include "core/drawing.h"
+#include "core/recognizer.h"
+#include "core/strokeSimplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace {
+constexpr float kWindowW = 1280.0f, kWindowH = 720.0f;
+constexpr int kCanvas = 64;
+
+template <class Path>
+std::vector<glm::vec2> record(Path path, double seconds) {
+    std::vector<glm::vec2> points;
+    const int samples = static_cast<int>(seconds * 1000.0);
+    for (int i = 0; i <= samples; ++i) {
+        const glm::vec2 p = path(static_cast<float>(i) / samples);
+        const glm::vec2 snapped(std::round(p.x * kWindowW) / kWindowW,
+                                std::round(p.y * kWindowH) / kWindowH);
+        if (points.empty() || points.back() != snapped)  // the recorder dedupes these
+            points.push_back(snapped);
+    }
+    return points;
+}
+
+float distanceToSegment(const glm::vec2 &p, const glm::vec2 &a, const glm::vec2 &b) {
+    const glm::vec2 ab = b - a;
+    const float len2 = glm::dot(ab, ab);
+    const float t = len2 > 0.0f ? glm::clamp(glm::dot(p - a, ab) / len2, 0.0f, 1.0f) : 0.0f;
+    return glm::length(p - (a + t * ab));
+}
+
+float maxDeviation(const std::vector<glm::vec2> &raw, const std::vector<glm::vec2> &simple) {
+    float worst = 0.0f;
+    for (const glm::vec2 &p: raw) {
+        float best = glm::length(p - simple.front());
+        for (std::size_t i = 1; i < simple.size(); ++i)
+            best = std::min(best, distanceToSegment(p, simple[i - 1], simple[i]));
+        worst = std::max(worst, best);
+    }
+    return worst;
+}
+
+// The recognizer's raster: 1 px radius lines on a 64x64 gray canvas.
+void rasterize(const std::vector<glm::vec2> &points, std::vector<unsigned char> &pixels) {
+    pixels.assign(kCanvas * kCanvas, 0);
+    Raster::ImageGray img{pixels.data(), kCanvas, kCanvas};
+    auto toCanvas = [](const glm::vec2 &p) {
+        return glm::ivec2(glm::clamp(p, 0.0f, 1.0f) * float(kCanvas - 1) + 0.5f);
+    };
+    glm::ivec2 a = toCanvas(points.front());
+    Raster::drawDisc(img, a.x, a.y, 1, 255);
+    for (std::size_t i = 1; i < points.size(); ++i) {
+        const glm::ivec2 b = toCanvas(points[i]);
+        Raster::drawLine(img, a.x, a.y, b.x, b.y, 1, 255);
+        a = b;
+    }
+}
+
+// Any lit pixel in the 3x3 block around (x, y).
+bool nearLit(const std::vector<unsigned char> &pixels, int x, int y) {
+    for (int dy = -1; dy <= 1; ++dy)
+        for (int dx = -1; dx <= 1; ++dx) {
+            const int nx = x + dx, ny = y + dy;
+            if (nx >= 0 && ny >= 0 && nx < kCanvas && ny < kCanvas && pixels[ny * kCanvas + nx])
+                return true;
+        }
+    return false;
+}
+}  // namespace
+
+INK_BENCH(strokeSimplifier) {
+    struct Recorded {
+        const char *name;
+        std::vector<glm::vec2> points;
+    };
+    const Recorded strokes[] = {
+            {"line 1s", record([](float t) { return glm::vec2(0.2f + 0.6f * t, 0.3f + 0.2f * t); },
+                               1.0)},
+            {"circle 2s", record([](float t) {
+                 const float a = 6.2832f * t;
+                 return glm::vec2(0.5f + 0.2f * std::cos(a), 0.5f + 0.3f * std::sin(a));
+             }, 2.0)},
+            {"scribble 5s", record([](float t) {
+                 return glm::vec2(0.15f + 0.7f * t + 0.05f * std::cos(60.0f * t),
+                                  0.5f + 0.25f * std::sin(9.0f * t) + 0.05f * std::sin(60.0f * t));
+             }, 5.0)},
+    };
+
+    std::vector<unsigned char> rawPixels, simplePixels;
+    std::vector<glm::vec2> resampled;
+    for (const Recorded &stroke: strokes) {
+        const std::string name = stroke.name;
+        std::vector<glm::vec2> simple;
+        const double simplifyMs =
+                Bench::timeMs(50, [&] { simple = StrokeSimplifier::simplify(stroke.points); });
+
+        rasterize(stroke.points, rawPixels);
+        rasterize(simple, simplePixels);
+        std::size_t pixelDiff = 0, farPixels = 0;
+        for (std::size_t i = 0; i < rawPixels.size(); ++i) {
+            pixelDiff += rawPixels[i] != simplePixels[i];
+            farPixels += simplePixels[i] && !nearLit(rawPixels, int(i % kCanvas), int(i / kCanvas));
+            farPixels += rawPixels[i] && !nearLit(simplePixels, int(i % kCanvas), int(i / kCanvas));
+        }
+
+        const double rawRasterMs = Bench::timeMs(200, [&] { rasterize(stroke.points, rawPixels); });
+        const double simpleRasterMs = Bench::timeMs(200, [&] { rasterize(simple, simplePixels); });
+        Recognizer *recognizer = Recognizer::instance();
+        const double rawSubmitMs =
+                Bench::timeMs(200, [&] { recognizer->submitStroke(stroke.points); });
+        const double simpleSubmitMs = Bench::timeMs(200, [&] { recognizer->submitStroke(simple); });
+
+        StrokeSimplifier online;
+        online.add(stroke.points);
+        const double resampleMs = Bench::timeMs(200, [&] { online.resample(64, resampled); });
+
+        Bench::report(name + ": raw points", double(stroke.points.size()), "");
+        Bench::report(name + ": simplified points", double(simple.size()), "");
+        Bench::report(name + ": simplify per point",
+                      simplifyMs * 1e6 / double(stroke.points.size()), "ns");
+        Bench::report(name + ": max deviation (tolerance " +
+                              std::to_string(StrokeSimplifier::kDefaultTolerance) + ")",
+                      maxDeviation(stroke.points, simple), "");
+        Bench::report(name + ": 64x64 raster pixels changed", double(pixelDiff), "");
+        Bench::report(name + ": raster pixels >1 px off", double(farPixels), "");
+        Bench::report(name + ": raster raw", rawRasterMs * 1000.0, "us");
+        Bench::report(name + ": raster simplified", simpleRasterMs * 1000.0, "us");
+        Bench::report(name + ": submitStroke raw", rawSubmitMs * 1000.0, "us");
+        Bench::report(name + ": submitStroke simplified", simpleSubmitMs * 1000.0, "us");
+        Bench::report(name + ": resample to 64", resampleMs * 1000.0, "us");
+    }
+}
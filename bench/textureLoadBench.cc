@@ -0,0 +1,72 @@
+// textureLoadBench.cc
+// Cost to the calling (render) thread of loading 16 of the game's PNG
+// textures. "sync" decodes each on the caller the way loadTexture() does;
+// "async" hands them to a TextureLoader and pumps upload() once per
+// simulated frame. Uses the null backend, so GL upload time is not included
+// in either row; the decode it takes off the frame is.
+#include "bench.h"
+#include "renderer/textureLoader.h"
+
+#include <algorithm>
+#include <stb_image.h>
+#include <thread>
+
+namespace {
+constexpr int kTextures = 16;
+const char *const kFiles[] = {"default_brick.png", "mossy_brick.png"};
+
+std::string texturePath(int i) {
+    return std::string(SHADER_DIR) + "../textures/" + kFiles[i % 2];
+}
+}  // namespace
+
+INK_BENCH(textureLoad) {
+    // Sync: every load is a frame stall.
+    double syncTotal = 0.0, syncWorst = 0.0;
+    for (int i = 0; i < kTextures; ++i) {
+        const double ms = Bench::timeMs(1, [&] {
+            int w = 0, h = 0, channels = 0;
+            stbi_image_free(stbi_load(texturePath(i).c_str(), &w, &h, &channels, 4));
+        });
+        syncTotal += ms;
+        syncWorst = std::max(syncWorst, ms);
+    }
+
+    // Async: request everything in one frame, then keep drawing frames.
+    auto backend = std::make_shared<NullRenderBackend>();
+    TextureLoadStats stats;
+    double requestMs = 0.0, worstFrame = 0.0, untilLoaded = 0.0;
+    int frames = 0;
+    {
+        TextureLoader loader(backend, TextureLoader::Settings{2, 4u << 20});
+        std::vector<std::shared_ptr<Texture>> textures;
+        untilLoaded = Bench::timeMs(1, [&] {
+            requestMs = Bench::timeMs(1, [&] {
+                for (int i = 0; i < kTextures; ++i)
+                    textures.push_back(loader.load(texturePath(i)));
+            });
+            while (!loader.idle()) {
+                worstFrame = std::max(worstFrame, Bench::timeMs(1, [&] { loader.upload(); }));
+                ++frames;
+                std::this_thread::sleep_for(std::chrono::microseconds(16667));
+            }
+        });
+        stats = loader.stats();
+        for (const auto &t: textures) {
+            if (t->m_pending)
+                ++stats.failed;  // would show as a placeholder forever
+        }
+    }
+
+    Bench::report("sync: total on caller", syncTotal, "ms");
+    Bench::report("sync: worst single load", syncWorst, "ms");
+    Bench::report("async: load() calls on caller", requestMs, "ms");
+    Bench::report("async: worst upload() frame", worstFrame, "ms");
+    Bench::report("async: frames until all loaded", double(frames), "");
+    Bench::report("async: wall time until all loaded", untilLoaded, "ms");
+    Bench::report("async: decode time (all threads)", stats.decodeMs, "ms");
+    Bench::report("async: max decode", stats.maxDecodeMs, "ms");
+    Bench::report("async: bytes uploaded", double(stats.uploadBytes), "B");
+    Bench::report("async: loaded", double(stats.loaded), "");
+    Bench::report("async: failed or still pending", double(stats.failed), "");
+}
@@ -0,0 +1,137 @@
+// tinyCnnBench.cc
+// A 28x28 stroke classifier of the size docs/drawing_recognition_plan.md
+// plans (conv 8 -> pool -> conv 16 -> pool -> dense 64 -> dense 10 ->
+// softmax) with fixed pseudo-random weights. Saves it (float and int8),
+// loads it back, and checks every SIMD level against reference outputs
+// stored in tinyCnnReference.h, which tools/cnn_export computed from the
+// saved files in double precision; an output further than kTolerance from
+// its reference fails the run. Then reports inferences per second per
+// level and weight type, and heap allocations across the timed forwards.
+#include "bench.h"
+#include "core/tinyCnn.h"
+#include "tinyCnnReference.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+
+namespace {
+constexpr int kSize = 28;
+constexpr int kClasses = 10;
+constexpr int kInferences = 2000;
+// Largest difference from the reference any output may show. The outputs
+// are softmax probabilities and float rounding accounts for about 1e-7, so
+// this only trips on a broken kernel.
+constexpr double kTolerance = 1e-5;
+
+// Uniform in [-limit, limit] from the raw mt19937 stream, which (unlike
+// the std distributions) is the same on every standard library.
+std::vector<float> randomWeights(std::mt19937 &rng, std::size_t count, int fanIn) {
+    const float limit = std::sqrt(6.0f / float(fanIn));
+    std::vector<float> w(count);
+    for (float &v: w)
+        v = (float(rng() >> 8) / float(1 << 24) * 2.0f - 1.0f) * limit;
+    return w;
+}
+
+TinyCnn makeNet() {
+    std::mt19937 rng(2024);
+    TinyCnn net(TinyCnn::Shape{1, kSize, kSize});
+    net.addConv2d(8, 3, 1, randomWeights(rng, 8 * 9, 9), randomWeights(rng, 8, 9));
+    net.addRelu();
+    net.addMaxPool(2);
+    net.addConv2d(16, 3, 1, randomWeights(rng, 16 * 8 * 9, 72), randomWeights(rng, 16, 72));
+    net.addRelu();
+    net.addMaxPool(2);
+    net.addDense(64, randomWeights(rng, 64 * 16 * 7 * 7, 784), randomWeights(rng, 64, 784));
+    net.addRelu();
+    net.addDense(kClasses, randomWeights(rng, kClasses * 64, 64),
+                 randomWeights(rng, kClasses, 64));
+    net.addSoftmax();
+    net.setLabels({"dot", "horizontal", "vertical", "curve", "circle", "square", "triangle",
+                   "zigzag", "arrow", "spiral"});
+    return net;
+}
+
+// Input n of kReferenceInputs: a repeating ramp, so every pixel differs.
+void fillInput(float *input, int n) {
+    for (int i = 0; i < kSize * kSize; ++i)
+        input[i] = float((i * (2 * n + 3) + n) % 17) / 16.0f;
+}
+
+// Largest |output - reference| over the reference inputs.
+double maxError(TinyCnn &net, const float (&reference)[kReferenceInputs][kClasses],
+                SimdLevel level) {
+    double worst = 0.0;
+    for (int n = 0; n < kReferenceInputs; ++n) {
+        fillInput(net.input(), n);
+        const float *out = net.forward(level);
+        for (int c = 0; c < kClasses; ++c)
+            worst = std::max(worst, std::abs(double(out[c]) - reference[n][c]));
+    }
+    return worst;
+}
+}  // namespace
+
+INK_BENCH(tinyCnn) {
+    const auto dir = std::filesystem::temp_directory_path();
+    const std::string floatPath = (dir / "inkTinyCnnBench.inkn").string();
+    const std::string int8Path = (dir / "inkTinyCnnBench_int8.inkn").string();
+
+    // The reference inputs too, for regenerating tinyCnnReference.h.
+    std::vector<float> inputs(kReferenceInputs * kSize * kSize);
+    for (int n = 0; n < kReferenceInputs; ++n)
+        fillInput(inputs.data() + n * kSize * kSize, n);
+    std::ofstream((dir / "inkTinyCnnBench_inputs.f32").string(), std::ios::binary)
+            .write(reinterpret_cast<const char *>(inputs.data()),
+                   static_cast<std::streamsize>(inputs.size() * sizeof(float)));
+
+    TinyCnn built = makeNet();
+    TinyCnn floatNet, int8Net;
+    built.save(floatPath);
+    built.quantize();
+    built.save(int8Path);
+    if (!Bench::check("saved nets load back", floatNet.load(floatPath) && int8Net.load(int8Path)))
+        return;
+    std::printf("  %zu layers, %zu KB float / %zu KB int8 weights, %zu KB arena\n",
+                floatNet.layerCount(), floatNet.weightBytes() / 1024,
+                int8Net.weightBytes() / 1024, floatNet.arenaBytes() / 1024);
+
+    for (SimdLevel level:
+         {SimdLevel::scalar, SimdLevel::sse2, SimdLevel::avx2, SimdLevel::neon}) {
+        if (!simdLevelSupported(level))
+            continue;
+        const std::string name = simdLevelName(level);
+        const double floatError = maxError(floatNet, kReferenceFloat, level);
+        const double int8Error = maxError(int8Net, kReferenceInt8, level);
+        Bench::report(name + " float max error", 1e6 * floatError, "x1e-6");
+        Bench::report(name + " int8 max error", 1e6 * int8Error, "x1e-6");
+        Bench::check(name + " float matches reference", floatError <= kTolerance);
+        Bench::check(name + " int8 matches reference", int8Error <= kTolerance);
+
+        for (TinyCnn *net: {&floatNet, &int8Net}) {
+            fillInput(net->input(), 0);
+            const std::size_t before = Bench::allocations();
+            const double ms = Bench::timeMs(kInferences, [&] { net->forward(level); });
+            const std::size_t allocations = Bench::allocations() - before;
+            const std::string type = net == &floatNet ? " float" : " int8";
+            Bench::report(name + type + " inferences/s", 1000.0 / ms, "");
+            Bench::report(name + type + " allocations", double(allocations), "");
+        }
+    }
+
+    // Top class of the int8 net against the float one, on the reference inputs.
+    int agree = 0;
+    for (int n = 0; n < kReferenceInputs; ++n) {
+        fillInput(floatNet.input(), n);
+        const float *f = floatNet.forward();
+        const int fBest = int(std::max_element(f, f + kClasses) - f);
+        fillInput(int8Net.input(), n);
+        const float *q = int8Net.forward();
+        agree += int(std::max_element(q, q + kClasses) - q) == fBest;
+    }
+    Bench::report("int8 top class agrees with float", double(agree) / kReferenceInputs, "");
+}
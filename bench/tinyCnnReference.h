@@ -0,0 +1,48 @@
+// tinyCnnReference.h
+// Outputs of tinyCnnBench's net (makeNet) for its kReferenceInputs inputs,
+// computed in double precision by tools/cnn_export independently of the C++
+// kernels. After changing makeNet or fillInput, run InkBench tinyCnn once
+// (it writes the nets and inputs to the temp directory), then
+//   cnn_export.py reference $TMP/inkTinyCnnBench.inkn $TMP/inkTinyCnnBench_inputs.f32
+// and the same for inkTinyCnnBench_int8.inkn, and paste the rows below.
+#pragma once
+
+constexpr int kReferenceInputs = 8;
+
+constexpr float kReferenceFloat[kReferenceInputs][10] = {
+    {7.480696837e-02f, 1.668971068e-01f, 4.648175133e-02f, 1.429294269e-01f, 7.536953186e-02f,
+     8.601835376e-02f, 7.053688367e-02f, 4.592503204e-02f, 7.611562458e-02f, 2.149193207e-01f},
+    {7.527668219e-02f, 1.312848168e-01f, 5.792081646e-02f, 1.731708335e-01f, 7.266419684e-02f,
+     1.090998400e-01f, 9.328404904e-02f, 3.410877639e-02f, 6.978604119e-02f, 1.834039476e-01f},
+    {9.839442466e-02f, 1.440669347e-01f, 3.897783196e-02f, 1.059558721e-01f, 8.386875072e-02f,
+     1.606598862e-01f, 7.709509384e-02f, 2.926847235e-02f, 7.162564830e-02f, 1.900870851e-01f},
+    {1.166178635e-01f, 1.430471178e-01f, 5.473498234e-02f, 8.939168381e-02f, 7.881774557e-02f,
+     1.627658772e-01f, 5.946991428e-02f, 3.236713142e-02f, 1.022831070e-01f, 1.605045772e-01f},
+    {1.194528966e-01f, 2.073390027e-01f, 4.371173000e-02f, 1.225835132e-01f, 7.074938757e-02f,
+     1.038318552e-01f, 4.279778662e-02f, 3.352075206e-02f, 8.506910116e-02f, 1.709439749e-01f},
+    {5.765739248e-02f, 1.131203792e-01f, 5.973488276e-02f, 1.492033779e-01f, 4.625035472e-02f,
+     1.534454702e-01f, 9.183457543e-02f, 3.803929344e-02f, 6.376716498e-02f, 2.269471089e-01f},
+    {8.936156818e-02f, 1.469932583e-01f, 4.884659483e-02f, 1.318800035e-01f, 3.739850345e-02f,
+     9.042807902e-02f, 7.204152805e-02f, 2.730874486e-02f, 7.394390950e-02f, 2.817978104e-01f},
+    {7.745192409e-02f, 1.247014459e-01f, 5.999192767e-02f, 1.413957230e-01f, 1.175685575e-01f,
+     1.251975905e-01f, 9.095646525e-02f, 5.699031751e-02f, 7.268408432e-02f, 1.330619643e-01f},
+};
+
+constexpr float kReferenceInt8[kReferenceInputs][10] = {
+    {7.452259795e-02f, 1.655087508e-01f, 4.661963535e-02f, 1.439540245e-01f, 7.576227239e-02f,
+     8.647441456e-02f, 7.032780789e-02f, 4.615850433e-02f, 7.535281467e-02f, 2.153191776e-01f},
+    {7.508617599e-02f, 1.308607136e-01f, 5.848323084e-02f, 1.722982005e-01f, 7.330121569e-02f,
+     1.104377197e-01f, 9.227800212e-02f, 3.391827330e-02f, 6.979956716e-02f, 1.835369011e-01f},
+    {9.660454570e-02f, 1.437054470e-01f, 3.933976182e-02f, 1.063597109e-01f, 8.511880337e-02f,
+     1.624353805e-01f, 7.633321501e-02f, 2.918141753e-02f, 7.077229880e-02f, 1.901494193e-01f},
+    {1.155018590e-01f, 1.424031155e-01f, 5.558801350e-02f, 8.956184992e-02f, 7.982826506e-02f,
+     1.636469016e-01f, 5.911196940e-02f, 3.225051087e-02f, 1.018575216e-01f, 1.602499935e-01f},
+    {1.187195620e-01f, 2.059828822e-01f, 4.420148975e-02f, 1.231864877e-01f, 7.154256555e-02f,
+     1.044173041e-01f, 4.257328560e-02f, 3.360476433e-02f, 8.467082686e-02f, 1.711008319e-01f},
+    {5.717432228e-02f, 1.125896934e-01f, 6.033332288e-02f, 1.489501085e-01f, 4.671068455e-02f,
+     1.544691560e-01f, 9.107688022e-02f, 3.801978416e-02f, 6.341561342e-02f, 2.272604345e-01f},
+    {8.866693198e-02f, 1.460224752e-01f, 4.942137966e-02f, 1.323398328e-01f, 3.779482600e-02f,
+     9.050814437e-02f, 7.209379908e-02f, 2.731569120e-02f, 7.340080688e-02f, 2.824361128e-01f},
+    {7.715882162e-02f, 1.247443136e-01f, 6.004987219e-02f, 1.410304488e-01f, 1.176202352e-01f,
+     1.257520459e-01f, 9.082246479e-02f, 5.726045963e-02f, 7.276211163e-02f, 1.327992268e-01f},
+};
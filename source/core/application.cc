@@ -10,58 +10,36 @@
 #include <glad/glad.h>
 #include <iostream>
 #include <renderer/buffers.h>
+#include <renderer/glRenderBackend.h>
+#include <renderer/renderer.h>
+#include <renderer/resourceCache.h>
 #include <renderer/shader.h>
 #include <stdexcept>
 #include <thread>
 #include <atomic>
 #include <algorithm>
-#include <condition_variable>
+#include "drawnPlatform.h"
+#include "levelStreamer.h"
 #include "strokeRecorder.h"
 #include "recognizer.h"
+#include "profiler.h"
 
 Application *Application::s_instance = nullptr;
 Renderer *Renderer::s_instance = nullptr;
 
 namespace {
-struct StrokeBounds {
-    glm::vec2 min;
-    glm::vec2 max;
-};
-
-StrokeBounds boundsFromPoints(const std::vector<glm::vec2>& points) {
-    StrokeBounds bounds{points.front(), points.front()};
-    for (const auto& p : points) {
-        bounds.min.x = std::min(bounds.min.x, p.x);
-        bounds.min.y = std::min(bounds.min.y, p.y);
-        bounds.max.x = std::max(bounds.max.x, p.x);
-        bounds.max.y = std::max(bounds.max.y, p.y);
-    }
-    return bounds;
-}
-
-glm::vec2 normalizedToView(const glm::vec2& n) {
-    constexpr float kLeft = -2.0f;
-    constexpr float kRight = 2.0f;
-    constexpr float kBottom = -1.5f;
-    constexpr float kTop = 1.5f;
-    const float x = kLeft + n.x * (kRight - kLeft);
-    const float y = kTop - n.y * (kTop - kBottom);
-    return {x, y};
-}
-
-StrokeBounds expandBoundsForMinSize(const std::vector<glm::vec2>& points, float minSize) {
-    StrokeBounds bounds = boundsFromPoints(points);
-    const glm::vec2 center = (bounds.min + bounds.max) * 0.5f;
-    const float w = std::max(bounds.max.x - bounds.min.x, minSize);
-    const float h = std::max(bounds.max.y - bounds.min.y, minSize);
-
-    bounds.min = center - glm::vec2(w * 0.5f, h * 0.5f);
-    bounds.max = center + glm::vec2(w * 0.5f, h * 0.5f);
-
-    bounds.min = glm::clamp(bounds.min, glm::vec2(0.0f), glm::vec2(1.0f));
-    bounds.max = glm::clamp(bounds.max, glm::vec2(0.0f), glm::vec2(1.0f));
-    return bounds;
-}
+// Texture for platforms drawn with the canvas.
+constexpr const char *kDrawnPlatformTexture = "mossy_brick";
+
+constexpr const char *kLevelFile = "assets/levels/test2.json";
+// Cooked levels stream their stationary platforms in chunks of this size.
+constexpr float kChunkSize = 16.0f;
+// Textures streamed chunks need, loaded per frame at most.
+constexpr std::size_t kTextureLoadsPerFrame = 2;
+
+// Orthographic view: half width/height in world units.
+constexpr float kViewScale = 2.0f;  // increase to zoom out
+const glm::vec2 kViewHalfExtents(2.0f * kViewScale, 1.5f * kViewScale);
 }  // namespace
 
 void framebufferSizeCallback(GLFWwindow *window, int w, int h) {
@@ -108,32 +86,62 @@ Application::Application() {
 
     // Now we can install the resize callback
     glfwSetFramebufferSizeCallback(window, framebufferSizeCallback);
+    // Strokes sample every cursor event, not once per frame
+    StrokeRecorder::instance()->attach(window);
 
     glClearColor(0.589f, 0.443f, 0.09f, 1.f);
     std::cout << "[application] Clear color set.\n";
 
     entityManager = EntityManager::instance();
+    jobSystem = std::make_unique<JobSystem>();
+    entityManager->setJobSystem(jobSystem.get());
+    std::cout << "[application] Job system: " << jobSystem->workerCount() << " workers.\n";
+    m_recognizer = std::make_unique<RecognizerService>();
     textureManager = TextureManager::instance();
+    textureManager->setBackend(std::make_shared<GlRenderBackend>());
     std::cout << "[App] textureManager = " << textureManager.get() << std::endl;
-    player = loadLevelFromFile("assets/levels/test2.json", textureManager, entityManager);
+    // A cooked level streams its stationary platforms around the player;
+    // everything else (and JSON levels) is loaded up front.
+    const std::string cooked = freshCookedLevel(kLevelFile);
+    auto chunks = cooked.empty() ? nullptr : CookedChunkSource::open(cooked, kChunkSize);
+    if (chunks) {
+        player = loadCookedLevel(cooked, textureManager, entityManager, false);
+        m_streamer = std::make_unique<LevelStreamer>(std::move(chunks), *entityManager);
+        if (player) {
+            m_streamer->loadNow(glm::vec2(player->position()), kViewHalfExtents, *textureManager);
+        }
+    } else {
+        player = loadLevel(kLevelFile, textureManager, entityManager);
+    }
+    if (!textureManager->hasTexture(kDrawnPlatformTexture)) {
+        textureManager->loadTextureAsync(
+                kDrawnPlatformTexture, std::string("assets/textures/") + kDrawnPlatformTexture + ".png");
+    }
 
     std::cout << "[application] Platforms created.\n";
 }
 
 Application::~Application() {
+    entityManager->setJobSystem(nullptr);  // the manager outlives our workers
+    const RecognizerService::Stats stats = m_recognizer->stats();
+    std::cout << "[application] Recognized " << stats.symbols << " symbols from "
+              << stats.strokes << " strokes in " << stats.batches << " batches, "
+              << stats.matched << " by the fast path (" << stats.symbolsPerSecond()
+              << " symbols/s classifying)\n";
     std::cout << "[application] Terminating GLFW...\n";
     glfwDestroyWindow(window);
     glfwTerminate();
 }
 
-std::condition_variable cv;
-std::atomic<bool> updated{false};
 std::atomic<bool> running{true};
 
 void Application::updateThread() {
     const float fixedDt = 1.f / 60.f;
     float accumulator = 0.0f;
     double lastTime = glfwGetTime();
+    double simTime = lastTime;  // wall-clock time the last tick ended at
+    uint64_t tick = 0;
+    INK_PROFILE_THREAD("update");
 
     while (running) {
         double now = glfwGetTime();
@@ -142,113 +150,212 @@ void Application::updateThread() {
         accumulator += frameT;
 
         while (accumulator >= fixedDt) {
-            {
-                std::lock_guard<std::mutex> lock(m_mutex);
-                entityManager->update(fixedDt);
+            INK_PROFILE_SCOPE("update tick");
+            RenderSnapshot &snapshot = m_snapshots.writeSlot();
+            drainCommands();
+            if (m_streamer) {
+                m_streamer->update(glm::vec2(player->position()), kViewHalfExtents);
             }
+            entityManager->update(fixedDt);
+            entityManager->buildRenderSnapshot(snapshot);
+            snapshot.focus = player->position();
 
             accumulator -= fixedDt;
-            updated = true;
-            cv.notify_one();
+            simTime += fixedDt;
+            snapshot.tick = ++tick;
+            snapshot.time = simTime;
+#if INK_PROFILE
+            // Stats dumps come with the profiler build, next to its summary
+            if (m_streamer && tick % 600 == 0) {
+                const LevelStreamer::Stats &st = m_streamer->stats();
+                std::cout << "[levelStreamer] " << st.residentChunks << " chunks ("
+                          << st.residentSprites << " sprites) resident, " << st.inFlightChunks
+                          << " in flight, " << st.chunksLoaded << " loaded / "
+                          << st.chunksEvicted << " evicted so far\n";
+            }
+            if (m_spawnStats.spawned > 0 && tick % 600 == 0) {
+                std::cout << "[application] " << m_spawnStats.spawned
+                          << " drawn platforms spawned, request to spawn avg "
+                          << m_spawnStats.totalMs / m_spawnStats.spawned << " ms / max "
+                          << m_spawnStats.maxMs << " ms\n";
+            }
+#endif
+            m_snapshots.publish();  // every tick, so the renderer can lerp between neighbours
         }
         std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
 }
 
+void Application::drainCommands() {
+    while (auto command = m_commands.pop()) {
+        if (command->kind == SimCommand::Kind::keys) {
+            player->applyInput(command->keys.moveX, command->keys.jumpHeld);
+            continue;
+        }
+        INK_PROFILE_SCOPE("drawn platform spawn");
+        entityManager->add<Platform>(PlatformType::stationary, command->texture,
+            command->placed.position, 0.0f, command->placed.size, true);
+        const double ms = (glfwGetTime() - command->requested) * 1000.0;
+        ++m_spawnStats.spawned;
+        m_spawnStats.totalMs += ms;
+        m_spawnStats.maxMs = std::max(m_spawnStats.maxMs, ms);
+    }
+}
+
 void Application::run() {
     // target fixed physics step: 1/60th of a second
     // see https://gafferongames.com/post/fix_your_timestep/
     const float fixedDt = 1.0f / 60.0f;
-    float accumulator = 0.0f;
 
     auto renderer = Renderer::getInstance();
+    INK_PROFILE_THREAD("render");
+
+    // The overlay draws and uploads its canvas on this (GL) thread, where the
+    // recognizer reuses its raster
+    std::shared_ptr<CanvasOverlay> overlay;
+    for (const auto &entity: entityManager->getEntities()) {
+        if (auto o = std::dynamic_pointer_cast<CanvasOverlay>(entity))
+            overlay = o;
+    }
 
     std::thread updater(&Application::updateThread, this);
 
-    {
-        std::unique_lock<std::mutex> lock(m_mutex);
-        cv.wait(lock, [] {
-            return updated.load();
-        });
-        updated = false;
-    }
-
-    double lastTime = glfwGetTime();
+#if INK_PROFILE
+    uint64_t frame = 0;
+#endif
+    Character::KeyInput keysSent;  // last movement keys the updater was given
+    uint64_t liveVersion = 0;  // overlay version last sent to the recognizer
+    std::string liveLabel;     // its last live guess, logged when it changes
     while (!glfwWindowShouldClose(window)) {
-        player->handleKeyInput();
+        // Newest finished tick, never blocks. Until the first one arrives
+        // there is nothing to draw yet.
+        m_snapshots.acquire();
+        const RenderSnapshot *latest = m_snapshots.latest();
+        const RenderSnapshot *previous = m_snapshots.previous();
+
+        // Accumulator alpha: how far the sim clock has run past the latest tick.
+        // Frames draw between the previous and latest tick (one tick behind),
+        // so motion stays smooth at any display rate.
+        float alpha = 1.0f;
+        if (latest) {
+            alpha = static_cast<float>((glfwGetTime() - latest->time) / fixedDt);
+            alpha = glm::clamp(alpha, 0.0f, 1.0f);
+        }
+        glm::vec3 playerPos = latest ? latest->focus : glm::vec3(0.0f);
+        if (latest && previous) {
+            playerPos = glm::mix(previous->focus, latest->focus, alpha);
+        }
+
+        // The updater applies key changes at its next tick; on a full queue
+        // the change is sent again next frame.
+        const Character::KeyInput keys = Character::readKeyInput();
+        if (keys != keysSent) {
+            SimCommand command;
+            command.keys = keys;
+            if (m_commands.push(std::move(command)))
+                keysSent = keys;
+        }
         player->handleMouseInput();
-        // M1: capture stroke points between LMB down/up
-        StrokeRecorder::instance()->poll();
+        // M1: capture stroke points between LMB down/up (a no-op while the
+        // recorder is attached; its callbacks ran in the last glfwPollEvents)
+        {
+            INK_PROFILE_SCOPE("stroke poll");
+            StrokeRecorder::instance()->poll();
+        }
         // Debug: log completed strokes count and size
         while (StrokeRecorder::instance()->hasCompletedStroke()) {
             auto s = StrokeRecorder::instance()->popCompletedStroke();
             if (s && !s->points.empty()) {
-                std::cout << "[stroke] completed with " << s->points.size() << " points" << std::endl;
-                // Submit to recognizer; log prediction only when one has been made
-                Recognizer::instance()->submitStroke(s->points);
-                if (auto pred = Recognizer::instance()->popNewPrediction()) {
-                    std::cout << "[recognizer] label=" << pred->label
-                              << ", conf=" << pred->confidence << std::endl;
-                }
+                std::cout << "[stroke] completed with " << s->points.size() << " points ("
+                          << s->simplified.size() << " simplified)" << std::endl;
+                // Hand to the recognizer thread; the prediction arrives below
                 {
-                    const std::string textureName = "mossy_brick";
-                    if (!textureManager->hasTexture(textureName)) {
-                        textureManager->loadTexture(textureName, "assets/textures/" + textureName + ".png");
+                    INK_PROFILE_SCOPE("recognizer submit");
+                    if (overlay) {
+                        m_recognizer->submitFinal(overlay->finishStroke(*s), s->simplified);
+                    } else {
+                        StrokeRaster raster;
+                        raster.extend(s->simplified);
+                        m_recognizer->submitFinal(raster, s->simplified);
                     }
-                    auto texPtr = textureManager->getTexture(textureName);
+                }
+                {
+                    // Preloaded in the constructor, so spawning does no file I/O
+                    auto texPtr = textureManager->getTexture(kDrawnPlatformTexture);
+                    // The updater owns the entity list and broadphase; it spawns
+                    // the platform at the start of its next tick.
                     if (texPtr) {
-                        constexpr float kMinStrokeSize = 0.03f;
-                        const auto bounds = expandBoundsForMinSize(s->points, kMinStrokeSize);
-                        const glm::vec2 vmin = normalizedToView(bounds.min);
-                        const glm::vec2 vmax = normalizedToView(bounds.max);
-                        const glm::vec2 size = glm::abs(vmax - vmin);
-                        const glm::vec2 centerView = (vmin + vmax) * 0.5f;
-                        const glm::vec2 centerWorld = centerView + glm::vec2(player->position.x, player->position.y);
-                        entityManager->add<Platform>(PlatformType::stationary, texPtr,
-                            glm::vec3(centerWorld, 0.0f), 0.0f, size, true);
+                        SimCommand command;
+                        command.kind = SimCommand::Kind::spawnPlatform;
+                        // Where the stroke was on screen: the camera this
+                        // frame draws with, not the latest tick's
+                        command.placed = placeDrawnPlatform(s->simplified, playerPos);
+                        command.texture = std::move(texPtr);
+                        command.requested = glfwGetTime();
+                        if (!m_commands.push(std::move(command)))
+                            std::cerr << "[application] Command queue full, platform dropped\n";
                     }
                 }
             }
         }
 
-        // 1. measure real elapsed time
-        {
-            std::unique_lock<std::mutex> lock(m_mutex);
-            cv.wait(lock, [] {
-                return updated.load();
-            });
-            updated = false;
+        // Predictions: a provisional one per finished stroke, a final one per
+        // symbol once no more strokes can join it, and live guesses while drawing
+        while (auto result = m_recognizer->poll()) {
+            const Recognizer::Prediction &pred = result->prediction;
+            if (result->final || result->provisional) {
+                const double ms = std::chrono::duration<double, std::milli>(
+                        RecognizerService::Clock::now() - result->submitted).count();
+                std::cout << "[recognizer] " << (result->final ? "label=" : "so far: label=")
+                          << pred.label << ", conf=" << pred.confidence << " ("
+                          << result->strokes << " stroke(s), " << ms << " ms after release"
+                          << (result->matched ? ", fast path)" : ")") << std::endl;
+                liveLabel.clear();
+            } else if (pred.label != liveLabel) {
+                std::cout << "[recognizer] drawing: label=" << pred.label
+                          << ", conf=" << pred.confidence << std::endl;
+                liveLabel = pred.label;
+            }
         }
 
-        glm::vec3 playerPos = player->position;  // You already have a way to track this
         glm::vec3 cameraOffset = glm::vec3(0.0f, 0.0f, 2.0f);
 
         // View: move the world *opposite* of the player's position
         glm::mat4 view = glm::translate(glm::mat4(1.0f), -(playerPos + cameraOffset));
 
         // Projection: basic perspective or orthographic
-        constexpr float kViewScale = 2.0f;  // increase to zoom out
-        glm::mat4 projection = glm::ortho(-2.0f * kViewScale, 2.0f * kViewScale,
-                                          -1.5f * kViewScale, 1.5f * kViewScale,
+        glm::mat4 projection = glm::ortho(-kViewHalfExtents.x, kViewHalfExtents.x,
+                                          -kViewHalfExtents.y, kViewHalfExtents.y,
                                           0.1f, 100.0f);
 
         // You can also use glm::perspective for 3D view, e.g.:
         // glm::mat4 projection = glm::perspective(glm::radians(45.0f), (float)width/height, 0.1f,
         // 100.0f);
 
+        if (m_streamer) {
+            INK_PROFILE_SCOPE("level textures");
+            m_streamer->uploadTextures(*textureManager, kTextureLoadsPerFrame);
+        }
+        // Decoded off-thread; only the GL upload happens here, within budget.
+        textureManager->uploadPendingTextures();
+
         renderer->beginScene(view, projection);
-        for (const auto &entity: entityManager->getEntities()) {
-            // If this is our debug canvas overlay, anchor to screen and upload pixels on render
-            // thread
-            if (auto overlay = std::dynamic_pointer_cast<CanvasOverlay>(entity)) {
-                // Place overlay slightly in front of camera (negative Z in view space)
-                glm::vec3 screenAnchor(-1.7f, 1.0f, -1.0f);  // top-left-ish in our ortho view
+        {
+            INK_PROFILE_SCOPE("render submit");
+            if (overlay) {
+                overlay->rasterizeStroke();
+                if (overlay->raster().pointCount() > 0 && overlay->version() != liveVersion) {
+                    INK_PROFILE_SCOPE("recognizer submit");
+                    m_recognizer->submitLive(overlay->raster());
+                    liveVersion = overlay->version();
+                }
                 overlay->uploadToGpu();
             }
-
-            if (entity->renderObject == nullptr)
-                continue;  // skip entities without render objects.
-            renderer->submit(entity->renderObject);
+            if (latest) {
+                for (std::size_t i = 0; i < latest->items.size(); ++i) {
+                    renderer->submit(interpolate(latest->items[i], previous, i, alpha));
+                }
+            }
         }
 
         // 3. render
@@ -257,10 +364,43 @@ void Application::run() {
         renderer->endScene();
         renderer->clearQueue();
 
-        glfwSwapBuffers(window);
+#if INK_PROFILE
+        // Stats dumps only in profiler builds, so normal runs keep a quiet console
+        if (++frame % 600 == 0) {
+            const RenderStats &stats = renderer->getStats();
+            std::cout << "[renderer] " << stats.sprites << " sprites, " << stats.drawCalls
+                      << " draw calls, " << stats.shaderBinds << " shader binds, "
+                      << stats.textureBinds << " texture binds\n";
+            std::cout << "[renderer] GL: " << stats.shader.programBinds << " program binds ("
+                      << stats.shader.programBindsSkipped << " skipped), "
+                      << stats.shader.uniformUploads << " uniform uploads ("
+                      << stats.shader.uniformUploadsSkipped << " skipped), "
+                      << stats.cameraUploads << " camera uploads\n";
+            const ResourceCacheStats &cache = ResourceCache::instance()->stats();
+            std::cout << "[ResourceCache] shaders " << cache.shaderHits << " hits / "
+                      << cache.shaderMisses << " misses, " << cache.missMs << " ms loading\n";
+            const TextureLoadStats loads = textureManager->textureLoadStats();
+            std::cout << "[TextureLoader] " << loads.loaded << " loaded, " << loads.failed
+                      << " failed, " << loads.queued + loads.decoded << " pending, "
+                      << loads.decodeMs << " ms decoding (max " << loads.maxDecodeMs << "), "
+                      << loads.uploadBytes / 1024 << " KiB uploaded ("
+                      << loads.uploadBytesLastFrame / 1024 << " KiB last frame)\n";
+            Profiler::instance().printSummary(std::cout);
+        }
+#endif
+
+        {
+            INK_PROFILE_SCOPE("swap");
+            glfwSwapBuffers(window);
+        }
         glfwPollEvents();
+        INK_PROFILE_FRAME();
     }
 
     running = false;
     updater.join();
+#if INK_PROFILE
+    Profiler::instance().endFrame();  // pick up the updater's last ticks
+    Profiler::instance().writeChromeTrace("ink_trace.json");
+#endif
 }
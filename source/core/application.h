@@ -2,14 +2,18 @@
 #define INK_APPLICATION_H
 
 #define GLFW_INCLUDE_NONE
+#include "drawnPlatform.h"
 #include "entityManager.h"
+#include "jobSystem.h"
+#include "levelStreamer.h"
+#include "recognizerService.h"
+#include "spscRing.h"
+#include "renderer/renderSnapshot.h"
 #include "renderer/textureManager.h"
 #include <GLFW/glfw3.h>
 #include <entities/character.h>
 #include <entities/platform.h>
 
-#include <mutex>
-
 /**
  * Simple application loop with window setup/cleanup.
  */
@@ -32,7 +36,35 @@ public:
 private:
     Application();
 
-    std::mutex m_mutex;
+    // What the render thread asks of the simulation: new movement keys for
+    // the player, or a drawn platform to spawn.
+    struct SimCommand {
+        enum class Kind : uint8_t { keys, spawnPlatform };
+        Kind kind = Kind::keys;
+        Character::KeyInput keys{};  // keys
+        DrawnPlatform placed{};      // spawnPlatform
+        std::shared_ptr<Texture> texture;
+        double requested = 0.0;  // glfwGetTime() when queued
+    };
+
+    // Request-to-spawn latency of drawn platforms, including the wait for
+    // the next tick. Update thread; logged with the periodic stats
+    // (INK_PROFILE builds).
+    struct SpawnStats {
+        uint64_t spawned = 0;
+        double totalMs = 0.0;
+        double maxMs = 0.0;
+    };
+
+    // Update thread, at the start of a tick: apply what the render thread queued.
+    void drainCommands();
+
+    // Render -> update hand-off. Neither thread locks or waits on the other:
+    // the updater owns the simulation (entities, bodies, the player),
+    // rendering only reads m_snapshots.
+    SpscRing<SimCommand, 64> m_commands;
+    SpawnStats m_spawnStats;
+    SnapshotBuffer m_snapshots;
 
     int width = 1280;
     int height = 720;
@@ -46,7 +78,13 @@ private:
     std::shared_ptr<Character> player = nullptr;
 
     EntityManager *entityManager = nullptr;
+    // Workers for the fixed-step update; the update thread is worker 0
+    std::unique_ptr<JobSystem> jobSystem = nullptr;
     std::shared_ptr<TextureManager> textureManager = nullptr;
+    // Set when the level is cooked: streams its stationary platforms.
+    std::unique_ptr<LevelStreamer> m_streamer;
+    // Classifies strokes off the render thread, live while drawing too.
+    std::unique_ptr<RecognizerService> m_recognizer;
 };
 
 #endif  // INK_APPLICATION_H
\ No newline at end of file
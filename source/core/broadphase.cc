@@ -0,0 +1,371 @@
+#include "broadphase.h"
+#include "jobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+BroadphasePair orderedPair(uint32_t a, uint32_t b) {
+    return a < b ? BroadphasePair{a, b} : BroadphasePair{b, a};
+}
+
+void sortUnique(std::vector<BroadphasePair> &pairs) {
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+}
+}  // namespace
+
+std::unique_ptr<Broadphase> Broadphase::create(BroadphaseType type) {
+    switch (type) {
+    case BroadphaseType::sweepAndPrune:
+        return std::make_unique<SweepAndPruneBroadphase>();
+    case BroadphaseType::spatialHash:
+    default:
+        return std::make_unique<SpatialHashBroadphase>();
+    }
+}
+
+std::size_t Broadphase::forEachMoverChunk(
+        std::size_t moverCount,
+        const std::function<void(Chunk &, std::size_t, std::size_t)> &fn) {
+    const std::size_t chunks = JobSystem::chunkCount(moverCount, kMoversPerChunk);
+    if (m_chunks.size() < chunks)
+        m_chunks.resize(chunks);
+    for (std::size_t c = 0; c < chunks; ++c) {
+        m_chunks[c].pairs.clear();
+        m_chunks[c].cells.clear();
+        m_chunks[c].oversized.clear();
+    }
+
+    auto run = [&](std::size_t begin, std::size_t end) {
+        fn(m_chunks[begin / kMoversPerChunk], begin, end);
+    };
+    if (m_jobs) {
+        m_jobs->parallelFor(moverCount, kMoversPerChunk, run);
+    } else {
+        for (std::size_t begin = 0; begin < moverCount; begin += kMoversPerChunk)
+            run(begin, std::min(moverCount, begin + kMoversPerChunk));
+    }
+    return chunks;
+}
+
+/*──────────────────────────   spatial hash   ────────────────────────────*/
+SpatialHashBroadphase::SpatialHashBroadphase(float cellSize) : m_invCellSize(1.0f / cellSize) {
+}
+
+SpatialHashBroadphase::CellRange SpatialHashBroadphase::cellsFor(const Aabb &bounds) const {
+    return {static_cast<int>(std::floor(bounds.min.x * m_invCellSize)),
+            static_cast<int>(std::floor(bounds.min.y * m_invCellSize)),
+            static_cast<int>(std::floor(bounds.max.x * m_invCellSize)),
+            static_cast<int>(std::floor(bounds.max.y * m_invCellSize))};
+}
+
+uint64_t SpatialHashBroadphase::cellKey(int x, int y) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+void SpatialHashBroadphase::addStatic(uint32_t id, const Aabb &bounds) {
+    const auto slot = static_cast<uint32_t>(m_statics.size());
+    m_statics.push_back({id, bounds});
+    if (m_slotOfStatic.size() <= id)
+        m_slotOfStatic.resize(id + 1, kNoSlot);
+    m_slotOfStatic[id] = slot;
+
+    const CellRange r = cellsFor(bounds);
+    if (r.count() > kMaxCellsPerBody) {
+        m_oversizedStatics.push_back(slot);
+        return;
+    }
+    for (int y = r.y0; y <= r.y1; ++y) {
+        for (int x = r.x0; x <= r.x1; ++x) {
+            m_staticCells[cellKey(x, y)].push_back(slot);
+        }
+    }
+}
+
+void SpatialHashBroadphase::replaceStaticSlot(const Aabb &bounds, uint32_t from, uint32_t to) {
+    auto replace = [from, to](std::vector<uint32_t> &slots) {
+        const auto it = std::find(slots.begin(), slots.end(), from);
+        if (it == slots.end())
+            return;
+        if (to != kNoSlot) {
+            *it = to;
+        } else {
+            *it = slots.back();
+            slots.pop_back();
+        }
+    };
+    const CellRange r = cellsFor(bounds);
+    if (r.count() > kMaxCellsPerBody) {
+        replace(m_oversizedStatics);
+        return;
+    }
+    for (int y = r.y0; y <= r.y1; ++y) {
+        for (int x = r.x0; x <= r.x1; ++x) {
+            const auto cell = m_staticCells.find(cellKey(x, y));
+            if (cell == m_staticCells.end())
+                continue;
+            replace(cell->second);
+            if (cell->second.empty())
+                m_staticCells.erase(cell);
+        }
+    }
+}
+
+void SpatialHashBroadphase::removeStatics(const std::vector<uint32_t> &ids) {
+    // Swap-remove each one: unlink it from its cells, move the last static
+    // into its slot and relink that one. Only the cells of the bodies
+    // involved are touched, not the whole grid.
+    for (uint32_t id: ids) {
+        if (id >= m_slotOfStatic.size() || m_slotOfStatic[id] == kNoSlot)
+            continue;
+        const uint32_t slot = m_slotOfStatic[id];
+        const auto last = static_cast<uint32_t>(m_statics.size() - 1);
+        replaceStaticSlot(m_statics[slot].bounds, slot, kNoSlot);
+        if (slot != last) {
+            replaceStaticSlot(m_statics[last].bounds, last, slot);
+            m_statics[slot] = m_statics[last];
+            m_slotOfStatic[m_statics[slot].id] = slot;
+        }
+        m_statics.pop_back();
+        m_slotOfStatic[id] = kNoSlot;
+    }
+}
+
+void SpatialHashBroadphase::setDynamic(const std::vector<BroadphaseProxy> &movers) {
+    m_movers = movers;
+}
+
+void SpatialHashBroadphase::collectPairs(std::vector<BroadphasePair> &out) {
+    out.clear();
+
+    // Movers against statics; also records which cells each mover touches.
+    auto queryMovers = [this](Chunk &chunk, std::size_t begin, std::size_t end) {
+        for (auto slot = static_cast<uint32_t>(begin); slot < end; ++slot) {
+            const BroadphaseProxy &mover = m_movers[slot];
+            const CellRange r = cellsFor(mover.bounds);
+
+            if (r.count() > kMaxCellsPerBody) {
+                // Too big for the grid: test it against everything directly.
+                chunk.oversized.push_back(slot);
+                for (const auto &s: m_statics) {
+                    if (overlaps(mover.bounds, s.bounds))
+                        chunk.pairs.push_back(orderedPair(mover.id, s.id));
+                }
+                continue;
+            }
+
+            for (int y = r.y0; y <= r.y1; ++y) {
+                for (int x = r.x0; x <= r.x1; ++x) {
+                    const uint64_t key = cellKey(x, y);
+                    chunk.cells.emplace_back(key, slot);
+
+                    auto it = m_staticCells.find(key);
+                    if (it == m_staticCells.end())
+                        continue;
+                    for (uint32_t s: it->second) {
+                        if (overlaps(mover.bounds, m_statics[s].bounds))
+                            chunk.pairs.push_back(orderedPair(mover.id, m_statics[s].id));
+                    }
+                }
+            }
+            for (uint32_t s: m_oversizedStatics) {
+                if (overlaps(mover.bounds, m_statics[s].bounds))
+                    chunk.pairs.push_back(orderedPair(mover.id, m_statics[s].id));
+            }
+        }
+    };
+    const std::size_t chunks = forEachMoverChunk(m_movers.size(), queryMovers);
+
+    m_dynamicCells.clear();
+    m_oversizedMovers.clear();
+    for (std::size_t c = 0; c < chunks; ++c) {
+        const Chunk &chunk = m_chunks[c];
+        out.insert(out.end(), chunk.pairs.begin(), chunk.pairs.end());
+        m_dynamicCells.insert(m_dynamicCells.end(), chunk.cells.begin(), chunk.cells.end());
+        m_oversizedMovers.insert(m_oversizedMovers.end(), chunk.oversized.begin(),
+                                 chunk.oversized.end());
+    }
+
+    // Dynamic-vs-dynamic: movers sharing a cell end up adjacent after sorting.
+    std::sort(m_dynamicCells.begin(), m_dynamicCells.end());
+    for (std::size_t begin = 0; begin < m_dynamicCells.size();) {
+        std::size_t end = begin + 1;
+        while (end < m_dynamicCells.size() && m_dynamicCells[end].first == m_dynamicCells[begin].first)
+            ++end;
+        for (std::size_t i = begin; i < end; ++i) {
+            for (std::size_t j = i + 1; j < end; ++j) {
+                const BroadphaseProxy &a = m_movers[m_dynamicCells[i].second];
+                const BroadphaseProxy &b = m_movers[m_dynamicCells[j].second];
+                if (overlaps(a.bounds, b.bounds))
+                    out.push_back(orderedPair(a.id, b.id));
+            }
+        }
+        begin = end;
+    }
+    for (uint32_t big: m_oversizedMovers) {
+        for (uint32_t slot = 0; slot < m_movers.size(); ++slot) {
+            if (slot != big && overlaps(m_movers[big].bounds, m_movers[slot].bounds))
+                out.push_back(orderedPair(m_movers[big].id, m_movers[slot].id));
+        }
+    }
+
+    sortUnique(out);
+}
+
+void SpatialHashBroadphase::clear() {
+    m_staticCells.clear();
+    m_statics.clear();
+    m_slotOfStatic.clear();
+    m_oversizedStatics.clear();
+    m_movers.clear();
+}
+
+/*─────────────────────────   sweep and prune   ──────────────────────────*/
+void SweepAndPruneBroadphase::addStatic(uint32_t id, const Aabb &bounds) {
+    if (!m_baked) {
+        // Appending keeps level load O(n); bake() sorts once at the end.
+        m_statics.push_back({id, bounds});
+        m_dirty = true;
+        return;
+    }
+
+    // Runtime insert (drawn platform): keep the baked array sorted instead of
+    // re-sorting everything on the next tick.
+    auto it = std::upper_bound(m_statics.begin(), m_statics.end(), bounds.min.x,
+                               [](float x, const BroadphaseProxy &p) {
+                                   return x < p.bounds.min.x;
+                               });
+    const auto at = static_cast<std::size_t>(it - m_statics.begin());
+    m_statics.insert(it, {id, bounds});
+    m_staticBounds.insert(at, bounds);
+
+    float running = at > 0 ? m_prefixMaxX[at - 1] : -INFINITY;
+    m_prefixMaxX.insert(m_prefixMaxX.begin() + at, 0.0f);
+    for (std::size_t i = at; i < m_statics.size(); ++i) {
+        running = std::max(running, m_statics[i].bounds.max.x);
+        if (i > at && m_prefixMaxX[i] == running)
+            break;  // prefix already correct from here on
+        m_prefixMaxX[i] = running;
+    }
+}
+
+void SweepAndPruneBroadphase::addStatics(const BroadphaseProxy *statics, std::size_t count) {
+    const auto mid = static_cast<std::ptrdiff_t>(m_statics.size());
+    m_statics.insert(m_statics.end(), statics, statics + count);
+    if (!m_baked || m_dirty) {
+        m_dirty = true;
+        return;
+    }
+    // Sort just the new ones and merge: O(n + k log k) instead of k inserts.
+    auto byMinX = [](const BroadphaseProxy &a, const BroadphaseProxy &b) {
+        return a.bounds.min.x < b.bounds.min.x;
+    };
+    std::sort(m_statics.begin() + mid, m_statics.end(), byMinX);
+    std::inplace_merge(m_statics.begin(), m_statics.begin() + mid, m_statics.end(), byMinX);
+    rebuildPrefix();
+}
+
+void SweepAndPruneBroadphase::removeStatics(const std::vector<uint32_t> &ids) {
+    if (ids.empty())
+        return;
+    const auto removed = std::remove_if(m_statics.begin(), m_statics.end(), [&](const auto &s) {
+        return std::binary_search(ids.begin(), ids.end(), s.id);
+    });
+    if (removed == m_statics.end())
+        return;
+    m_statics.erase(removed, m_statics.end());  // order is kept
+    if (!m_dirty)
+        rebuildPrefix();
+}
+
+void SweepAndPruneBroadphase::bake() {
+    if (m_dirty)
+        sortStatics();
+    m_baked = true;
+}
+
+void SweepAndPruneBroadphase::sortStatics() {
+    std::sort(m_statics.begin(), m_statics.end(),
+              [](const BroadphaseProxy &a, const BroadphaseProxy &b) {
+                  return a.bounds.min.x < b.bounds.min.x;
+              });
+    rebuildPrefix();
+    m_dirty = false;
+}
+
+void SweepAndPruneBroadphase::rebuildPrefix() {
+    m_prefixMaxX.resize(m_statics.size());
+    m_staticBounds.clear();
+    m_staticBounds.reserve(m_statics.size());
+    float running = -INFINITY;
+    for (std::size_t i = 0; i < m_statics.size(); ++i) {
+        running = std::max(running, m_statics[i].bounds.max.x);
+        m_prefixMaxX[i] = running;
+        m_staticBounds.push_back(m_statics[i].bounds);
+    }
+}
+
+void SweepAndPruneBroadphase::setDynamic(const std::vector<BroadphaseProxy> &movers) {
+    m_movers = movers;
+    std::sort(m_movers.begin(), m_movers.end(),
+              [](const BroadphaseProxy &a, const BroadphaseProxy &b) {
+                  return a.bounds.min.x < b.bounds.min.x;
+              });
+}
+
+void SweepAndPruneBroadphase::collectPairs(std::vector<BroadphasePair> &out) {
+    out.clear();
+    if (m_dirty)
+        sortStatics();
+
+    const float *minX = m_staticBounds.minX();
+    auto queryMovers = [&](Chunk &chunk, std::size_t begin, std::size_t end) {
+        for (std::size_t m = begin; m < end; ++m) {
+            const BroadphaseProxy &mover = m_movers[m];
+
+            // [first, last): statics whose running max.x reaches the mover and
+            // that start before it ends. Everything outside cannot overlap.
+            const auto first = static_cast<std::size_t>(
+                    std::lower_bound(m_prefixMaxX.begin(), m_prefixMaxX.end(), mover.bounds.min.x) -
+                    m_prefixMaxX.begin());
+            const auto last = static_cast<std::size_t>(
+                    std::upper_bound(minX + first, minX + m_statics.size(), mover.bounds.max.x) -
+                    minX);
+            if (first < last) {
+                const std::size_t count = last - first;
+                chunk.mask.resize(overlapMaskWords(count));
+                if (overlapBatch(mover.bounds, m_staticBounds, first, count, chunk.mask.data()) > 0) {
+                    for (std::size_t w = 0; w < chunk.mask.size(); ++w) {
+                        for (uint64_t bits = chunk.mask[w]; bits != 0; bits &= bits - 1) {
+                            const std::size_t i = first + w * 64 + lowestBit(bits);
+                            chunk.pairs.push_back(orderedPair(mover.id, m_statics[i].id));
+                        }
+                    }
+                }
+            }
+
+            // Movers after this one in min.x order, until they start past its end.
+            for (std::size_t j = m + 1; j < m_movers.size(); ++j) {
+                if (m_movers[j].bounds.min.x > mover.bounds.max.x)
+                    break;
+                if (overlaps(mover.bounds, m_movers[j].bounds))
+                    chunk.pairs.push_back(orderedPair(mover.id, m_movers[j].id));
+            }
+        }
+    };
+    const std::size_t chunks = forEachMoverChunk(m_movers.size(), queryMovers);
+
+    for (std::size_t c = 0; c < chunks; ++c)
+        out.insert(out.end(), m_chunks[c].pairs.begin(), m_chunks[c].pairs.end());
+    sortUnique(out);
+}
+
+void SweepAndPruneBroadphase::clear() {
+    m_statics.clear();
+    m_staticBounds.clear();
+    m_prefixMaxX.clear();
+    m_movers.clear();
+    m_dirty = false;
+    m_baked = false;
+}
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "entities/hitbox.h"
+#include "entities/hitboxBatch.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Broadphase
+// - Produces candidate pairs for EntityManager's narrow-phase so the per-tick
+//   collision pass no longer tests every entity against every other one.
+// - Static bodies (platforms that never move) live in a persistent structure
+//   and are inserted once; moving bodies are re-submitted every tick.
+// - Only pairs touching at least one moving body are reported: two static
+//   bodies can never resolve against each other.
+//
+// Proxy ids are chosen by the caller (EntityManager uses the ComponentStore
+// slot, so pair order follows spawn order).
+//
+// With a JobSystem attached, collectPairs() queries movers in fixed-size
+// chunks on the workers and merges the chunks in order before sorting, so
+// the output does not depend on the worker count.
+
+class JobSystem;
+
+/// Which broadphase implementation EntityManager should build.
+enum class BroadphaseType { spatialHash, sweepAndPrune };
+
+/// A body handed to the broadphase: caller-owned id plus its current bounds.
+struct BroadphaseProxy {
+    uint32_t id;
+    Aabb bounds;
+};
+
+/// Candidate pair, always ordered so that first < second.
+using BroadphasePair = std::pair<uint32_t, uint32_t>;
+
+class Broadphase {
+public:
+    virtual ~Broadphase() = default;
+
+    /// Build the implementation selected by `type`.
+    static std::unique_ptr<Broadphase> create(BroadphaseType type);
+
+    /// Register a body that never moves. Kept until removeStatics() or clear().
+    virtual void addStatic(uint32_t id, const Aabb &bounds) = 0;
+
+    /// Register several statics at once (streamed level chunks). Same result
+    /// as addStatic() for each; implementations may merge them in bulk.
+    virtual void addStatics(const BroadphaseProxy *statics, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i)
+            addStatic(statics[i].id, statics[i].bounds);
+    }
+
+    /// Unregister statics by id (streamed chunks leaving). `ids` must be
+    /// sorted; ids that were never added are ignored.
+    virtual void removeStatics(const std::vector<uint32_t> &ids) = 0;
+
+    /// Finalize the statics added so far (called once after level load).
+    /// Statics added afterwards (drawn platforms) are merged in place.
+    virtual void bake() {
+    }
+
+    /// Replace the set of moving bodies for this tick.
+    virtual void setDynamic(const std::vector<BroadphaseProxy> &movers) = 0;
+
+    /// Collect candidate pairs (dynamic-vs-static and dynamic-vs-dynamic).
+    /// Output is sorted and free of duplicates so resolution order matches
+    /// the old (i, j) pair loop.
+    virtual void collectPairs(std::vector<BroadphasePair> &out) = 0;
+
+    /// Drop every static and dynamic body.
+    virtual void clear() = 0;
+
+    virtual BroadphaseType type() const = 0;
+
+    /// Run mover queries on `jobs` (nullptr: on the calling thread).
+    void setJobSystem(JobSystem *jobs) {
+        m_jobs = jobs;
+    }
+
+protected:
+    // Per-chunk output, merged in chunk order after the parallel part.
+    struct Chunk {
+        std::vector<BroadphasePair> pairs;
+        std::vector<std::pair<uint64_t, uint32_t>> cells;  // spatial hash: (cell, mover slot)
+        std::vector<uint32_t> oversized;                    // spatial hash: oversized mover slots
+        std::vector<uint64_t> mask;                         // sweep and prune: overlapBatch scratch
+    };
+
+    // Movers per chunk; fixed so chunking never depends on the worker count.
+    static constexpr std::size_t kMoversPerChunk = 128;
+
+    // Call fn(chunk, begin, end) for every chunk of [0, moverCount), on the
+    // job system when one is set. Chunks are cleared first; read them back
+    // from m_chunks[0, chunkCount).
+    std::size_t forEachMoverChunk(
+            std::size_t moverCount,
+            const std::function<void(Chunk &, std::size_t, std::size_t)> &fn);
+
+    JobSystem *m_jobs = nullptr;
+    std::vector<Chunk> m_chunks;
+};
+
+/// Uniform grid hashed by cell coordinate. Good general choice when bodies
+/// are of similar size and spread in both X and Y.
+class SpatialHashBroadphase : public Broadphase {
+public:
+    explicit SpatialHashBroadphase(float cellSize = 1.0f);
+
+    void addStatic(uint32_t id, const Aabb &bounds) override;
+    void removeStatics(const std::vector<uint32_t> &ids) override;
+    void setDynamic(const std::vector<BroadphaseProxy> &movers) override;
+    void collectPairs(std::vector<BroadphasePair> &out) override;
+    void clear() override;
+
+    BroadphaseType type() const override {
+        return BroadphaseType::spatialHash;
+    }
+
+private:
+    struct CellRange {
+        int x0, y0, x1, y1;
+
+        long long count() const {
+            return static_cast<long long>(x1 - x0 + 1) * (y1 - y0 + 1);
+        }
+    };
+
+    CellRange cellsFor(const Aabb &bounds) const;
+    static uint64_t cellKey(int x, int y);
+    // Replace static slot `from` with `to` wherever a body with `bounds` is
+    // listed (its cells, or the oversized list); kNoSlot removes it.
+    void replaceStaticSlot(const Aabb &bounds, uint32_t from, uint32_t to);
+
+    static constexpr uint32_t kNoSlot = ~0u;
+
+    // Bodies spanning more cells than this skip the grid and are tested
+    // directly instead (e.g. a very long floor strip).
+    static constexpr long long kMaxCellsPerBody = 256;
+
+    float m_invCellSize;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> m_staticCells;  // cell -> static slots
+    std::vector<BroadphaseProxy> m_statics;    // unordered; removal swaps in the last
+    std::vector<uint32_t> m_slotOfStatic;      // static id -> m_statics slot, or kNoSlot
+    std::vector<uint32_t> m_oversizedStatics;  // slots in m_statics
+    std::vector<BroadphaseProxy> m_movers;
+
+    // Scratch reused between ticks
+    std::vector<std::pair<uint64_t, uint32_t>> m_dynamicCells;  // (cell, mover slot)
+    std::vector<uint32_t> m_oversizedMovers;
+};
+
+/// Sort-and-sweep along X. Statics are sorted by min.x once in bake() and
+/// later inserts are merged in place; movers are swept against each other
+/// every tick.
+/// Best for side-scrolling levels that are long in X and shallow in Y.
+class SweepAndPruneBroadphase : public Broadphase {
+public:
+    void addStatic(uint32_t id, const Aabb &bounds) override;
+    void addStatics(const BroadphaseProxy *statics, std::size_t count) override;
+    void removeStatics(const std::vector<uint32_t> &ids) override;
+    void bake() override;
+    void setDynamic(const std::vector<BroadphaseProxy> &movers) override;
+    void collectPairs(std::vector<BroadphasePair> &out) override;
+    void clear() override;
+
+    BroadphaseType type() const override {
+        return BroadphaseType::sweepAndPrune;
+    }
+
+private:
+    void sortStatics();
+    void rebuildPrefix();  // m_staticBounds and m_prefixMaxX from sorted m_statics
+
+    std::vector<BroadphaseProxy> m_statics;  // sorted by bounds.min.x when !m_dirty
+    AabbBatch m_staticBounds;                // m_statics' bounds, packed for overlapBatch
+    std::vector<float> m_prefixMaxX;         // running max of bounds.max.x over m_statics
+    bool m_dirty = false;
+    bool m_baked = false;                    // after bake(), inserts keep the array sorted
+    std::vector<BroadphaseProxy> m_movers;   // sorted by bounds.min.x in setDynamic()
+};
@@ -0,0 +1,77 @@
+#include "cnnFormat.h"
+
+#include <cstring>
+
+namespace {
+bool sectionFits(uint64_t offset, uint64_t count, uint64_t stride, uint64_t size) {
+    return offset % 4 == 0 && offset <= size && count * stride <= size - offset;
+}
+
+uint32_t labelOffset(const unsigned char *labels, uint32_t index) {
+    uint32_t offset;
+    std::memcpy(&offset, labels + index * sizeof(uint32_t), sizeof(offset));
+    return offset;
+}
+
+bool hasWeights(uint32_t type) {
+    return type == static_cast<uint32_t>(CnnFormat::LayerType::conv2d) ||
+           type == static_cast<uint32_t>(CnnFormat::LayerType::dense);
+}
+
+bool layerFits(const CnnFormat::LayerRecord &r, std::size_t size) {
+    using CnnFormat::LayerType;
+    using CnnFormat::WeightType;
+    if (r.type < static_cast<uint32_t>(LayerType::conv2d) ||
+        r.type > static_cast<uint32_t>(LayerType::softmax))
+        return false;
+    if (!hasWeights(r.type))
+        return r.weightType == static_cast<uint32_t>(WeightType::none);
+
+    if (!sectionFits(r.biasOffset, r.outputs, sizeof(float), size))
+        return false;
+    if (r.weightType == static_cast<uint32_t>(WeightType::f32))
+        return sectionFits(r.weightOffset, r.weightCount, sizeof(float), size);
+    if (r.weightType == static_cast<uint32_t>(WeightType::i8))
+        return sectionFits(r.weightOffset, r.weightCount, sizeof(int8_t), size) &&
+               sectionFits(r.scaleOffset, r.outputs, sizeof(float), size);
+    return false;
+}
+}  // namespace
+
+const char *CnnFormat::View::label(uint32_t index) const {
+    return reinterpret_cast<const char *>(labels + labelOffset(labels, index));
+}
+
+bool CnnFormat::parse(const unsigned char *data, std::size_t size, View &out) {
+    if (size < sizeof(Header))
+        return false;
+    const auto *h = reinterpret_cast<const Header *>(data);
+    if (std::memcmp(h->magic, kMagic, sizeof(kMagic)) != 0 || h->version != kVersion ||
+        h->fileSize != size)
+        return false;
+    if (!sectionFits(h->layerOffset, h->layerCount, sizeof(LayerRecord), size) ||
+        !sectionFits(h->labelOffset, h->labelCount, sizeof(uint32_t), size))
+        return false;
+
+    out.header = h;
+    out.layers = reinterpret_cast<const LayerRecord *>(data + h->layerOffset);
+    out.data = data;
+    out.labels = data + h->labelOffset;
+    out.labelBytes = static_cast<uint32_t>(size - h->labelOffset);
+    for (uint32_t i = 0; i < h->layerCount; ++i) {
+        if (!layerFits(out.layers[i], size))
+            return false;
+    }
+    if (h->labelCount == 0)
+        return true;
+
+    // The table ends in NUL, so every in-range offset names a terminated string.
+    if (out.labels[out.labelBytes - 1] != '\0')
+        return false;
+    for (uint32_t i = 0; i < h->labelCount; ++i) {
+        const uint32_t offset = labelOffset(out.labels, i);
+        if (offset < h->labelCount * sizeof(uint32_t) || offset >= out.labelBytes)
+            return false;
+    }
+    return true;
+}
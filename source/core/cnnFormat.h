@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Cooked conv-net weights (.inkn), written by TinyCnn::save() or by
+ * tools/cnn_export from a PyTorch-style .npz, read by TinyCnn::load().
+ *
+ *   Header
+ *   LayerRecord[layerCount]   at layerOffset, in forward order
+ *   weight data               at each record's weightOffset / biasOffset /
+ *                             scaleOffset
+ *   label table               at labelOffset: uint32 offsets[labelCount]
+ *                             (from the table start), then NUL-terminated
+ *                             class names; labelCount may be 0
+ *
+ * Conv weights are [out][in][kernel][kernel] and dense weights [out][in]
+ * with the input flattened channel-major, both as PyTorch stores them.
+ * Float weights are f32; int8 weights have one f32 scale per output
+ * (weight = scale * q). Biases are always f32. Every section starts on a
+ * 4-byte boundary and values are little-endian, as in LevelFormat.
+ * Bump kVersion whenever a record changes.
+ */
+namespace CnnFormat {
+
+constexpr char kMagic[4] = {'I', 'N', 'K', 'N'};
+constexpr uint32_t kVersion = 1;
+constexpr const char *kExtension = ".inkn";
+
+enum class LayerType : uint32_t { conv2d = 1, relu = 2, maxPool = 3, dense = 4, softmax = 5 };
+enum class WeightType : uint32_t { none = 0, f32 = 1, i8 = 2 };
+
+struct Header {
+    char magic[4];
+    uint32_t version;
+    uint32_t fileSize;  // whole file, for truncation checks
+    uint32_t inputChannels;
+    uint32_t inputHeight;
+    uint32_t inputWidth;
+    uint32_t layerCount;
+    uint32_t layerOffset;
+    uint32_t labelCount;
+    uint32_t labelOffset;
+};
+
+struct LayerRecord {
+    uint32_t type;        // LayerType
+    uint32_t outputs;     // conv: output channels; dense: output features
+    uint32_t kernel;      // conv, maxPool: window size
+    uint32_t stride;      // conv
+    uint32_t padding;     // conv: zero padding on every side
+    uint32_t weightType;  // WeightType; none for layers without weights
+    uint32_t weightCount;
+    uint32_t weightOffset;
+    uint32_t biasOffset;   // `outputs` floats
+    uint32_t scaleOffset;  // i8: `outputs` floats
+};
+
+/// Bounds-checked view of a cooked model in memory (usually a MappedFile).
+/// parse() checks the file is well formed, not that the layer shapes chain;
+/// TinyCnn::load() does that.
+struct View {
+    const Header *header = nullptr;
+    const LayerRecord *layers = nullptr;
+    const unsigned char *data = nullptr;  // the whole file
+    const unsigned char *labels = nullptr;
+    uint32_t labelBytes = 0;
+
+    /// Label `index` of the table; parse() checked it is NUL-terminated.
+    const char *label(uint32_t index) const;
+};
+
+/// Fill `out` from `size` bytes at `data`. False if the bytes are not a
+/// complete, consistent model of this version; every offset in a parsed
+/// View is in range for its record's counts.
+bool parse(const unsigned char *data, std::size_t size, View &out);
+
+static_assert(sizeof(Header) == 40, "Header layout is part of the file format");
+static_assert(sizeof(LayerRecord) == 40, "LayerRecord layout is part of the file format");
+
+}  // namespace CnnFormat
@@ -0,0 +1,478 @@
+#include "cnnKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#ifdef INK_SIMD_SSE2
+#include <immintrin.h>
+#endif
+#ifdef INK_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace {
+// Rows of a weight matrix in blocks of four (the SIMD paths keep four rows
+// of accumulators in registers), then one at a time.
+template <class Four, class One>
+void forRowBlocks(int rows, Four &&four, One &&one) {
+    int r = 0;
+    for (; r + 4 <= rows; r += 4)
+        four(r);
+    for (; r < rows; ++r)
+        one(r);
+}
+
+/*──────────────────────────────   scalar   ──────────────────────────────*/
+// Rows [0, rows) from column `first` on; also the column tail of the SIMD paths.
+template <class T>
+void gemmScalar(const T *w, const float *scales, const float *bias, int rows, int depth,
+                const float *b, int columns, float *c, bool relu, int first) {
+    for (int r = 0; r < rows; ++r) {
+        const float scale = scales ? scales[r] : 1.0f;
+        float *out = c + static_cast<std::size_t>(r) * columns;
+        for (int n = first; n < columns; ++n)
+            out[n] = bias[r];
+        for (int k = 0; k < depth; ++k) {
+            const float wk = float(w[static_cast<std::size_t>(r) * depth + k]) * scale;
+            const float *bk = b + static_cast<std::size_t>(k) * columns;
+            for (int n = first; n < columns; ++n)
+                out[n] += wk * bk[n];
+        }
+        if (relu) {
+            for (int n = first; n < columns; ++n)
+                out[n] = std::max(out[n], 0.0f);
+        }
+    }
+}
+
+// sum_k w[k] * x[k] over [first, depth).
+template <class T>
+float dotScalar(const T *w, const float *x, int first, int depth) {
+    float sum = 0.0f;
+    for (int k = first; k < depth; ++k)
+        sum += float(w[k]) * x[k];
+    return sum;
+}
+
+float finishRow(float sum, const float *scales, const float *bias, int r, bool relu) {
+    const float y = bias[r] + (scales ? scales[r] * sum : sum);
+    return relu ? std::max(y, 0.0f) : y;
+}
+
+template <class T>
+void gemvScalar(const T *w, const float *scales, const float *bias, int rows, int depth,
+                const float *x, float *y, bool relu) {
+    for (int r = 0; r < rows; ++r)
+        y[r] = finishRow(dotScalar(w + static_cast<std::size_t>(r) * depth, x, 0, depth), scales,
+                         bias, r, relu);
+}
+
+/*───────────────────────────────   SSE2   ───────────────────────────────*/
+#ifdef INK_SIMD_SSE2
+inline __m128 loadSse2(const float *p) {
+    return _mm_loadu_ps(p);
+}
+// Four int8 weights widened to floats: duplicating each byte into all four
+// of its lane's bytes and shifting right by 24 sign-extends it.
+inline __m128 loadSse2(const int8_t *p) {
+    int32_t bits;
+    std::memcpy(&bits, p, sizeof(bits));
+    __m128i v = _mm_cvtsi32_si128(bits);
+    v = _mm_unpacklo_epi8(v, v);
+    v = _mm_unpacklo_epi16(v, v);
+    return _mm_cvtepi32_ps(_mm_srai_epi32(v, 24));
+}
+
+inline float sumSse2(__m128 v) {
+    v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    v = _mm_add_ss(v, _mm_shuffle_ps(v, v, 0x55));
+    return _mm_cvtss_f32(v);
+}
+
+template <int R, class T>
+void gemmRowsSse2(const T *w, const float *scales, const float *bias, int r0, int depth,
+                  const float *b, int columns, float *c, bool relu) {
+    float scale[R];
+    for (int i = 0; i < R; ++i)
+        scale[i] = scales ? scales[r0 + i] : 1.0f;
+    const T *rowW = w + static_cast<std::size_t>(r0) * depth;
+    float *rowC = c + static_cast<std::size_t>(r0) * columns;
+    const __m128 zero = _mm_setzero_ps();
+
+    int n = 0;
+    for (; n + 8 <= columns; n += 8) {
+        __m128 acc[R][2];
+        for (int i = 0; i < R; ++i)
+            acc[i][0] = acc[i][1] = _mm_set1_ps(bias[r0 + i]);
+        for (int k = 0; k < depth; ++k) {
+            const float *bk = b + static_cast<std::size_t>(k) * columns + n;
+            const __m128 b0 = _mm_loadu_ps(bk);
+            const __m128 b1 = _mm_loadu_ps(bk + 4);
+            for (int i = 0; i < R; ++i) {
+                const float wk = float(rowW[static_cast<std::size_t>(i) * depth + k]) * scale[i];
+                const __m128 wv = _mm_set1_ps(wk);
+                acc[i][0] = _mm_add_ps(acc[i][0], _mm_mul_ps(wv, b0));
+                acc[i][1] = _mm_add_ps(acc[i][1], _mm_mul_ps(wv, b1));
+            }
+        }
+        for (int i = 0; i < R; ++i) {
+            float *out = rowC + static_cast<std::size_t>(i) * columns + n;
+            _mm_storeu_ps(out, relu ? _mm_max_ps(acc[i][0], zero) : acc[i][0]);
+            _mm_storeu_ps(out + 4, relu ? _mm_max_ps(acc[i][1], zero) : acc[i][1]);
+        }
+    }
+    gemmScalar(rowW, scales ? scales + r0 : nullptr, bias + r0, R, depth, b, columns, rowC, relu,
+               n);
+}
+
+template <int R, class T>
+void gemvRowsSse2(const T *w, const float *scales, const float *bias, int r0, int depth,
+                  const float *x, float *y, bool relu) {
+    const T *rowW = w + static_cast<std::size_t>(r0) * depth;
+    __m128 acc[R];
+    for (int i = 0; i < R; ++i)
+        acc[i] = _mm_setzero_ps();
+    int k = 0;
+    for (; k + 4 <= depth; k += 4) {
+        const __m128 xk = _mm_loadu_ps(x + k);
+        for (int i = 0; i < R; ++i) {
+            const T *wi = rowW + static_cast<std::size_t>(i) * depth;
+            acc[i] = _mm_add_ps(acc[i], _mm_mul_ps(loadSse2(wi + k), xk));
+        }
+    }
+    for (int i = 0; i < R; ++i) {
+        const T *wi = rowW + static_cast<std::size_t>(i) * depth;
+        const float sum = sumSse2(acc[i]) + dotScalar(wi, x, k, depth);
+        y[r0 + i] = finishRow(sum, scales, bias, r0 + i, relu);
+    }
+}
+#endif
+
+/*───────────────────────────────   AVX2   ───────────────────────────────*/
+#ifdef INK_SIMD_AVX2
+INK_TARGET_AVX2
+inline __m256 loadAvx2(const float *p) {
+    return _mm256_loadu_ps(p);
+}
+INK_TARGET_AVX2
+inline __m256 loadAvx2(const int8_t *p) {
+    const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(p));
+    return _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(bytes));
+}
+
+INK_TARGET_AVX2
+inline float sumAvx2(__m256 v) {
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 0x55));
+    return _mm_cvtss_f32(s);
+}
+
+template <int R, class T>
+INK_TARGET_AVX2 void gemmRowsAvx2(const T *w, const float *scales, const float *bias, int r0,
+                                  int depth, const float *b, int columns, float *c, bool relu) {
+    float scale[R];
+    for (int i = 0; i < R; ++i)
+        scale[i] = scales ? scales[r0 + i] : 1.0f;
+    const T *rowW = w + static_cast<std::size_t>(r0) * depth;
+    float *rowC = c + static_cast<std::size_t>(r0) * columns;
+    const __m256 zero = _mm256_setzero_ps();
+
+    int n = 0;
+    for (; n + 16 <= columns; n += 16) {
+        __m256 acc[R][2];
+        for (int i = 0; i < R; ++i)
+            acc[i][0] = acc[i][1] = _mm256_set1_ps(bias[r0 + i]);
+        for (int k = 0; k < depth; ++k) {
+            const float *bk = b + static_cast<std::size_t>(k) * columns + n;
+            const __m256 b0 = _mm256_loadu_ps(bk);
+            const __m256 b1 = _mm256_loadu_ps(bk + 8);
+            for (int i = 0; i < R; ++i) {
+                const float wk = float(rowW[static_cast<std::size_t>(i) * depth + k]) * scale[i];
+                const __m256 wv = _mm256_set1_ps(wk);
+                acc[i][0] = _mm256_add_ps(acc[i][0], _mm256_mul_ps(wv, b0));
+                acc[i][1] = _mm256_add_ps(acc[i][1], _mm256_mul_ps(wv, b1));
+            }
+        }
+        for (int i = 0; i < R; ++i) {
+            float *out = rowC + static_cast<std::size_t>(i) * columns + n;
+            _mm256_storeu_ps(out, relu ? _mm256_max_ps(acc[i][0], zero) : acc[i][0]);
+            _mm256_storeu_ps(out + 8, relu ? _mm256_max_ps(acc[i][1], zero) : acc[i][1]);
+        }
+    }
+    gemmScalar(rowW, scales ? scales + r0 : nullptr, bias + r0, R, depth, b, columns, rowC, relu,
+               n);
+}
+
+template <int R, class T>
+INK_TARGET_AVX2 void gemvRowsAvx2(const T *w, const float *scales, const float *bias, int r0,
+                                  int depth, const float *x, float *y, bool relu) {
+    const T *rowW = w + static_cast<std::size_t>(r0) * depth;
+    __m256 acc[R];
+    for (int i = 0; i < R; ++i)
+        acc[i] = _mm256_setzero_ps();
+    int k = 0;
+    for (; k + 8 <= depth; k += 8) {
+        const __m256 xk = _mm256_loadu_ps(x + k);
+        for (int i = 0; i < R; ++i) {
+            const T *wi = rowW + static_cast<std::size_t>(i) * depth;
+            acc[i] = _mm256_add_ps(acc[i], _mm256_mul_ps(loadAvx2(wi + k), xk));
+        }
+    }
+    for (int i = 0; i < R; ++i) {
+        const T *wi = rowW + static_cast<std::size_t>(i) * depth;
+        const float sum = sumAvx2(acc[i]) + dotScalar(wi, x, k, depth);
+        y[r0 + i] = finishRow(sum, scales, bias, r0 + i, relu);
+    }
+}
+
+INK_TARGET_AVX2
+void reluAvx2(float *x, std::size_t count) {
+    const __m256 zero = _mm256_setzero_ps();
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+        _mm256_storeu_ps(x + i, _mm256_max_ps(_mm256_loadu_ps(x + i), zero));
+    for (; i < count; ++i)
+        x[i] = std::max(x[i], 0.0f);
+}
+#endif
+
+/*───────────────────────────────   NEON   ───────────────────────────────*/
+#ifdef INK_SIMD_NEON
+struct NeonPair {
+    float32x4_t lo, hi;
+};
+inline NeonPair loadNeon(const float *p) {
+    return {vld1q_f32(p), vld1q_f32(p + 4)};
+}
+inline NeonPair loadNeon(const int8_t *p) {
+    const int16x8_t v = vmovl_s8(vld1_s8(p));
+    return {vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), vcvtq_f32_s32(vmovl_s16(vget_high_s16(v)))};
+}
+
+inline float sumNeon(float32x4_t v) {
+#if defined(__aarch64__) || defined(_M_ARM64)
+    return vaddvq_f32(v);
+#else
+    const float32x2_t s = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+    return vget_lane_f32(vpadd_f32(s, s), 0);
+#endif
+}
+
+template <int R, class T>
+void gemmRowsNeon(const T *w, const float *scales, const float *bias, int r0, int depth,
+                  const float *b, int columns, float *c, bool relu) {
+    float scale[R];
+    for (int i = 0; i < R; ++i)
+        scale[i] = scales ? scales[r0 + i] : 1.0f;
+    const T *rowW = w + static_cast<std::size_t>(r0) * depth;
+    float *rowC = c + static_cast<std::size_t>(r0) * columns;
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+
+    int n = 0;
+    for (; n + 8 <= columns; n += 8) {
+        float32x4_t acc[R][2];
+        for (int i = 0; i < R; ++i)
+            acc[i][0] = acc[i][1] = vdupq_n_f32(bias[r0 + i]);
+        for (int k = 0; k < depth; ++k) {
+            const NeonPair bk = loadNeon(b + static_cast<std::size_t>(k) * columns + n);
+            for (int i = 0; i < R; ++i) {
+                const float wk = float(rowW[static_cast<std::size_t>(i) * depth + k]) * scale[i];
+                acc[i][0] = vmlaq_n_f32(acc[i][0], bk.lo, wk);
+                acc[i][1] = vmlaq_n_f32(acc[i][1], bk.hi, wk);
+            }
+        }
+        for (int i = 0; i < R; ++i) {
+            float *out = rowC + static_cast<std::size_t>(i) * columns + n;
+            vst1q_f32(out, relu ? vmaxq_f32(acc[i][0], zero) : acc[i][0]);
+            vst1q_f32(out + 4, relu ? vmaxq_f32(acc[i][1], zero) : acc[i][1]);
+        }
+    }
+    gemmScalar(rowW, scales ? scales + r0 : nullptr, bias + r0, R, depth, b, columns, rowC, relu,
+               n);
+}
+
+template <int R, class T>
+void gemvRowsNeon(const T *w, const float *scales, const float *bias, int r0, int depth,
+                  const float *x, float *y, bool relu) {
+    const T *rowW = w + static_cast<std::size_t>(r0) * depth;
+    float32x4_t acc[R];
+    for (int i = 0; i < R; ++i)
+        acc[i] = vdupq_n_f32(0.0f);
+    int k = 0;
+    for (; k + 8 <= depth; k += 8) {
+        const NeonPair xk = loadNeon(x + k);
+        for (int i = 0; i < R; ++i) {
+            const NeonPair wk = loadNeon(rowW + static_cast<std::size_t>(i) * depth + k);
+            acc[i] = vmlaq_f32(vmlaq_f32(acc[i], wk.lo, xk.lo), wk.hi, xk.hi);
+        }
+    }
+    for (int i = 0; i < R; ++i) {
+        const T *wi = rowW + static_cast<std::size_t>(i) * depth;
+        const float sum = sumNeon(acc[i]) + dotScalar(wi, x, k, depth);
+        y[r0 + i] = finishRow(sum, scales, bias, r0 + i, relu);
+    }
+}
+#endif
+
+/*─────────────────────────────   dispatch   ─────────────────────────────*/
+template <class T>
+void gemmAny(const T *w, const float *scales, const float *bias, int rows, int depth,
+             const float *b, int columns, float *c, bool relu, SimdLevel level) {
+    switch (level) {
+#ifdef INK_SIMD_AVX2
+    case SimdLevel::avx2:
+        return forRowBlocks(
+                rows,
+                [&](int r) { gemmRowsAvx2<4>(w, scales, bias, r, depth, b, columns, c, relu); },
+                [&](int r) { gemmRowsAvx2<1>(w, scales, bias, r, depth, b, columns, c, relu); });
+#endif
+#ifdef INK_SIMD_SSE2
+    case SimdLevel::sse2:
+        return forRowBlocks(
+                rows,
+                [&](int r) { gemmRowsSse2<4>(w, scales, bias, r, depth, b, columns, c, relu); },
+                [&](int r) { gemmRowsSse2<1>(w, scales, bias, r, depth, b, columns, c, relu); });
+#endif
+#ifdef INK_SIMD_NEON
+    case SimdLevel::neon:
+        return forRowBlocks(
+                rows,
+                [&](int r) { gemmRowsNeon<4>(w, scales, bias, r, depth, b, columns, c, relu); },
+                [&](int r) { gemmRowsNeon<1>(w, scales, bias, r, depth, b, columns, c, relu); });
+#endif
+    default:
+        return gemmScalar(w, scales, bias, rows, depth, b, columns, c, relu, 0);
+    }
+}
+
+template <class T>
+void gemvAny(const T *w, const float *scales, const float *bias, int rows, int depth,
+             const float *x, float *y, bool relu, SimdLevel level) {
+    switch (level) {
+#ifdef INK_SIMD_AVX2
+    case SimdLevel::avx2:
+        return forRowBlocks(
+                rows, [&](int r) { gemvRowsAvx2<4>(w, scales, bias, r, depth, x, y, relu); },
+                [&](int r) { gemvRowsAvx2<1>(w, scales, bias, r, depth, x, y, relu); });
+#endif
+#ifdef INK_SIMD_SSE2
+    case SimdLevel::sse2:
+        return forRowBlocks(
+                rows, [&](int r) { gemvRowsSse2<4>(w, scales, bias, r, depth, x, y, relu); },
+                [&](int r) { gemvRowsSse2<1>(w, scales, bias, r, depth, x, y, relu); });
+#endif
+#ifdef INK_SIMD_NEON
+    case SimdLevel::neon:
+        return forRowBlocks(
+                rows, [&](int r) { gemvRowsNeon<4>(w, scales, bias, r, depth, x, y, relu); },
+                [&](int r) { gemvRowsNeon<1>(w, scales, bias, r, depth, x, y, relu); });
+#endif
+    default:
+        return gemvScalar(w, scales, bias, rows, depth, x, y, relu);
+    }
+}
+}  // namespace
+
+/*──────────────────────────────   kernels   ─────────────────────────────*/
+void CnnKernels::im2col(const float *input, int channels, int height, int width, int kernel,
+                        int stride, int padding, float *cols) {
+    const int outHeight = (height + 2 * padding - kernel) / stride + 1;
+    const int outWidth = (width + 2 * padding - kernel) / stride + 1;
+    for (int c = 0; c < channels; ++c) {
+        const float *plane = input + static_cast<std::size_t>(c) * height * width;
+        for (int ky = 0; ky < kernel; ++ky) {
+            for (int kx = 0; kx < kernel; ++kx) {
+                // Output columns whose input column is inside the image.
+                const int firstX = std::max(0, (padding - kx + stride - 1) / stride);
+                const int lastX =
+                        std::min(outWidth, (width + padding - kx + stride - 1) / stride);
+                for (int oy = 0; oy < outHeight; ++oy) {
+                    const int iy = oy * stride + ky - padding;
+                    if (iy < 0 || iy >= height || firstX >= lastX) {
+                        std::fill(cols, cols + outWidth, 0.0f);
+                    } else {
+                        const float *src = plane + static_cast<std::size_t>(iy) * width;
+                        std::fill(cols, cols + firstX, 0.0f);
+                        if (stride == 1) {
+                            std::memcpy(cols + firstX, src + firstX + kx - padding,
+                                        sizeof(float) * (lastX - firstX));
+                        } else {
+                            for (int ox = firstX; ox < lastX; ++ox)
+                                cols[ox] = src[ox * stride + kx - padding];
+                        }
+                        std::fill(cols + lastX, cols + outWidth, 0.0f);
+                    }
+                    cols += outWidth;
+                }
+            }
+        }
+    }
+}
+
+void CnnKernels::gemm(const float *w, const float *bias, int rows, int depth, const float *b,
+                      int columns, float *c, bool relu, SimdLevel level) {
+    gemmAny(w, static_cast<const float *>(nullptr), bias, rows, depth, b, columns, c, relu, level);
+}
+
+void CnnKernels::gemm(const int8_t *w, const float *scales, const float *bias, int rows,
+                      int depth, const float *b, int columns, float *c, bool relu,
+                      SimdLevel level) {
+    gemmAny(w, scales, bias, rows, depth, b, columns, c, relu, level);
+}
+
+void CnnKernels::gemv(const float *w, const float *bias, int rows, int depth, const float *x,
+                      float *y, bool relu, SimdLevel level) {
+    gemvAny(w, static_cast<const float *>(nullptr), bias, rows, depth, x, y, relu, level);
+}
+
+void CnnKernels::gemv(const int8_t *w, const float *scales, const float *bias, int rows,
+                      int depth, const float *x, float *y, bool relu, SimdLevel level) {
+    gemvAny(w, scales, bias, rows, depth, x, y, relu, level);
+}
+
+void CnnKernels::relu(float *x, std::size_t count, SimdLevel level) {
+#ifdef INK_SIMD_AVX2
+    if (level == SimdLevel::avx2)
+        return reluAvx2(x, count);
+#endif
+    (void)level;  // the loop below vectorizes well enough at the baseline width
+    for (std::size_t i = 0; i < count; ++i)
+        x[i] = std::max(x[i], 0.0f);
+}
+
+void CnnKernels::maxPool(const float *input, int channels, int height, int width, int size,
+                         float *out) {
+    const int outHeight = height / size;
+    const int outWidth = width / size;
+    for (int c = 0; c < channels; ++c) {
+        const float *plane = input + static_cast<std::size_t>(c) * height * width;
+        for (int oy = 0; oy < outHeight; ++oy) {
+            const float *top = plane + static_cast<std::size_t>(oy) * size * width;
+            for (int ox = 0; ox < outWidth; ++ox) {
+                float m = top[ox * size];
+                for (int y = 0; y < size; ++y) {
+                    const float *row = top + static_cast<std::size_t>(y) * width + ox * size;
+                    for (int x = 0; x < size; ++x)
+                        m = std::max(m, row[x]);
+                }
+                *out++ = m;
+            }
+        }
+    }
+}
+
+void CnnKernels::softmax(float *x, std::size_t count) {
+    if (count == 0)
+        return;
+    const float m = *std::max_element(x, x + count);
+    float sum = 0.0f;
+    for (std::size_t i = 0; i < count; ++i) {
+        x[i] = std::exp(x[i] - m);
+        sum += x[i];
+    }
+    const float inv = 1.0f / sum;
+    for (std::size_t i = 0; i < count; ++i)
+        x[i] *= inv;
+}
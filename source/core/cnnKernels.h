@@ -0,0 +1,43 @@
+#pragma once
+
+#include "simdLevel.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Layer kernels behind TinyCnn::forward(). Activations are float,
+// channel-major (CHW); weights are float or int8 with one scale per output
+// row (w = scale * q). Each kernel has scalar, SSE2, AVX2 and NEON paths;
+// they differ only in the order floats are summed. None allocates.
+namespace CnnKernels {
+
+// Patch matrix for a square convolution: row (c * k + ky) * k + kx, column
+// oy * outWidth + ox holds input(c, oy * stride + ky - padding,
+// ox * stride + kx - padding), zero outside the image.
+void im2col(const float *input, int channels, int height, int width, int kernel, int stride,
+            int padding, float *cols);
+
+// c[r][n] = bias[r] + sum_k w[r][k] * b[k][n] for r < rows, n < columns:
+// a convolution's output channels from its im2col matrix (depth rows).
+// relu clamps c at zero.
+void gemm(const float *w, const float *bias, int rows, int depth, const float *b, int columns,
+          float *c, bool relu, SimdLevel level);
+void gemm(const int8_t *w, const float *scales, const float *bias, int rows, int depth,
+          const float *b, int columns, float *c, bool relu, SimdLevel level);
+
+// y[r] = bias[r] + sum_k w[r][k] * x[k]: a dense layer.
+void gemv(const float *w, const float *bias, int rows, int depth, const float *x, float *y,
+          bool relu, SimdLevel level);
+void gemv(const int8_t *w, const float *scales, const float *bias, int rows, int depth,
+          const float *x, float *y, bool relu, SimdLevel level);
+
+void relu(float *x, std::size_t count, SimdLevel level);
+
+// Non-overlapping size x size max pooling of each channel; a partial
+// window at the right or bottom edge is dropped.
+void maxPool(const float *input, int channels, int height, int width, int size, float *out);
+
+// In place; subtracts the maximum first so large logits do not overflow.
+void softmax(float *x, std::size_t count);
+
+}  // namespace CnnKernels
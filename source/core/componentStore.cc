@@ -0,0 +1,125 @@
+#include "componentStore.h"
+
+#include <utility>
+
+EntityHandle ComponentStore::create(const BodyDesc &desc, GameObject *ownerObject) {
+    uint32_t slot;
+    if (!m_freeSlots.empty()) {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(m_sparseToDense.size());
+        m_sparseToDense.push_back(0);
+        m_generation.push_back(0);
+    }
+
+    auto dense = static_cast<uint32_t>(size());
+    position.push_back(desc.position);
+    velocity.push_back(desc.velocity);
+    scale.push_back(desc.scale);
+    hitboxSize.push_back(desc.hitboxSize);
+    bounds.push_back(Hitbox(desc.hitboxSize, desc.position).bounds());
+    mass.push_back(desc.mass);
+    speed.push_back(desc.speed);
+    flags.push_back(desc.flags);
+    owner.push_back(ownerObject);
+    denseToSparse.push_back(slot);
+    m_sparseToDense[slot] = dense;
+
+    // Keep dynamic bodies packed in front of the statics.
+    if (!(desc.flags & BodyFlags::isStatic)) {
+        const auto boundary = static_cast<uint32_t>(m_dynamicCount);
+        if (dense != boundary)
+            swapDense(dense, boundary);
+        ++m_dynamicCount;
+    }
+    return {slot, m_generation[slot]};
+}
+
+void ComponentStore::destroy(EntityHandle handle) {
+    if (!isAlive(handle))
+        return;
+
+    uint32_t dense = denseIndex(handle);
+    const auto last = static_cast<uint32_t>(size() - 1);
+    if (dense < m_dynamicCount) {
+        // Move the hole to the end of the dynamic block, then past the statics.
+        const auto lastDynamic = static_cast<uint32_t>(m_dynamicCount - 1);
+        swapDense(dense, lastDynamic);
+        swapDense(lastDynamic, last);
+        --m_dynamicCount;
+    } else {
+        swapDense(dense, last);
+    }
+    popBack();
+
+    ++m_generation[handle.index];
+    m_freeSlots.push_back(handle.index);
+}
+
+void ComponentStore::clear() {
+    position.clear();
+    velocity.clear();
+    scale.clear();
+    hitboxSize.clear();
+    bounds.clear();
+    mass.clear();
+    speed.clear();
+    flags.clear();
+    owner.clear();
+    denseToSparse.clear();
+    // Bump generations so stale handles stay invalid after a clear.
+    m_freeSlots.clear();
+    for (uint32_t slot = 0; slot < m_generation.size(); ++slot) {
+        ++m_generation[slot];
+        m_freeSlots.push_back(slot);
+    }
+    m_dynamicCount = 0;
+}
+
+void ComponentStore::reserve(std::size_t count) {
+    position.reserve(count);
+    velocity.reserve(count);
+    scale.reserve(count);
+    hitboxSize.reserve(count);
+    bounds.reserve(count);
+    mass.reserve(count);
+    speed.reserve(count);
+    flags.reserve(count);
+    owner.reserve(count);
+    denseToSparse.reserve(count);
+}
+
+bool ComponentStore::isAlive(EntityHandle handle) const {
+    return handle.index < m_generation.size() && m_generation[handle.index] == handle.generation;
+}
+
+void ComponentStore::swapDense(uint32_t a, uint32_t b) {
+    if (a == b)
+        return;
+    std::swap(position[a], position[b]);
+    std::swap(velocity[a], velocity[b]);
+    std::swap(scale[a], scale[b]);
+    std::swap(hitboxSize[a], hitboxSize[b]);
+    std::swap(bounds[a], bounds[b]);
+    std::swap(mass[a], mass[b]);
+    std::swap(speed[a], speed[b]);
+    std::swap(flags[a], flags[b]);
+    std::swap(owner[a], owner[b]);
+    std::swap(denseToSparse[a], denseToSparse[b]);
+    m_sparseToDense[denseToSparse[a]] = a;
+    m_sparseToDense[denseToSparse[b]] = b;
+}
+
+void ComponentStore::popBack() {
+    position.pop_back();
+    velocity.pop_back();
+    scale.pop_back();
+    hitboxSize.pop_back();
+    bounds.pop_back();
+    mass.pop_back();
+    speed.pop_back();
+    flags.pop_back();
+    owner.pop_back();
+    denseToSparse.pop_back();
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "entities/hitbox.h"
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+class GameObject;
+
+/// Stable reference to a body in a ComponentStore. The generation guards
+/// against reusing a handle after its body was destroyed and the slot recycled.
+struct EntityHandle {
+    static constexpr uint32_t kInvalid = 0xffffffffu;
+
+    uint32_t index = kInvalid;  // slot in the sparse table, stable for the body's lifetime
+    uint32_t generation = 0;
+
+    bool isValid() const {
+        return index != kInvalid;
+    }
+    bool operator==(const EntityHandle &o) const {
+        return index == o.index && generation == o.generation;
+    }
+    bool operator!=(const EntityHandle &o) const {
+        return !(*this == o);
+    }
+};
+
+/// Per-body behaviour bits, fixed when the body is created (except hitboxActive).
+namespace BodyFlags {
+enum : uint8_t {
+    collides = 1 << 0,          // GameObject::hasCollision
+    movesOnCollision = 1 << 1,  // GameObject::shouldMoveOnCollision
+    isStatic = 1 << 2,          // GameObject::isStatic; lives in the static partition
+    hitboxActive = 1 << 3,      // Hitbox::isActive
+};
+}
+
+/// Everything needed to create a body; also the storage a GameObject uses
+/// before it is added to an EntityManager.
+struct BodyDesc {
+    glm::vec3 position = glm::vec3(0.0f);
+    glm::vec2 velocity = glm::vec2(0.0f);
+    glm::vec2 scale = glm::vec2(1.0f);
+    glm::vec2 hitboxSize = glm::vec2(1.0f);
+    float mass = 0.0f;   // 0 ⇒ not affected by gravity
+    float speed = 1.0f;  // velocity multiplier used by the integrate pass
+    uint8_t flags = BodyFlags::hitboxActive;
+};
+
+/**
+ * Structure-of-arrays storage for every body in the simulation.
+ *
+ * All component arrays share one dense index. Dynamic bodies are packed at
+ * the front ([0, dynamicCount())) and static bodies after them, so per-tick
+ * passes only walk the dynamic prefix. Removal swaps the last element of a
+ * partition into the hole, so dense indices are not stable; keep handles.
+ */
+class ComponentStore {
+public:
+    EntityHandle create(const BodyDesc &desc, GameObject *owner = nullptr);
+    void destroy(EntityHandle handle);
+    void clear();
+    void reserve(std::size_t count);
+
+    bool isAlive(EntityHandle handle) const;
+    /// Dense index of a live handle.
+    uint32_t denseIndex(EntityHandle handle) const {
+        return m_sparseToDense[handle.index];
+    }
+    /// Dense index from a sparse slot alone (broadphase ids are sparse slots).
+    uint32_t denseIndexOfSlot(uint32_t slot) const {
+        return m_sparseToDense[slot];
+    }
+    EntityHandle handleAt(uint32_t dense) const {
+        return {denseToSparse[dense], m_generation[denseToSparse[dense]]};
+    }
+
+    std::size_t size() const {
+        return position.size();
+    }
+    std::size_t dynamicCount() const {
+        return m_dynamicCount;
+    }
+
+    /*───── dense component arrays ─────────────────────────────────────────*/
+    std::vector<glm::vec3> position;
+    std::vector<glm::vec2> velocity;
+    std::vector<glm::vec2> scale;
+    std::vector<glm::vec2> hitboxSize;
+    std::vector<Aabb> bounds;  // world AABB, refreshed by the hitbox-sync pass
+    std::vector<float> mass;
+    std::vector<float> speed;
+    std::vector<uint8_t> flags;
+    std::vector<GameObject *> owner;       // nullptr for bare bodies
+    std::vector<uint32_t> denseToSparse;   // sparse slot of each dense entry
+
+private:
+    void swapDense(uint32_t a, uint32_t b);
+    void popBack();
+
+    std::vector<uint32_t> m_sparseToDense;
+    std::vector<uint32_t> m_generation;
+    std::vector<uint32_t> m_freeSlots;
+    std::size_t m_dynamicCount = 0;
+};
@@ -0,0 +1,55 @@
+#include "drawnPlatform.h"
+
+#include <algorithm>
+
+namespace {
+struct StrokeBounds {
+    glm::vec2 min;
+    glm::vec2 max;
+};
+
+StrokeBounds boundsFromPoints(const std::vector<glm::vec2>& points) {
+    StrokeBounds bounds{points.front(), points.front()};
+    for (const auto& p : points) {
+        bounds.min.x = std::min(bounds.min.x, p.x);
+        bounds.min.y = std::min(bounds.min.y, p.y);
+        bounds.max.x = std::max(bounds.max.x, p.x);
+        bounds.max.y = std::max(bounds.max.y, p.y);
+    }
+    return bounds;
+}
+
+glm::vec2 normalizedToView(const glm::vec2& n) {
+    constexpr float kLeft = -2.0f;
+    constexpr float kRight = 2.0f;
+    constexpr float kBottom = -1.5f;
+    constexpr float kTop = 1.5f;
+    const float x = kLeft + n.x * (kRight - kLeft);
+    const float y = kTop - n.y * (kTop - kBottom);
+    return {x, y};
+}
+
+StrokeBounds expandBoundsForMinSize(const std::vector<glm::vec2>& points, float minSize) {
+    StrokeBounds bounds = boundsFromPoints(points);
+    const glm::vec2 center = (bounds.min + bounds.max) * 0.5f;
+    const float w = std::max(bounds.max.x - bounds.min.x, minSize);
+    const float h = std::max(bounds.max.y - bounds.min.y, minSize);
+
+    bounds.min = center - glm::vec2(w * 0.5f, h * 0.5f);
+    bounds.max = center + glm::vec2(w * 0.5f, h * 0.5f);
+
+    bounds.min = glm::clamp(bounds.min, glm::vec2(0.0f), glm::vec2(1.0f));
+    bounds.max = glm::clamp(bounds.max, glm::vec2(0.0f), glm::vec2(1.0f));
+    return bounds;
+}
+}  // namespace
+
+DrawnPlatform placeDrawnPlatform(const std::vector<glm::vec2> &points, const glm::vec3 &focus) {
+    constexpr float kMinStrokeSize = 0.03f;
+    const auto bounds = expandBoundsForMinSize(points, kMinStrokeSize);
+    const glm::vec2 vmin = normalizedToView(bounds.min);
+    const glm::vec2 vmax = normalizedToView(bounds.max);
+    const glm::vec2 centerView = (vmin + vmax) * 0.5f;
+    const glm::vec2 centerWorld = centerView + glm::vec2(focus.x, focus.y);
+    return {glm::vec3(centerWorld, 0.0f), glm::abs(vmax - vmin)};
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+
+// Where a platform drawn with the mouse goes: the stroke's bounding box
+// (window-normalized, grown to a minimum size) mapped into the camera view
+// centred on `focus`. `points` must not be empty.
+struct DrawnPlatform {
+    glm::vec3 position;
+    glm::vec2 size;
+};
+
+DrawnPlatform placeDrawnPlatform(const std::vector<glm::vec2> &points, const glm::vec3 &focus);
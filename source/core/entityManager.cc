@@ -1,37 +1,141 @@
-#define GLFW_INCLUDE_NONE
 #include "entityManager.h"
+#include "physicsSystems.h"
+#include "profiler.h"
+
+#include <algorithm>
 
 EntityManager *EntityManager::instance() {
     static EntityManager s;  // Meyers singleton
     return &s;
 }
 
+EntityManager::EntityManager(BroadphaseType broadphase)
+    : m_broadphase(Broadphase::create(broadphase)) {
+}
+
+void EntityManager::registerEntity(GameObject &entity) {
+    entity.attach(&m_store, spawnBody(entity.bodyDesc(), &entity));
+}
+
+EntityHandle EntityManager::spawnBody(const BodyDesc &desc, GameObject *owner) {
+    const EntityHandle handle = m_store.create(desc, owner);
+    if ((desc.flags & BodyFlags::isStatic) && (desc.flags & BodyFlags::hitboxActive)) {
+        m_broadphase->addStatic(handle.index, m_store.bounds[m_store.denseIndex(handle)]);
+    }
+    return handle;
+}
+
+void EntityManager::spawnStaticSprites(const StaticSprite *sprites, std::size_t count,
+                                       EntityHandle *handles) {
+    m_store.reserve(m_store.size() + count);
+    m_staticItems.reserve(m_staticItems.size() + count);
+    std::vector<BroadphaseProxy> proxies;
+    proxies.reserve(count);
+
+    BodyDesc desc;
+    desc.flags = BodyFlags::hitboxActive | BodyFlags::collides | BodyFlags::isStatic;
+    for (std::size_t i = 0; i < count; ++i) {
+        const StaticSprite &s = sprites[i];
+        desc.position = s.position;
+        desc.scale = desc.hitboxSize = s.scale;
+        const EntityHandle handle = m_store.create(desc);
+        proxies.push_back({handle.index, m_store.bounds[m_store.denseIndex(handle)]});
+
+        if (m_staticItemOfSlot.size() <= handle.index)
+            m_staticItemOfSlot.resize(handle.index + 1);
+        m_staticItemOfSlot[handle.index] = static_cast<uint32_t>(m_staticItems.size());
+        m_staticItems.push_back(
+                {handle.index, 0u, s.mesh, s.position, glm::vec3(s.scale, 1.0f), s.uvRect});
+        if (handles)
+            handles[i] = handle;
+    }
+    m_broadphase->addStatics(proxies.data(), proxies.size());
+}
+
+void EntityManager::removeStaticSprites(const EntityHandle *handles, std::size_t count) {
+    std::vector<uint32_t> slots;
+    slots.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const EntityHandle handle = handles[i];
+        if (!m_store.isAlive(handle))
+            continue;
+        slots.push_back(handle.index);
+        m_store.destroy(handle);
+
+        // Swap-remove the render item; the moved one's slot points at its new place.
+        const uint32_t at = m_staticItemOfSlot[handle.index];
+        m_staticItems[at] = m_staticItems.back();
+        m_staticItemOfSlot[m_staticItems[at].id] = at;
+        m_staticItems.pop_back();
+    }
+    std::sort(slots.begin(), slots.end());
+    m_broadphase->removeStatics(slots);
+}
+
+Mesh *EntityManager::retainMesh(std::shared_ptr<Mesh> mesh) {
+    m_retainedMeshes.push_back(std::move(mesh));
+    return m_retainedMeshes.back().get();
+}
+
+void EntityManager::bakeStatic() {
+    m_broadphase->bake();
+}
+
+void EntityManager::setJobSystem(JobSystem *jobs) {
+    m_jobs = jobs;
+    m_broadphase->setJobSystem(jobs);
+}
+
 /*────────────────────────────   update   ────────────────────────────────*/
 void EntityManager::update(float dt) {
-    /* 1. integrate / animate */
-    for (auto &e: m_entities) {
-        e->update(dt);
-    }
-
-    /* 2. naive O(N²) narrow-phase collision */
-    const std::size_t n = m_entities.size();
-    for (std::size_t i = 0; i < n; ++i) {
-        for (std::size_t j = i + 1; j < n; ++j) {
-            GameObject &a = *m_entities[i];
-            GameObject &b = *m_entities[j];
-
-            if (!a.hasCollision() && !b.hasCollision() ||
-                (!a.hitbox.intersects(b.hitbox) && !b.hitbox.intersects(a.hitbox))) {
-                continue;
-            }
-
-            if (a.shouldMoveOnCollision()) {
-                a.resolveCollision(&b);
-            }
-            if (b.shouldMoveOnCollision()) {
-                b.resolveCollision(&a);
-            }
-        }
+    /* 1. gameplay hooks (static bodies never change) */
+    for (std::size_t i = 0; i < m_store.dynamicCount(); ++i) {
+        if (GameObject *obj = m_store.owner[i])
+            obj->update(dt);
+    }
+
+    /* 2. integrate, then refresh world AABBs */
+    {
+        INK_PROFILE_SCOPE("integrate");
+        Systems::integrate(m_store, dt, m_jobs);
+        Systems::syncHitboxes(m_store, m_jobs);
+    }
+
+    /* 3. broad-phase: statics are already in place, re-submit movers */
+    {
+        INK_PROFILE_SCOPE("broadphase");
+        Systems::gatherMovers(m_store, m_movers);
+        m_broadphase->setDynamic(m_movers);
+        m_broadphase->collectPairs(m_pairs);
+    }
+
+    /* 4. narrow-phase on candidate pairs, in (slot a, slot b) order */
+    m_stats = {};
+    m_stats.statics = m_store.size() - m_store.dynamicCount();
+    m_stats.movers = m_movers.size();
+    m_stats.candidatePairs = m_pairs.size();
+    {
+        INK_PROFILE_SCOPE("collision");
+        m_stats.contacts = Systems::collide(m_store, m_pairs);
+    }
+
+    /* 5. hand the results to the renderer */
+    Systems::syncRenderObjects(m_store);
+}
+
+/*───────────────────────────   snapshot   ───────────────────────────────*/
+void EntityManager::buildRenderSnapshot(RenderSnapshot &out) const {
+    // Static level sprites never change: one bulk copy, drawn first.
+    out.items.assign(m_staticItems.begin(), m_staticItems.end());
+    out.items.reserve(m_staticItems.size() + m_entities.size());
+    for (const auto &e: m_entities) {
+        const SceneObject *obj = e->renderObject.get();
+        if (!obj || !obj->m_mesh)
+            continue;  // skip entities without render objects.
+        out.items.push_back({e->handle().index,
+                             obj->m_screenSpace ? uint32_t(RenderItem::screenSpace) : 0u,
+                             obj->m_mesh.get(), obj->m_transform.m_position,
+                             obj->m_transform.m_scale, obj->m_uvRect});
     }
 }
 
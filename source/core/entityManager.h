@@ -1,8 +1,10 @@
 #pragma once
-#define GLFW_INCLUDE_NONE
 #include "./entities/gameObject.h"
+#include "broadphase.h"
+#include "componentStore.h"
+#include "jobSystem.h"
+#include "renderer/renderSnapshot.h"
 
-#include <GLFW/glfw3.h>
 #include <memory>
 #include <type_traits>
 #include <vector>
@@ -12,6 +14,25 @@
  * updates them once per frame, resolves pair-wise collisions,
  * and then draws them.
  *
+ * Body data lives in a ComponentStore (structure-of-arrays, addressed by
+ * generation-checked EntityHandles); the GameObjects returned by add<T>()
+ * are façades over it. Each tick runs store-wide passes from Systems:
+ * gameplay update() for dynamic owners, integrate, hitbox sync, broadphase,
+ * collide, render-object sync.
+ *
+ * Bodies are split into two partitions when added:
+ *   - static  (GameObject::isStatic): never updated, inserted into the
+ *     broadphase once; bakeStatic() freezes them after level load.
+ *   - dynamic: updated every tick and re-submitted to the broadphase.
+ * Collision runs in two phases: a Broadphase (spatial hash or
+ * sweep-and-prune, chosen at construction) yields dynamic-vs-all candidate
+ * pairs, then the collide pass does the exact test and resolution.
+ *
+ * With a JobSystem attached (setJobSystem), integration, hitbox sync and
+ * broadphase queries are spread over its workers; gameplay update() hooks
+ * and collision resolution stay serial, so a tick gives bit-identical
+ * results for any worker count.
+ *
  * Usage:
  *   auto& em = entityManager_t::instance();
  *   em.add<character_t>(args…);        // spawn something
@@ -20,17 +41,59 @@
  */
 class EntityManager {
 public:
+    /*───── per-tick collision counters ───────────────────────────────────*/
+    struct CollisionStats {
+        std::size_t statics = 0;         // bodies in the static partition
+        std::size_t movers = 0;          // bodies re-submitted to the broadphase
+        std::size_t candidatePairs = 0;  // pairs handed to the narrow-phase
+        std::size_t contacts = 0;        // pairs that actually intersected
+    };
+
     /*───── singleton access ───────────────────────────────────────────────*/
     static EntityManager *instance();
 
+    /*───── standalone managers (tools, benchmarks) ───────────────────────*/
+    explicit EntityManager(BroadphaseType broadphase = BroadphaseType::sweepAndPrune);
+    ~EntityManager() = default;
+
     /*───── factory helper; hides std::make_unique ─────────────────────────*/
     template <class T, class... Args>
     std::shared_ptr<T> add(Args &&...args);
 
+    /*───── bare body, no GameObject needed (benchmarks, bulk level data) ──*/
+    EntityHandle spawnBody(const BodyDesc &desc, GameObject *owner = nullptr);
+
+    /*───── static level sprites: body + drawable, no GameObject ──────────*/
+    struct StaticSprite {
+        glm::vec3 position;
+        glm::vec2 scale;
+        glm::vec4 uvRect;
+        Mesh *mesh;  // see retainMesh()
+    };
+    // Bulk path for cooked levels: one collidable static body and one render
+    // item per sprite, without a GameObject, SceneObject or Mesh each.
+    // `handles`, if given, receives the `count` new bodies.
+    void spawnStaticSprites(const StaticSprite *sprites, std::size_t count,
+                            EntityHandle *handles = nullptr);
+    // Drop sprites made by spawnStaticSprites (streamed chunks leaving).
+    void removeStaticSprites(const EntityHandle *handles, std::size_t count);
+    // Keep `mesh` alive as long as the manager; returns it for StaticSprite.
+    Mesh *retainMesh(std::shared_ptr<Mesh> mesh);
+
     /*───── per-frame hooks ────────────────────────────────────────────────*/
     void update(float dt);
     void draw();
 
+    /*───── call once the level's static bodies are in ────────────────────*/
+    void bakeStatic();
+
+    /*───── flat copy of every drawable for the render thread ─────────────*/
+    // Call on the update thread between ticks; fills out.items only.
+    void buildRenderSnapshot(RenderSnapshot &out) const;
+
+    /*───── parallel passes; nullptr runs everything on the caller ────────*/
+    void setJobSystem(JobSystem *jobs);
+
     /*───── rule of five: keep singleton unique ───────────────────────────*/
     EntityManager(const EntityManager &) = delete;
     EntityManager &operator=(const EntityManager &) = delete;
@@ -41,12 +104,34 @@ public:
     const std::vector<std::shared_ptr<GameObject>> &getEntities() const {
         return m_entities;
     }
+    const CollisionStats &getCollisionStats() const {
+        return m_stats;
+    }
+    BroadphaseType getBroadphaseType() const {
+        return m_broadphase->type();
+    }
+    ComponentStore &components() {
+        return m_store;
+    }
+    const ComponentStore &components() const {
+        return m_store;
+    }
 
 private:
-    EntityManager() = default;
-    ~EntityManager() = default;
+    // Creates the entity's body (static or dynamic partition) and attaches it.
+    void registerEntity(GameObject &entity);
+
+    std::vector<std::shared_ptr<GameObject>> m_entities;  // owners, spawn order
+    std::vector<RenderItem> m_staticItems;                // spawnStaticSprites, unordered
+    std::vector<uint32_t> m_staticItemOfSlot;             // store slot -> m_staticItems index
+    std::vector<std::shared_ptr<Mesh>> m_retainedMeshes;
+    ComponentStore m_store;
 
-    std::vector<std::shared_ptr<GameObject>> m_entities;
+    std::unique_ptr<Broadphase> m_broadphase;
+    JobSystem *m_jobs = nullptr;  // not owned
+    std::vector<BroadphaseProxy> m_movers;  // scratch, rebuilt each tick
+    std::vector<BroadphasePair> m_pairs;    // scratch, rebuilt each tick
+    CollisionStats m_stats;
 };
 
 /*───────────────────────────── template impls ─────────────────────────────*/
@@ -55,6 +140,7 @@ std::shared_ptr<T> EntityManager::add(Args &&...args) {
     static_assert(std::is_base_of_v<GameObject, T>, "T must derive from gameObject_t");
 
     auto ptr = std::make_shared<T>(std::forward<Args>(args)...);
+    registerEntity(*ptr);
     m_entities.emplace_back(ptr);
     return ptr;
 }
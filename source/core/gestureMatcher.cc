@@ -0,0 +1,242 @@
+#include "gestureMatcher.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <utility>
+
+using json = nlohmann::json;
+
+namespace {
+constexpr float kPi = 3.14159265f;
+constexpr float kClosedMax = 0.2f;  // closure below this may be a closed shape...
+constexpr float kOpenMin = 0.1f;    // ...and above this an open one
+
+using Points = std::array<glm::vec2, GestureMatcher::kPoints>;
+using Histogram = std::array<float, GestureMatcher::kTurningBins>;
+
+// Centroid at the origin, longer bounding-box side 1.
+Points normalized(const Points& in) {
+    glm::vec2 centroid(0.0f), lo(in[0]), hi(in[0]);
+    for (const glm::vec2& p: in) {
+        centroid += p;
+        lo = glm::min(lo, p);
+        hi = glm::max(hi, p);
+    }
+    centroid /= float(in.size());
+    const float side = std::max(hi.x - lo.x, hi.y - lo.y);
+    const float scale = side > 0.0f ? 1.0f / side : 1.0f;
+    Points out;
+    for (std::size_t i = 0; i < in.size(); ++i)
+        out[i] = (in[i] - centroid) * scale;
+    return out;
+}
+
+// Mean distance from a[i] to b[(start + i) mod n], or b[(start - i) mod n]
+// walking backwards; gives up once the running sum passes `limit`.
+float pathDistance(const Points& a, const Points& b, std::size_t start, bool backwards,
+                   float limit) {
+    constexpr std::size_t n = GestureMatcher::kPoints;
+    const float sumLimit = limit * n;
+    float sum = 0.0f;
+    for (std::size_t i = 0; i < n && sum < sumLimit; ++i) {
+        const std::size_t j = backwards ? (start + n - i) % n : (start + i) % n;
+        sum += glm::length(a[i] - b[j]);
+    }
+    return sum / n;
+}
+
+// Closed shapes can start anywhere. Matching is orientation-sensitive, so
+// the stroke's first point lines up with the nearest template point; try
+// the starts around it, in both directions.
+float closedDistance(const Points& a, const Points& b, float limit) {
+    constexpr std::size_t n = GestureMatcher::kPoints;
+    std::size_t nearest = 0;
+    float nearestSq = std::numeric_limits<float>::max();
+    for (std::size_t j = 0; j < n; ++j) {
+        const glm::vec2 d = a[0] - b[j];
+        if (glm::dot(d, d) < nearestSq) {
+            nearestSq = glm::dot(d, d);
+            nearest = j;
+        }
+    }
+    float d = limit;
+    for (std::size_t s = nearest + n - 2; s <= nearest + n + 2; ++s) {
+        d = std::min(d, pathDistance(a, b, s % n, false, d));
+        d = std::min(d, pathDistance(a, b, s % n, true, d));
+    }
+    return d;
+}
+
+float histogramDistance(const Histogram& a, const Histogram& b, bool mirrored) {
+    float d = 0.0f;
+    for (int i = 0; i < GestureMatcher::kTurningBins; ++i)
+        d += std::abs(a[i] - b[mirrored ? GestureMatcher::kTurningBins - 1 - i : i]);
+    return d;
+}
+}  // namespace
+
+GestureMatcher::GestureMatcher(Settings settings) : m_settings(settings) {
+}
+
+GestureMatcher::Path GestureMatcher::makePath(const std::vector<glm::vec2>& points) {
+    Path path;
+    if (points.empty())
+        return path;
+    path.empty = false;
+    for (std::size_t i = 1; i < points.size(); ++i)
+        path.length += glm::length(points[i] - points[i - 1]);
+    if (path.length <= 0.0f) {
+        path.points.fill(points[0]);
+        return path;
+    }
+
+    // Walk the polyline, dropping a point every `step` of arc length.
+    const float step = path.length / float(kPoints - 1);
+    path.points[0] = points[0];
+    std::size_t count = 1;
+    float carried = 0.0f;  // arc length since the last point dropped
+    for (std::size_t i = 1; i < points.size() && count < kPoints; ++i) {
+        glm::vec2 a = points[i - 1];
+        const glm::vec2 b = points[i];
+        float segment = glm::length(b - a);
+        while (carried + segment >= step && count < kPoints) {
+            const float t = (step - carried) / segment;
+            a += t * (b - a);
+            path.points[count++] = a;
+            segment -= step - carried;
+            carried = 0.0f;
+        }
+        carried += segment;
+    }
+    while (count < kPoints)  // rounding can leave the last one short
+        path.points[count++] = points.back();
+    return path;
+}
+
+GestureMatcher::Features GestureMatcher::features(const Path& path) {
+    Features f;
+    if (path.empty)
+        return f;
+    const Points& p = path.points;
+    f.length = path.length;
+
+    glm::vec2 lo(p[0]), hi(p[0]);
+    for (const glm::vec2& q: p) {
+        lo = glm::min(lo, q);
+        hi = glm::max(hi, q);
+    }
+    const float longer = std::max(hi.x - lo.x, hi.y - lo.y);
+    const float shorter = std::min(hi.x - lo.x, hi.y - lo.y);
+    const float ends = glm::length(p[kPoints - 1] - p[0]);
+    if (path.length > 0.0f)
+        f.straightness = ends / path.length;
+    if (longer > 0.0f) {
+        f.closure = ends / longer;
+        f.aspect = shorter / longer;
+    }
+
+    for (std::size_t i = 1; i + 1 < kPoints; ++i) {
+        const glm::vec2 u = p[i] - p[i - 1], v = p[i + 1] - p[i];
+        const float angle = std::atan2(u.x * v.y - u.y * v.x, glm::dot(u, v));
+        f.turning += std::abs(angle);
+        const int bin = int((angle + kPi) / (2.0f * kPi) * kTurningBins);
+        f.turningHistogram[std::min(bin, kTurningBins - 1)] += 1.0f / float(kPoints - 2);
+    }
+    return f;
+}
+
+bool GestureMatcher::load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "[GestureMatcher] Failed to open template file: " << path << std::endl;
+        return false;
+    }
+    GestureMatcher loaded(m_settings);
+    try {
+        json file;
+        in >> file;
+        for (const auto& t: file.at("templates")) {
+            std::vector<glm::vec2> points;
+            for (const auto& p: t.at("points"))
+                points.emplace_back(p.at(0).get<float>(), p.at(1).get<float>());
+            loaded.addTemplate(t.at("label").get<std::string>(), points,
+                               t.value("closed", false));
+        }
+    } catch (const json::exception& e) {
+        std::cerr << "[GestureMatcher] Bad template file " << path << ": " << e.what()
+                  << std::endl;
+        return false;
+    }
+    m_templates = std::move(loaded.m_templates);
+    return true;
+}
+
+void GestureMatcher::addTemplate(const std::string& label, const std::vector<glm::vec2>& points,
+                                 bool closed) {
+    const Path path = makePath(points);
+    if (path.empty || path.length <= 0.0f)
+        return;
+    Template t;
+    t.label = label;
+    t.closed = closed;
+    t.points = normalized(path.points);
+    t.turningHistogram = features(path).turningHistogram;
+    m_templates.push_back(std::move(t));
+}
+
+std::optional<Recognizer::Prediction> GestureMatcher::match(const Path& path) const {
+    if (path.empty)
+        return std::nullopt;
+    const Features f = features(path);
+    if (f.length < m_settings.dotLength)
+        return Recognizer::Prediction{"dot", 0.9f};
+
+    if (f.straightness >= m_settings.lineStraightness) {
+        const glm::vec2 d = glm::abs(path.points[kPoints - 1] - path.points[0]);
+        const float degrees = std::atan2(d.y, d.x) * 180.0f / kPi;
+        if (degrees <= m_settings.lineAngleDegrees)
+            return Recognizer::Prediction{"horizontal", f.straightness};
+        if (degrees >= 90.0f - m_settings.lineAngleDegrees)
+            return Recognizer::Prediction{"vertical", f.straightness};
+        return Recognizer::Prediction{"diagonal", f.straightness};
+    }
+
+    // The best label, and the best distance of any other label.
+    const Points points = normalized(path.points);
+    const float limit = m_settings.maxDistance * m_settings.minMargin;
+    const std::string* label = nullptr;
+    float best = std::numeric_limits<float>::max(), runnerUp = best;
+    for (const Template& t: m_templates) {
+        if (t.closed ? f.closure > kClosedMax : f.closure < kOpenMin)
+            continue;
+        const float forward = histogramDistance(f.turningHistogram, t.turningHistogram, false);
+        const float backward = histogramDistance(f.turningHistogram, t.turningHistogram, true);
+        if (std::min(forward, backward) > m_settings.maxHistogramDistance)
+            continue;
+
+        float d;
+        if (t.closed) {
+            d = closedDistance(points, t.points, limit);
+        } else {
+            d = pathDistance(points, t.points, 0, false, limit);
+            d = std::min(d, pathDistance(points, t.points, kPoints - 1, true, std::min(d, limit)));
+        }
+        if (label && *label == t.label) {
+            best = std::min(best, d);
+        } else if (d < best) {
+            runnerUp = best;  // the old best label beats every other one
+            best = d;
+            label = &t.label;
+        } else {
+            runnerUp = std::min(runnerUp, d);
+        }
+    }
+    if (!label || best > m_settings.maxDistance || runnerUp < best * m_settings.minMargin)
+        return std::nullopt;
+    return Recognizer::Prediction{*label, 1.0f - 0.5f * best / m_settings.maxDistance};
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "recognizer.h"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+// GestureMatcher
+// - Geometric fast path for single strokes: decides simple shapes from the
+//   stroke's points in microseconds, so only ambiguous strokes need the
+//   raster classifier (StrokePreprocess + TinyCnn).
+// - Works on a Path: the stroke resampled to kPoints points evenly spaced
+//   along it, as the $1 recognizer family does.
+// - Dots (short paths) and lines (straight paths: horizontal, vertical or
+//   diagonal in between) are decided from features alone. Anything else
+//   is matched against templates loaded from disk: both translated to
+//   their centroid and scaled by their longer side (orientation and aspect
+//   matter, so a "C" is not a "U"), compared by mean point distance in
+//   either drawing direction, and from every start point for closed
+//   templates. Closure and the turning-angle histogram rule out unlikely
+//   templates first.
+// - match() answers only when the best label is close and clearly ahead
+//   of the runner-up; otherwise std::nullopt, i.e. fall back.
+//
+// Template file (JSON), points in any units, y down:
+//   {"templates": [{"label": "circle", "closed": true,
+//                   "points": [[0.5, 0.0], [0.6, 0.01], ...]}, ...]}
+class GestureMatcher {
+public:
+    static constexpr std::size_t kPoints = 32;
+    static constexpr int kTurningBins = 8;
+
+    struct Path {
+        std::array<glm::vec2, kPoints> points{};
+        float length = 0.0f;  // of the stroke as given
+        bool empty = true;
+    };
+
+    struct Features {
+        float length = 0.0f;
+        float straightness = 1.0f;  // endpoint distance / length
+        float closure = 0.0f;       // endpoint distance / longer box side
+        float aspect = 1.0f;        // shorter box side / longer
+        float turning = 0.0f;       // total absolute turning, radians
+        std::array<float, kTurningBins> turningHistogram{};  // signed angles, sums to 1
+    };
+
+    struct Settings {
+        float dotLength = 0.012f;         // shorter strokes are dots (window widths)
+        float lineStraightness = 0.96f;   // straighter strokes are lines...
+        float lineAngleDegrees = 20.0f;   // ...horizontal or vertical this close, else diagonal
+        float maxDistance = 0.09f;        // mean point distance, longer side = 1
+        float minMargin = 1.4f;           // runner-up label distance / best
+        float maxHistogramDistance = 1.2f;  // L1, of at most 2
+    };
+
+    explicit GestureMatcher(Settings settings);
+    GestureMatcher() : GestureMatcher(Settings{}) {}
+
+    /// `points` (any polyline, e.g. StrokeRecorder's simplified stroke)
+    /// resampled for match(); empty input gives an empty Path.
+    static Path makePath(const std::vector<glm::vec2>& points);
+    static Features features(const Path& path);
+
+    /// Replace the templates with those in `path`; false (and logs, keeping
+    /// the current ones) if the file cannot be read or parsed.
+    bool load(const std::string& path);
+    /// Templates need at least two distinct points; others are ignored.
+    void addTemplate(const std::string& label, const std::vector<glm::vec2>& points,
+                     bool closed);
+    std::size_t templateCount() const { return m_templates.size(); }
+
+    /// A confident label, or std::nullopt to fall back to the raster path.
+    std::optional<Recognizer::Prediction> match(const Path& path) const;
+
+private:
+    using Points = std::array<glm::vec2, kPoints>;
+
+    struct Template {
+        std::string label;
+        bool closed = false;
+        Points points;  // normalized
+        std::array<float, kTurningBins> turningHistogram;
+    };
+
+    Settings m_settings;
+    std::vector<Template> m_templates;
+};
@@ -0,0 +1,87 @@
+// glfwInput.cc
+// GLFW polling and callbacks for the windowed build. Everything here turns
+// window state into GLFW-free values and calls (Character::KeyInput,
+// StrokeRecorder::feed/cursorMoved/buttonChanged), so InkSim never links GLFW.
+#include "entities/character.h"
+#include "strokeRecorder.h"
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+Character::KeyInput Character::readKeyInput() {
+    GLFWwindow *win = glfwGetCurrentContext();
+    KeyInput keys;
+    if (glfwGetKey(win, GLFW_KEY_A) == GLFW_PRESS)
+        keys.moveX -= 1.0f;
+    if (glfwGetKey(win, GLFW_KEY_D) == GLFW_PRESS)
+        keys.moveX += 1.0f;
+    keys.jumpHeld = glfwGetKey(win, GLFW_KEY_SPACE) == GLFW_PRESS;
+    return keys;
+}
+
+void Character::handleMouseInput() {
+    GLFWwindow *win = glfwGetCurrentContext();
+    if (glfwGetMouseButton(win, GLFW_MOUSE_BUTTON_RIGHT) == GLFW_PRESS) {
+        nextDrawMode();
+    }
+}
+
+glm::vec2 StrokeRecorder::normalizeToWindow(GLFWwindow* win, double x, double y) {
+    int w = 1, h = 1;
+    glfwGetWindowSize(win, &w, &h);
+    if (w <= 0) w = 1;
+    if (h <= 0) h = 1;
+    // Origin top-left; y increases downward
+    return glm::vec2(static_cast<float>(x / static_cast<double>(w)),
+                     static_cast<float>(y / static_cast<double>(h)));
+}
+
+void StrokeRecorder::poll() {
+    if (m_attached) return;  // the callbacks already fed this frame's events
+    GLFWwindow* win = glfwGetCurrentContext();
+    if (!win) return;
+
+    const bool pressed = glfwGetMouseButton(win, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS;
+    glm::vec2 point(0.0f);
+    if (pressed) {
+        double cx = 0.0, cy = 0.0;
+        glfwGetCursorPos(win, &cx, &cy);
+        point = normalizeToWindow(win, cx, cy);
+    }
+    feed(pressed, point, glfwGetTime());
+}
+
+void StrokeRecorder::attach(GLFWwindow* win, bool rawMotion) {
+    int w = 1, h = 1;
+    glfwGetWindowSize(win, &w, &h);
+    windowSizeCallback(win, w, h);
+    double cx = 0.0, cy = 0.0;
+    glfwGetCursorPos(win, &cx, &cy);
+    m_cursor = glm::vec2(static_cast<float>(cx), static_cast<float>(cy)) / m_windowSize;
+
+    if (rawMotion && glfwRawMouseMotionSupported())
+        glfwSetInputMode(win, GLFW_RAW_MOUSE_MOTION, GLFW_TRUE);
+    glfwSetWindowSizeCallback(win, windowSizeCallback);
+    glfwSetCursorPosCallback(win, cursorPosCallback);
+    glfwSetMouseButtonCallback(win, mouseButtonCallback);
+    m_attached = true;
+}
+
+// The callbacks only normalize; the window size is cached because querying
+// it can be a round trip to the window system, once per motion event.
+void StrokeRecorder::windowSizeCallback(GLFWwindow*, int w, int h) {
+    instance()->m_windowSize = glm::vec2(static_cast<float>(w > 0 ? w : 1),
+                                         static_cast<float>(h > 0 ? h : 1));
+}
+
+void StrokeRecorder::cursorPosCallback(GLFWwindow*, double x, double y) {
+    StrokeRecorder* r = instance();
+    r->cursorMoved(glm::vec2(static_cast<float>(x / r->m_windowSize.x),
+                             static_cast<float>(y / r->m_windowSize.y)),
+                   glfwGetTime());
+}
+
+void StrokeRecorder::mouseButtonCallback(GLFWwindow*, int button, int action, int) {
+    if (button != GLFW_MOUSE_BUTTON_LEFT || action == GLFW_REPEAT) return;
+    instance()->buttonChanged(action == GLFW_PRESS, glfwGetTime());
+}
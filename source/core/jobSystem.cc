@@ -0,0 +1,107 @@
+#include "jobSystem.h"
+#include "profiler.h"
+
+#include <algorithm>
+
+JobSystem::JobSystem(unsigned workerCount) {
+    if (workerCount == 0)
+        workerCount = std::max(1u, std::thread::hardware_concurrency());
+
+    for (unsigned i = 0; i < workerCount; ++i)
+        m_queues.push_back(std::make_unique<Queue>());
+    for (unsigned i = 1; i < workerCount; ++i)
+        m_threads.emplace_back(&JobSystem::workerLoop, this, i);
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_quit = true;
+    }
+    m_wake.notify_all();
+    for (auto &t: m_threads)
+        t.join();
+}
+
+void JobSystem::parallelFor(std::size_t count, std::size_t grain, const RangeFn &fn) {
+    const std::size_t chunks = chunkCount(count, grain);
+    if (chunks == 0)
+        return;
+    if (chunks == 1 || m_queues.size() == 1) {
+        for (std::size_t begin = 0; begin < count; begin += grain)
+            fn(begin, std::min(count, begin + grain));
+        return;
+    }
+
+    Batch batch;
+    batch.fn = &fn;
+    batch.remaining.store(chunks, std::memory_order_relaxed);
+
+    // Count first so a worker that pops a chunk early never sees m_queued wrap.
+    m_queued.fetch_add(chunks, std::memory_order_relaxed);
+
+    // Deal chunks round-robin so every worker starts with local work.
+    const std::size_t workers = m_queues.size();
+    for (std::size_t w = 0; w < workers; ++w) {
+        Queue &q = *m_queues[w];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        for (std::size_t c = w; c < chunks; c += workers) {
+            const std::size_t begin = c * grain;
+            q.tasks.push_back({&batch, begin, std::min(count, begin + grain)});
+        }
+    }
+    {
+        // Pairs with the predicate check in workerLoop so no wake-up is lost.
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_wake.notify_all();
+
+    while (batch.remaining.load(std::memory_order_acquire) != 0) {
+        if (!runOne(0))
+            std::this_thread::yield();
+    }
+}
+
+bool JobSystem::runOne(unsigned self) {
+    Task task{};
+    bool found = false;
+    {
+        Queue &own = *m_queues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            found = true;
+        }
+    }
+    for (std::size_t k = 1; !found && k < m_queues.size(); ++k) {
+        Queue &victim = *m_queues[(self + k) % m_queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            found = true;
+        }
+    }
+    if (!found)
+        return false;
+
+    m_queued.fetch_sub(1, std::memory_order_relaxed);
+    (*task.batch->fn)(task.begin, task.end);
+    task.batch->remaining.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+void JobSystem::workerLoop(unsigned self) {
+    INK_PROFILE_THREAD("job worker");
+    for (;;) {
+        if (runOne(self))
+            continue;
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wake.wait(lock, [this] {
+            return m_quit || m_queued.load(std::memory_order_acquire) != 0;
+        });
+        if (m_quit)
+            return;
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Work-stealing scheduler for the fixed-step update.
+ *
+ * Each worker owns a deque: it pops its own work from the back and, when
+ * that runs dry, steals from the front of the others. The thread that calls
+ * parallelFor() takes part as worker 0, so a JobSystem with one worker runs
+ * everything inline and spawns no threads.
+ *
+ * parallelFor() is meant to be called from a single thread (the update
+ * thread); it blocks until every chunk has run. Chunk boundaries depend only
+ * on `count` and `grain`, never on the worker count, so callers that merge
+ * per-chunk results in chunk order get the same output on any machine.
+ */
+class JobSystem {
+public:
+    using RangeFn = std::function<void(std::size_t begin, std::size_t end)>;
+
+    /// `workerCount` includes the calling thread; 0 means one per hardware thread.
+    explicit JobSystem(unsigned workerCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    unsigned workerCount() const {
+        return static_cast<unsigned>(m_queues.size());
+    }
+
+    /// Number of chunks parallelFor(count, grain, …) splits into.
+    static std::size_t chunkCount(std::size_t count, std::size_t grain) {
+        return grain == 0 ? 0 : (count + grain - 1) / grain;
+    }
+
+    /// Run fn(begin, end) over [0, count) in chunks of `grain`, chunk i
+    /// covering [i * grain, min(count, (i + 1) * grain)).
+    void parallelFor(std::size_t count, std::size_t grain, const RangeFn &fn);
+
+private:
+    struct Batch {
+        const RangeFn *fn;
+        std::atomic<std::size_t> remaining{0};
+    };
+    struct Task {
+        Batch *batch;
+        std::size_t begin, end;
+    };
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    bool runOne(unsigned self);
+    void workerLoop(unsigned self);
+
+    std::vector<std::unique_ptr<Queue>> m_queues;  // [0] belongs to the caller
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    std::atomic<std::size_t> m_queued{0};
+    bool m_quit = false;  // guarded by m_sleepMutex
+};
@@ -0,0 +1,142 @@
+#include "levelCooker.h"
+#include "entities/platform.h"
+#include "levelFormat.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <unordered_map>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace {
+// Interns names into the string table, in first-use order.
+struct StringTable {
+    std::vector<std::string> names;
+    std::unordered_map<std::string, uint32_t> index;
+
+    uint32_t intern(const std::string &name) {
+        auto [it, inserted] = index.try_emplace(name, static_cast<uint32_t>(names.size()));
+        if (inserted)
+            names.push_back(name);
+        return it->second;
+    }
+};
+
+uint32_t align4(std::size_t n) {
+    return static_cast<uint32_t>((n + 3) & ~std::size_t(3));
+}
+
+void readFloats(const json &array, float *out, int count) {
+    for (int i = 0; i < count; ++i)
+        out[i] = array[i].get<float>();
+}
+
+template <class T>
+void append(std::vector<char> &out, const T &value) {
+    const char *p = reinterpret_cast<const char *>(&value);
+    out.insert(out.end(), p, p + sizeof(T));
+}
+}  // namespace
+
+bool cookLevel(const std::string &jsonPath, const std::string &outPath) {
+    std::ifstream inFile(jsonPath);
+    if (!inFile) {
+        std::cerr << "[levelCooker] Failed to open level file: " << jsonPath << std::endl;
+        return false;
+    }
+
+    json levelJson;
+    try {
+        inFile >> levelJson;
+    } catch (const json::exception &e) {
+        std::cerr << "[levelCooker] " << jsonPath << ": " << e.what() << std::endl;
+        return false;
+    }
+
+    StringTable strings;
+    std::vector<LevelFormat::PlatformRecord> platforms;
+    std::vector<LevelFormat::CharacterRecord> characters;
+    const uint32_t levelName = strings.intern(levelJson.value("levelName", ""));
+
+    for (const auto &obj: levelJson["objects"]) {
+        if (!obj.contains("type") || !obj.contains("texture") || !obj.contains("position") ||
+            !obj.contains("scale")) {
+            std::cerr << "[levelCooker] Skipping invalid object: missing required fields\n";
+            continue;
+        }
+        const std::string type = obj["type"];
+        const uint32_t texture = strings.intern(obj["texture"].get<std::string>());
+        const auto &pos = obj["position"];
+        const auto &scale = obj["scale"];
+
+        if (type == "platform") {
+            LevelFormat::PlatformRecord r{};
+            readFloats(pos, r.position, 3);
+            readFloats(scale, r.scale, 2);
+            r.texture = texture;
+            // Same mapping as loadLevelFromFile: anything but stationary moves.
+            r.type = static_cast<uint32_t>(obj.value("subtype", "stationary") == "stationary"
+                                                   ? PlatformType::stationary
+                                                   : PlatformType::moving);
+            platforms.push_back(r);
+        } else if (type == "character") {
+            LevelFormat::CharacterRecord r{};
+            readFloats(pos, r.position, 3);
+            readFloats(scale, r.scale, 2);
+            r.speed = obj.value("speed", 2.5f);
+            r.mass = obj.value("mass", 0.2f);
+            r.texture = texture;
+            characters.push_back(r);
+        } else {
+            std::cerr << "[levelCooker] Unknown object type: " << type << std::endl;
+        }
+    }
+
+    // Lay out the sections, then write them in one go.
+    LevelFormat::Header header{};
+    std::memcpy(header.magic, LevelFormat::kMagic, sizeof(header.magic));
+    header.version = LevelFormat::kVersion;
+    header.levelName = levelName;
+    header.platformCount = static_cast<uint32_t>(platforms.size());
+    header.platformOffset = sizeof(LevelFormat::Header);
+    header.characterCount = static_cast<uint32_t>(characters.size());
+    header.characterOffset =
+            header.platformOffset + header.platformCount * sizeof(LevelFormat::PlatformRecord);
+    header.stringCount = static_cast<uint32_t>(strings.names.size());
+    header.stringOffset =
+            header.characterOffset + header.characterCount * sizeof(LevelFormat::CharacterRecord);
+
+    std::vector<char> table;
+    uint32_t nameOffset = header.stringCount * sizeof(uint32_t);
+    for (const std::string &name: strings.names) {
+        append(table, nameOffset);
+        nameOffset += static_cast<uint32_t>(name.size() + 1);
+    }
+    for (const std::string &name: strings.names)
+        table.insert(table.end(), name.c_str(), name.c_str() + name.size() + 1);
+    table.resize(align4(table.size()), '\0');
+    header.fileSize = header.stringOffset + static_cast<uint32_t>(table.size());
+
+    std::vector<char> out;
+    out.reserve(header.fileSize);
+    append(out, header);
+    for (const auto &r: platforms)
+        append(out, r);
+    for (const auto &r: characters)
+        append(out, r);
+    out.insert(out.end(), table.begin(), table.end());
+
+    std::ofstream outFile(outPath, std::ios::binary | std::ios::trunc);
+    if (!outFile.write(out.data(), static_cast<std::streamsize>(out.size()))) {
+        std::cerr << "[levelCooker] Failed to write " << outPath << std::endl;
+        return false;
+    }
+    std::cout << "[levelCooker] " << jsonPath << " -> " << outPath << ": "
+              << header.platformCount << " platforms, " << header.characterCount
+              << " characters, " << header.stringCount << " strings, " << header.fileSize
+              << " bytes\n";
+    return true;
+}
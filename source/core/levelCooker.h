@@ -0,0 +1,8 @@
+#pragma once
+
+#include <string>
+
+/// Convert a JSON level (the authoring format levelLoader reads) into the
+/// cooked binary format of levelFormat.h. Objects the JSON loader would skip
+/// are skipped here too. Returns false (and logs) on any read/write error.
+bool cookLevel(const std::string &jsonPath, const std::string &outPath);
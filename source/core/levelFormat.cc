@@ -0,0 +1,59 @@
+#include "levelFormat.h"
+#include "entities/platform.h"
+
+#include <cstring>
+
+namespace {
+bool sectionFits(uint64_t offset, uint64_t count, uint64_t stride, uint64_t size) {
+    return offset % 4 == 0 && offset <= size && count * stride <= size - offset;
+}
+
+uint32_t stringOffset(const unsigned char *strings, uint32_t index) {
+    uint32_t offset;
+    std::memcpy(&offset, strings + index * sizeof(uint32_t), sizeof(offset));
+    return offset;
+}
+}  // namespace
+
+const char *LevelFormat::View::string(uint32_t index) const {
+    return reinterpret_cast<const char *>(strings + stringOffset(strings, index));
+}
+
+bool LevelFormat::parse(const unsigned char *data, std::size_t size, View &out) {
+    if (size < sizeof(Header))
+        return false;
+    const auto *h = reinterpret_cast<const Header *>(data);
+    if (std::memcmp(h->magic, kMagic, sizeof(kMagic)) != 0 || h->version != kVersion ||
+        h->fileSize != size)
+        return false;
+    if (!sectionFits(h->platformOffset, h->platformCount, sizeof(PlatformRecord), size) ||
+        !sectionFits(h->characterOffset, h->characterCount, sizeof(CharacterRecord), size) ||
+        !sectionFits(h->stringOffset, h->stringCount, sizeof(uint32_t), size) ||
+        h->stringCount == 0)
+        return false;
+
+    out.header = h;
+    out.platforms = reinterpret_cast<const PlatformRecord *>(data + h->platformOffset);
+    out.characters = reinterpret_cast<const CharacterRecord *>(data + h->characterOffset);
+    out.strings = data + h->stringOffset;
+    out.stringBytes = static_cast<uint32_t>(size - h->stringOffset);
+
+    // The table ends in NUL, so every in-range offset names a terminated string.
+    if (out.strings[out.stringBytes - 1] != '\0' || h->levelName >= h->stringCount)
+        return false;
+    for (uint32_t i = 0; i < h->stringCount; ++i) {
+        const uint32_t offset = stringOffset(out.strings, i);
+        if (offset < h->stringCount * sizeof(uint32_t) || offset >= out.stringBytes)
+            return false;
+    }
+    for (uint32_t i = 0; i < h->platformCount; ++i) {
+        if (out.platforms[i].texture >= h->stringCount ||
+            out.platforms[i].type > static_cast<uint32_t>(PlatformType::drawn))
+            return false;
+    }
+    for (uint32_t i = 0; i < h->characterCount; ++i) {
+        if (out.characters[i].texture >= h->stringCount)
+            return false;
+    }
+    return true;
+}
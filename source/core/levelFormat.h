@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Cooked level file (.inkl): the JSON level flattened by tools/level_cooker
+ * so loadCookedLevel() can read it straight out of a file mapping.
+ *
+ *   Header
+ *   PlatformRecord[platformCount]     at platformOffset
+ *   CharacterRecord[characterCount]   at characterOffset
+ *   string table                      at stringOffset: uint32 offsets[stringCount]
+ *                                     (from the table start), then NUL-terminated
+ *                                     names (texture names, level name)
+ *
+ * Every section starts on a 4-byte boundary. Values are in the writer's
+ * byte order (little-endian on everything we ship); a file from a
+ * big-endian writer fails the version check instead of loading garbage.
+ * Bump kVersion whenever a record changes.
+ */
+namespace LevelFormat {
+
+constexpr char kMagic[4] = {'I', 'N', 'K', 'L'};
+constexpr uint32_t kVersion = 1;
+constexpr const char *kExtension = ".inkl";
+
+struct Header {
+    char magic[4];
+    uint32_t version;
+    uint32_t fileSize;  // whole file, for truncation checks
+    uint32_t levelName;  // string index
+    uint32_t platformCount;
+    uint32_t platformOffset;
+    uint32_t characterCount;
+    uint32_t characterOffset;
+    uint32_t stringCount;
+    uint32_t stringOffset;
+};
+
+struct PlatformRecord {
+    float position[3];
+    float scale[2];
+    uint32_t texture;  // string index
+    uint32_t type;     // PlatformType
+};
+
+struct CharacterRecord {
+    float position[3];
+    float scale[2];
+    float speed;
+    float mass;
+    uint32_t texture;  // string index
+};
+
+/// Bounds-checked view of a cooked level in memory (usually a MappedFile).
+struct View {
+    const Header *header = nullptr;
+    const PlatformRecord *platforms = nullptr;
+    const CharacterRecord *characters = nullptr;
+    const unsigned char *strings = nullptr;
+    uint32_t stringBytes = 0;
+
+    /// String `index` of the table; parse() checked it is NUL-terminated.
+    const char *string(uint32_t index) const;
+};
+
+/// Fill `out` from `size` bytes at `data`. False if the bytes are not a
+/// complete, consistent level of this version; every offset and index in a
+/// parsed View is in range.
+bool parse(const unsigned char *data, std::size_t size, View &out);
+
+static_assert(sizeof(Header) == 40, "Header layout is part of the file format");
+static_assert(sizeof(PlatformRecord) == 28, "PlatformRecord layout is part of the file format");
+static_assert(sizeof(CharacterRecord) == 32, "CharacterRecord layout is part of the file format");
+
+}  // namespace LevelFormat
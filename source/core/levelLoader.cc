@@ -1,13 +1,34 @@
 #include "levelLoader.h"
 #include "entities/platform.h"
 #include "entityManager.h"
+#include "levelFormat.h"
+#include "mappedFile.h"
 #include "renderer/textureManager.h"
 #include <nlohmann/json.hpp>
+#include <algorithm>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 
 using json = nlohmann::json;
 
+namespace {
+std::string levelTexturePath(const std::string &name) {
+    return "assets/textures/" + name + ".png";
+}
+
+// Level textures share atlas pages, so platforms of different textures
+// still draw in one batch.
+void loadLevelAtlas(TextureManager &textureManager, std::vector<std::string> names) {
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+    std::vector<std::pair<std::string, std::string>> files;
+    for (const std::string &name: names)
+        files.emplace_back(name, levelTexturePath(name));
+    textureManager.loadAtlas("level", files);
+}
+}  // namespace
+
 std::shared_ptr<Character> loadLevelFromFile(const std::string &filename,
                                              std::shared_ptr<TextureManager> textureManager,
                                              EntityManager *entityManager) {
@@ -23,6 +44,13 @@ std::shared_ptr<Character> loadLevelFromFile(const std::string &filename,
 
     std::shared_ptr<Character> playerCharacter = nullptr;
 
+    std::vector<std::string> textures;
+    for (const auto &obj: levelJson["objects"]) {
+        if (obj.contains("texture") && obj["texture"].is_string())
+            textures.push_back(obj["texture"]);
+    }
+    loadLevelAtlas(*textureManager, std::move(textures));
+
     for (const auto &obj: levelJson["objects"]) {
         if (!obj.contains("type") || !obj.contains("texture") || !obj.contains("position") ||
             !obj.contains("scale")) {
@@ -35,12 +63,12 @@ std::shared_ptr<Character> loadLevelFromFile(const std::string &filename,
         glm::vec3 position = glm::vec3(obj["position"][0], obj["position"][1], obj["position"][2]);
         glm::vec2 scale = glm::vec2(obj["scale"][0], obj["scale"][1]);
 
-        // Load the texture if it's not already present
+        // Not in the atlas (failed to decode): queue it in the background
         if (!textureManager->hasTexture(texture)) {
-            std::string fullPath = "assets/textures/" + texture + ".png";
+            std::string fullPath = levelTexturePath(texture);
             std::cout << "[LevelLoader] Attempting to load texture: " << fullPath << std::endl;
             std::cout << "[LevelLoader] textureManager ptr: " << textureManager.get() << std::endl;
-            textureManager->loadTexture(texture, fullPath);
+            textureManager->loadTextureAsync(texture, fullPath);
             std::cout << "[LevelLoader] textureManager ptr: " << textureManager.get() << std::endl;
         }
 
@@ -68,6 +96,120 @@ std::shared_ptr<Character> loadLevelFromFile(const std::string &filename,
     }
 
     entityManager->add<CanvasOverlay>();
+    entityManager->bakeStatic();
     std::cout << "[levelLoader] Level loaded: " << levelJson["levelName"] << std::endl;
     return playerCharacter;
 }
+
+/*───────────────────────────   cooked levels   ──────────────────────────*/
+namespace {
+std::shared_ptr<Texture> levelTexture(TextureManager &textureManager, const char *name) {
+    if (!textureManager.hasTexture(name))
+        textureManager.loadTextureAsync(name, levelTexturePath(name));
+    return textureManager.getTexture(name);
+}
+
+// False, with nothing spawned, if the file can't be used.
+bool spawnCooked(const std::string &filename, TextureManager *textureManager,
+                 EntityManager *entityManager, bool stationaryPlatforms,
+                 std::shared_ptr<Character> &playerCharacter) {
+    MappedFile file;
+    if (!file.open(filename))
+        return false;
+    LevelFormat::View level;
+    if (!LevelFormat::parse(file.data(), file.size(), level)) {
+        std::cerr << "[levelLoader] Not a valid v" << LevelFormat::kVersion
+                  << " cooked level: " << filename << std::endl;
+        return false;
+    }
+    const LevelFormat::Header &h = *level.header;
+
+    std::vector<bool> used(h.stringCount, false);
+    for (uint32_t i = 0; i < h.platformCount; ++i)
+        used[level.platforms[i].texture] = true;
+    for (uint32_t i = 0; i < h.characterCount; ++i)
+        used[level.characters[i].texture] = true;
+    std::vector<std::string> textures;
+    for (uint32_t i = 0; i < h.stringCount; ++i) {
+        if (used[i])
+            textures.push_back(level.string(i));
+    }
+    loadLevelAtlas(*textureManager, std::move(textures));
+
+    // One sprite mesh per texture, made on first use and owned by the manager.
+    std::vector<Mesh *> meshes(h.stringCount, nullptr);
+    auto meshFor = [&](uint32_t texture) {
+        if (!meshes[texture]) {
+            auto mesh = std::make_shared<Mesh>();
+            mesh->m_texture = levelTexture(*textureManager, level.string(texture));
+            meshes[texture] = entityManager->retainMesh(std::move(mesh));
+        }
+        return meshes[texture];
+    };
+
+    std::vector<EntityManager::StaticSprite> statics;
+    statics.reserve(h.platformCount);
+    for (uint32_t i = 0; i < h.platformCount; ++i) {
+        const LevelFormat::PlatformRecord &r = level.platforms[i];
+        const glm::vec3 position(r.position[0], r.position[1], r.position[2]);
+        const glm::vec2 scale(r.scale[0], r.scale[1]);
+        if (static_cast<PlatformType>(r.type) == PlatformType::stationary) {
+            if (!stationaryPlatforms)
+                continue;
+            // Same body and UVs a stationary Platform would get.
+            statics.push_back({position, scale, glm::vec4(0.0f, 0.0f, scale), meshFor(r.texture)});
+        } else {
+            entityManager->add<Platform>(static_cast<PlatformType>(r.type),
+                                         levelTexture(*textureManager, level.string(r.texture)),
+                                         position, 0.0f, scale, true);
+        }
+    }
+    entityManager->spawnStaticSprites(statics.data(), statics.size());
+
+    for (uint32_t i = 0; i < h.characterCount; ++i) {
+        const LevelFormat::CharacterRecord &r = level.characters[i];
+        playerCharacter = entityManager->add<Character>(
+                levelTexture(*textureManager, level.string(r.texture)),
+                glm::vec3(r.position[0], r.position[1], r.position[2]), r.speed, r.mass,
+                glm::vec2(r.scale[0], r.scale[1]));
+    }
+
+    entityManager->add<CanvasOverlay>();
+    entityManager->bakeStatic();
+    std::cout << "[levelLoader] Cooked level loaded: " << level.string(h.levelName) << " ("
+              << h.platformCount << " platforms, " << h.characterCount << " characters)\n";
+    return true;
+}
+}  // namespace
+
+std::shared_ptr<Character> loadCookedLevel(const std::string &filename,
+                                           std::shared_ptr<TextureManager> textureManager,
+                                           EntityManager *entityManager,
+                                           bool stationaryPlatforms) {
+    std::shared_ptr<Character> playerCharacter = nullptr;
+    spawnCooked(filename, textureManager.get(), entityManager, stationaryPlatforms,
+                playerCharacter);
+    return playerCharacter;
+}
+
+std::string freshCookedLevel(const std::string &jsonFilename) {
+    namespace fs = std::filesystem;
+    const fs::path cooked = fs::path(jsonFilename).replace_extension(LevelFormat::kExtension);
+    std::error_code ec;
+    if (fs::exists(cooked, ec) &&
+        (!fs::exists(jsonFilename, ec) ||
+         fs::last_write_time(cooked, ec) >= fs::last_write_time(jsonFilename, ec)))
+        return cooked.string();
+    return {};
+}
+
+std::shared_ptr<Character> loadLevel(const std::string &jsonFilename,
+                                     std::shared_ptr<TextureManager> textureManager,
+                                     EntityManager *entityManager) {
+    const std::string cooked = freshCookedLevel(jsonFilename);
+    std::shared_ptr<Character> playerCharacter = nullptr;
+    if (!cooked.empty() &&
+        spawnCooked(cooked, textureManager.get(), entityManager, true, playerCharacter))
+        return playerCharacter;
+    return loadLevelFromFile(jsonFilename, textureManager, entityManager);
+}
@@ -14,3 +14,27 @@ std::shared_ptr<Character> loadLevelFromFile(
     const std::string& filename,
     std::shared_ptr<TextureManager> textureManager,
     EntityManager* entityManager);
+
+/// Load a cooked level (levelFormat.h, written by tools/level_cooker) through
+/// a read-only file mapping. Stationary platforms go in as static sprites
+/// (EntityManager::spawnStaticSprites) with one shared Mesh per texture.
+/// Returns the player Character like loadLevelFromFile(), or nullptr if the
+/// file is missing, truncated or from another format version.
+/// With `stationaryPlatforms` false those are left to a LevelStreamer.
+std::shared_ptr<Character> loadCookedLevel(
+    const std::string& filename,
+    std::shared_ptr<TextureManager> textureManager,
+    EntityManager* entityManager,
+    bool stationaryPlatforms = true);
+
+/// The cooked file next to `jsonFilename` (same name, .inkl) if it exists and
+/// is not older than the JSON; empty otherwise.
+std::string freshCookedLevel(const std::string& jsonFilename);
+
+/// Load `jsonFilename`, or freshCookedLevel(jsonFilename) when there is one.
+/// Either way the level's textures are first packed into a "level" atlas
+/// (TextureManager::loadAtlas).
+std::shared_ptr<Character> loadLevel(
+    const std::string& jsonFilename,
+    std::shared_ptr<TextureManager> textureManager,
+    EntityManager* entityManager);
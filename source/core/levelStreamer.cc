@@ -0,0 +1,310 @@
+#include "levelStreamer.h"
+#include "entities/platform.h"
+#include "profiler.h"
+#include "renderer/textureManager.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+namespace {
+uint64_t chunkKey(ChunkCoord c) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(c.x)) << 32) | static_cast<uint32_t>(c.y);
+}
+}  // namespace
+
+/*─────────────────────────   cooked chunk source   ──────────────────────*/
+std::unique_ptr<CookedChunkSource> CookedChunkSource::open(const std::string &filename,
+                                                           float chunkSize) {
+    std::unique_ptr<CookedChunkSource> source(new CookedChunkSource());
+    if (!source->m_file.open(filename))
+        return nullptr;
+    if (!LevelFormat::parse(source->m_file.data(), source->m_file.size(), source->m_level)) {
+        std::cerr << "[levelStreamer] Not a valid v" << LevelFormat::kVersion
+                  << " cooked level: " << filename << std::endl;
+        return nullptr;
+    }
+    source->m_chunkSize = chunkSize;
+
+    const LevelFormat::Header &h = *source->m_level.header;
+    for (uint32_t i = 0; i < h.platformCount; ++i) {
+        const LevelFormat::PlatformRecord &r = source->m_level.platforms[i];
+        if (static_cast<PlatformType>(r.type) != PlatformType::stationary)
+            continue;  // moving platforms are GameObjects, loaded with the level
+        const ChunkCoord c{static_cast<int>(std::floor(r.position[0] / chunkSize)),
+                           static_cast<int>(std::floor(r.position[1] / chunkSize))};
+        source->m_buckets[chunkKey(c)].push_back(i);
+    }
+    std::cout << "[levelStreamer] " << filename << ": " << source->m_buckets.size()
+              << " chunks of " << chunkSize << " units\n";
+    return source;
+}
+
+void CookedChunkSource::load(ChunkCoord coord, std::vector<ChunkPlatform> &out) {
+    const auto it = m_buckets.find(chunkKey(coord));
+    if (it == m_buckets.end())
+        return;
+    out.reserve(out.size() + it->second.size());
+    for (uint32_t i: it->second) {
+        const LevelFormat::PlatformRecord &r = m_level.platforms[i];
+        out.push_back({glm::vec3(r.position[0], r.position[1], r.position[2]),
+                       glm::vec2(r.scale[0], r.scale[1]), r.texture});
+    }
+}
+
+/*────────────────────────────   streamer   ──────────────────────────────*/
+LevelStreamer::LevelStreamer(std::unique_ptr<ChunkSource> source, EntityManager &entities,
+                             Settings settings)
+    : m_source(std::move(source)), m_entities(entities), m_settings(settings) {
+    m_settings.evictMargin = std::max(m_settings.evictMargin, m_settings.loadMargin);
+    const uint32_t textures = m_source->textureCount();
+    m_meshes.assign(textures, nullptr);
+    m_textureState.assign(textures, TextureState::none);
+    m_textures.resize(textures);
+    m_io = std::thread(&LevelStreamer::ioThread, this);
+}
+
+LevelStreamer::~LevelStreamer() {
+    {
+        std::lock_guard<std::mutex> lock(m_ioMutex);
+        m_stop = true;
+    }
+    m_ioWake.notify_one();
+    m_io.join();
+}
+
+LevelStreamer::Range LevelStreamer::viewRange(const glm::vec2 &focus,
+                                              const glm::vec2 &halfExtents, int margin) const {
+    const float inv = 1.0f / m_source->chunkSize();
+    return {static_cast<int>(std::floor((focus.x - halfExtents.x) * inv)) - margin,
+            static_cast<int>(std::floor((focus.y - halfExtents.y) * inv)) - margin,
+            static_cast<int>(std::floor((focus.x + halfExtents.x) * inv)) + margin,
+            static_cast<int>(std::floor((focus.y + halfExtents.y) * inv)) + margin};
+}
+
+void LevelStreamer::update(const glm::vec2 &focus, const glm::vec2 &viewHalfExtents) {
+    INK_PROFILE_SCOPE("level streaming");
+    evict(viewRange(focus, viewHalfExtents, m_settings.evictMargin));
+    request(viewRange(focus, viewHalfExtents, m_settings.loadMargin), focus);
+    collectLoaded();
+
+    // The budget caps how many sprites one tick spawns; nearest chunks get
+    // it first, so the ground under the player goes in before the edges.
+    m_scratchChunks.clear();
+    for (auto &[k, chunk]: m_chunks) {
+        if (chunk.state == ChunkState::waiting)
+            m_scratchChunks.push_back(&chunk);
+    }
+    std::sort(m_scratchChunks.begin(), m_scratchChunks.end(), [&](const Chunk *a, const Chunk *b) {
+        return distanceSq(a->coord, focus) < distanceSq(b->coord, focus);
+    });
+    std::size_t budget = m_settings.maxChunksPerTick;
+    for (Chunk *chunk: m_scratchChunks) {
+        if (budget == 0)
+            break;
+        if (resolveMeshes(*chunk)) {
+            integrate(*chunk);
+            --budget;
+        }
+    }
+}
+
+float LevelStreamer::distanceSq(ChunkCoord c, const glm::vec2 &focus) const {
+    const glm::vec2 d = (glm::vec2(c.x, c.y) + 0.5f) * m_source->chunkSize() - focus;
+    return d.x * d.x + d.y * d.y;
+}
+
+void LevelStreamer::request(const Range &range, const glm::vec2 &focus) {
+    m_scratchCoords.clear();
+    for (int y = range.y0; y <= range.y1; ++y) {
+        for (int x = range.x0; x <= range.x1; ++x) {
+            const ChunkCoord c{x, y};
+            if (m_chunks.find(chunkKey(c)) == m_chunks.end())
+                m_scratchCoords.push_back(c);
+        }
+    }
+    if (m_scratchCoords.empty())
+        return;
+
+    // Nearest chunk first, so the ground under the player arrives first.
+    std::sort(m_scratchCoords.begin(), m_scratchCoords.end(), [&](ChunkCoord a, ChunkCoord b) {
+        return distanceSq(a, focus) < distanceSq(b, focus);
+    });
+
+    {
+        std::lock_guard<std::mutex> lock(m_ioMutex);
+        for (ChunkCoord c: m_scratchCoords) {
+            m_chunks[chunkKey(c)].coord = c;
+            m_requests.push_back(c);
+        }
+    }
+    m_ioWake.notify_one();
+}
+
+void LevelStreamer::evict(const Range &keep) {
+    bool dropRequests = false;
+    for (auto it = m_chunks.begin(); it != m_chunks.end();) {
+        Chunk &chunk = it->second;
+        if (keep.contains(chunk.coord)) {
+            ++it;
+            continue;
+        }
+        if (chunk.state == ChunkState::resident) {
+            m_entities.removeStaticSprites(chunk.handles.data(), chunk.handles.size());
+            m_stats.residentSprites -= chunk.handles.size();
+            --m_stats.residentChunks;
+            ++m_stats.chunksEvicted;
+        } else {
+            // Still queued or loading: its result is dropped by collectLoaded().
+            dropRequests = true;
+        }
+        it = m_chunks.erase(it);
+    }
+
+    if (dropRequests) {
+        std::lock_guard<std::mutex> lock(m_ioMutex);
+        m_requests.erase(std::remove_if(m_requests.begin(), m_requests.end(),
+                                        [&](ChunkCoord c) { return !keep.contains(c); }),
+                         m_requests.end());
+    }
+}
+
+void LevelStreamer::collectLoaded() {
+    decltype(m_loaded) loaded;
+    {
+        std::lock_guard<std::mutex> lock(m_ioMutex);
+        loaded.swap(m_loaded);
+    }
+    for (auto &[coord, platforms]: loaded) {
+        auto it = m_chunks.find(chunkKey(coord));
+        if (it == m_chunks.end() || it->second.state != ChunkState::requested)
+            continue;  // evicted while loading
+        it->second.platforms = std::move(platforms);
+        it->second.state = ChunkState::waiting;
+    }
+
+    m_stats.inFlightChunks = m_chunks.size() - m_stats.residentChunks;
+}
+
+bool LevelStreamer::resolveMeshes(const Chunk &chunk) {
+    bool ready = true;
+    {
+        std::lock_guard<std::mutex> lock(m_textureMutex);
+        for (const ChunkPlatform &p: chunk.platforms) {
+            if (m_meshes[p.texture])
+                continue;
+            switch (m_textureState[p.texture]) {
+            case TextureState::ready: {
+                auto mesh = std::make_shared<Mesh>();
+                mesh->m_texture = m_textures[p.texture];
+                m_meshes[p.texture] = m_entities.retainMesh(std::move(mesh));
+                ++m_stats.texturesLoaded;
+                break;
+            }
+            case TextureState::none:
+                m_textureState[p.texture] = TextureState::requested;
+                m_textureRequests.push_back(p.texture);
+                [[fallthrough]];
+            case TextureState::requested:
+                ready = false;
+                break;
+            }
+        }
+    }
+    return ready;
+}
+
+void LevelStreamer::integrate(Chunk &chunk) {
+    m_sprites.clear();
+    m_sprites.reserve(chunk.platforms.size());
+    for (const ChunkPlatform &p: chunk.platforms) {
+        // Same body and UVs a stationary Platform would get.
+        m_sprites.push_back({p.position, p.scale, glm::vec4(0.0f, 0.0f, p.scale),
+                             m_meshes[p.texture]});
+    }
+    chunk.handles.resize(m_sprites.size());
+    m_entities.spawnStaticSprites(m_sprites.data(), m_sprites.size(), chunk.handles.data());
+
+    chunk.platforms.clear();
+    chunk.platforms.shrink_to_fit();
+    chunk.state = ChunkState::resident;
+    m_stats.residentSprites += chunk.handles.size();
+    ++m_stats.residentChunks;
+    ++m_stats.chunksLoaded;
+}
+
+void LevelStreamer::loadNow(const glm::vec2 &focus, const glm::vec2 &viewHalfExtents,
+                            TextureManager &textures) {
+    const Range range = viewRange(focus, viewHalfExtents, m_settings.loadMargin);
+    request(range, focus);
+
+    // Wait for the I/O thread, upload textures here, integrate everything.
+    for (;;) {
+        collectLoaded();
+        bool pending = false;
+        for (auto &[k, chunk]: m_chunks) {
+            if (chunk.state == ChunkState::requested) {
+                pending = true;
+            } else if (chunk.state == ChunkState::waiting) {
+                if (resolveMeshes(chunk)) {
+                    integrate(chunk);
+                } else {
+                    uploadTextures(textures, SIZE_MAX);
+                    pending = true;
+                }
+            }
+        }
+        if (!pending)
+            break;
+        std::this_thread::yield();
+    }
+    m_stats.inFlightChunks = 0;
+}
+
+std::size_t LevelStreamer::uploadTextures(TextureManager &textures, std::size_t budget) {
+    std::vector<uint32_t> batch;
+    {
+        std::lock_guard<std::mutex> lock(m_textureMutex);
+        const std::size_t n = std::min(budget, m_textureRequests.size());
+        batch.assign(m_textureRequests.begin(), m_textureRequests.begin() + n);
+        m_textureRequests.erase(m_textureRequests.begin(), m_textureRequests.begin() + n);
+    }
+    for (uint32_t index: batch) {
+        const char *name = m_source->textureName(index);
+        // Registered at once and decoded in the background, so the chunk
+        // goes in with a placeholder instead of stalling this frame. One
+        // that fails to load leaves its sprites untextured rather than
+        // their chunk waiting forever.
+        if (!textures.hasTexture(name))
+            textures.loadTextureAsync(name, std::string("assets/textures/") + name + ".png");
+        std::shared_ptr<Texture> texture = textures.getTexture(name);
+        std::lock_guard<std::mutex> lock(m_textureMutex);
+        m_textures[index] = std::move(texture);
+        m_textureState[index] = TextureState::ready;
+    }
+    return batch.size();
+}
+
+void LevelStreamer::ioThread() {
+    INK_PROFILE_THREAD("level io");
+    std::vector<ChunkPlatform> platforms;
+    for (;;) {
+        ChunkCoord coord;
+        {
+            std::unique_lock<std::mutex> lock(m_ioMutex);
+            m_ioWake.wait(lock, [this] { return m_stop || !m_requests.empty(); });
+            if (m_stop)
+                return;
+            coord = m_requests.front();
+            m_requests.pop_front();
+        }
+        {
+            INK_PROFILE_SCOPE("load chunk");
+            platforms.clear();
+            m_source->load(coord, platforms);
+        }
+        std::lock_guard<std::mutex> lock(m_ioMutex);
+        m_loaded.emplace_back(coord, std::move(platforms));
+    }
+}
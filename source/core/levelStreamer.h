@@ -0,0 +1,199 @@
+#pragma once
+
+#include "entityManager.h"
+#include "levelFormat.h"
+#include "mappedFile.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <glm/glm.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class TextureManager;
+struct Texture;
+
+/// Square cell of the world grid that streaming loads and evicts as a unit.
+struct ChunkCoord {
+    int x = 0;
+    int y = 0;
+};
+
+/// One stationary platform as a ChunkSource delivers it.
+struct ChunkPlatform {
+    glm::vec3 position;
+    glm::vec2 scale;
+    uint32_t texture;  // ChunkSource::textureName index
+};
+
+/**
+ * Where streamed level content comes from. load() runs on the streamer's
+ * I/O thread; textureName() on any thread, so it must be immutable.
+ */
+class ChunkSource {
+public:
+    virtual ~ChunkSource() = default;
+
+    /// Edge length of a chunk in world units.
+    virtual float chunkSize() const = 0;
+    /// Append the platforms whose centre lies in `coord`.
+    virtual void load(ChunkCoord coord, std::vector<ChunkPlatform> &out) = 0;
+
+    virtual uint32_t textureCount() const = 0;
+    virtual const char *textureName(uint32_t index) const = 0;
+};
+
+/// Stationary platforms of a cooked level (levelFormat.h), bucketed by chunk
+/// when opened; load() copies a bucket's records out of the mapping.
+class CookedChunkSource : public ChunkSource {
+public:
+    /// nullptr (and logs) if `filename` is not a valid cooked level.
+    static std::unique_ptr<CookedChunkSource> open(const std::string &filename, float chunkSize);
+
+    float chunkSize() const override {
+        return m_chunkSize;
+    }
+    void load(ChunkCoord coord, std::vector<ChunkPlatform> &out) override;
+    uint32_t textureCount() const override {
+        return m_level.header->stringCount;
+    }
+    const char *textureName(uint32_t index) const override {
+        return m_level.string(index);
+    }
+
+private:
+    CookedChunkSource() = default;
+
+    MappedFile m_file;
+    LevelFormat::View m_level;
+    float m_chunkSize = 1.0f;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> m_buckets;  // chunk -> platform records
+};
+
+/**
+ * Keeps the level's stationary platforms resident only around a focus point
+ * (the player), so memory and tick cost follow the visible neighbourhood
+ * instead of the level size.
+ *
+ * Three threads are involved:
+ *   - update thread: update() requests chunks that come within `loadMargin`
+ *     chunks of the view, integrates finished ones into the EntityManager
+ *     as static sprites (nearest first), and evicts chunks beyond
+ *     `evictMargin`.
+ *   - I/O thread (owned): runs ChunkSource::load() for requested chunks.
+ *   - render (GL) thread: uploadTextures() registers the textures waiting
+ *     chunks need with TextureManager::loadTextureAsync(); a chunk is
+ *     integrated once all of them exist (possibly still placeholders).
+ *
+ * The update thread must have exclusive use of the EntityManager during
+ * update() (Application adds and removes entities only on that thread). Sprite meshes
+ * are one per texture and retained by the manager, so RenderItems in
+ * snapshots still being drawn never outlive their Mesh.
+ */
+class LevelStreamer {
+public:
+    struct Settings {
+        int loadMargin = 1;                 // chunks beyond the view to load
+        int evictMargin = 2;                // chunks beyond the view to keep; >= loadMargin
+        std::size_t maxChunksPerTick = 2;   // integration budget, bounds tick hitches
+    };
+
+    struct Stats {
+        std::size_t residentChunks = 0;
+        std::size_t residentSprites = 0;
+        std::size_t inFlightChunks = 0;     // requested, loading or waiting for textures
+        std::size_t chunksLoaded = 0;       // totals since construction
+        std::size_t chunksEvicted = 0;
+        std::size_t texturesLoaded = 0;
+    };
+
+    LevelStreamer(std::unique_ptr<ChunkSource> source, EntityManager &entities,
+                  Settings settings);
+    LevelStreamer(std::unique_ptr<ChunkSource> source, EntityManager &entities)
+        : LevelStreamer(std::move(source), entities, Settings{}) {
+    }
+    // Joins the I/O thread; resident chunks stay in the EntityManager.
+    ~LevelStreamer();
+
+    LevelStreamer(const LevelStreamer &) = delete;
+    LevelStreamer &operator=(const LevelStreamer &) = delete;
+
+    /*───── before the update thread starts (GL thread) ───────────────────*/
+    // Load and integrate everything update() would want around `focus`,
+    // synchronously, so the first tick already has ground under the player.
+    void loadNow(const glm::vec2 &focus, const glm::vec2 &viewHalfExtents,
+                 TextureManager &textures);
+
+    /*───── update thread ──────────────────────────────────────────────────*/
+    void update(const glm::vec2 &focus, const glm::vec2 &viewHalfExtents);
+
+    /*───── render (GL) thread ─────────────────────────────────────────────*/
+    // Request up to `budget` textures chunks are waiting for; returns how many.
+    std::size_t uploadTextures(TextureManager &textures, std::size_t budget);
+
+    const Stats &stats() const {  // update thread
+        return m_stats;
+    }
+
+private:
+    enum class ChunkState { requested, waiting, resident };
+
+    struct Chunk {
+        ChunkCoord coord;
+        ChunkState state = ChunkState::requested;
+        std::vector<ChunkPlatform> platforms;  // until resident
+        std::vector<EntityHandle> handles;     // while resident
+    };
+
+    struct Range {
+        int x0, y0, x1, y1;
+
+        bool contains(ChunkCoord c) const {
+            return c.x >= x0 && c.x <= x1 && c.y >= y0 && c.y <= y1;
+        }
+    };
+
+    Range viewRange(const glm::vec2 &focus, const glm::vec2 &halfExtents, int margin) const;
+    // Squared distance from the centre of `c` to `focus`.
+    float distanceSq(ChunkCoord c, const glm::vec2 &focus) const;
+    void request(const Range &range, const glm::vec2 &focus);
+    void evict(const Range &keep);
+    void collectLoaded();
+    // False if a texture is still missing (and has been requested).
+    bool resolveMeshes(const Chunk &chunk);
+    void integrate(Chunk &chunk);
+    void ioThread();
+
+    std::unique_ptr<ChunkSource> m_source;
+    EntityManager &m_entities;
+    Settings m_settings;
+    Stats m_stats;
+
+    // Update thread only.
+    std::unordered_map<uint64_t, Chunk> m_chunks;
+    std::vector<Mesh *> m_meshes;  // per texture, retained by m_entities
+    std::vector<EntityManager::StaticSprite> m_sprites;  // scratch
+    std::vector<ChunkCoord> m_scratchCoords;
+    std::vector<Chunk *> m_scratchChunks;
+
+    // I/O thread hand-off.
+    std::mutex m_ioMutex;
+    std::condition_variable m_ioWake;
+    std::deque<ChunkCoord> m_requests;
+    std::vector<std::pair<ChunkCoord, std::vector<ChunkPlatform>>> m_loaded;
+    bool m_stop = false;
+
+    // Render thread hand-off, per texture index.
+    enum class TextureState : uint8_t { none, requested, ready };
+    std::mutex m_textureMutex;
+    std::vector<TextureState> m_textureState;
+    std::vector<uint32_t> m_textureRequests;
+    std::vector<std::shared_ptr<Texture>> m_textures;
+
+    std::thread m_io;
+};
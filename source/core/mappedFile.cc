@@ -0,0 +1,116 @@
+#include "mappedFile.h"
+
+#include <iostream>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+    if (this != &other) {
+        close();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_open = std::exchange(other.m_open, false);
+#ifdef _WIN32
+        m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+    }
+    return *this;
+}
+
+#ifdef _WIN32
+bool MappedFile::open(const std::string &path) {
+    close();
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cerr << "[mappedFile] Cannot open " << path << "\n";
+        return false;
+    }
+    LARGE_INTEGER size{};
+    GetFileSizeEx(file, &size);
+    m_size = static_cast<std::size_t>(size.QuadPart);
+    if (m_size > 0) {
+        // The mapping keeps the file open; the file handle can go.
+        m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (m_mapping)
+            m_data = static_cast<const unsigned char *>(
+                    MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    }
+    CloseHandle(file);
+    if (m_size > 0 && !m_data) {
+        std::cerr << "[mappedFile] Cannot map " << path << "\n";
+        close();
+        return false;
+    }
+    m_open = true;
+    return true;
+}
+
+void MappedFile::close() {
+    if (m_data)
+        UnmapViewOfFile(m_data);
+    if (m_mapping)
+        CloseHandle(m_mapping);
+    m_mapping = nullptr;
+    m_data = nullptr;
+    m_size = 0;
+    m_open = false;
+}
+#else
+bool MappedFile::open(const std::string &path) {
+    close();
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "[mappedFile] Cannot open " << path << "\n";
+        return false;
+    }
+    struct stat st {};
+    if (fstat(fd, &st) != 0) {
+        std::cerr << "[mappedFile] Cannot stat " << path << "\n";
+        ::close(fd);
+        return false;
+    }
+    m_size = static_cast<std::size_t>(st.st_size);
+    if (m_size > 0) {
+        void *p = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            std::cerr << "[mappedFile] Cannot map " << path << "\n";
+            ::close(fd);
+            m_size = 0;
+            return false;
+        }
+        // Loaders read front to back once.
+        madvise(p, m_size, MADV_SEQUENTIAL);
+        m_data = static_cast<const unsigned char *>(p);
+    }
+    ::close(fd);  // the mapping holds its own reference
+    m_open = true;
+    return true;
+}
+
+void MappedFile::close() {
+    if (m_data)
+        munmap(const_cast<unsigned char *>(m_data), m_size);
+    m_data = nullptr;
+    m_size = 0;
+    m_open = false;
+}
+#endif
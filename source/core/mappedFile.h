@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * Read-only memory mapping of a whole file. The bytes stay valid until the
+ * MappedFile is closed, destroyed or moved from; nothing is copied.
+ *
+ *     MappedFile file;
+ *     if (file.open("assets/levels/level1.inkl")) use(file.data(), file.size());
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    // Maps `path`; false (and logs) if it cannot be opened or mapped.
+    // An empty file opens successfully with data() == nullptr.
+    bool open(const std::string &path);
+    void close();
+
+    const unsigned char *data() const {
+        return m_data;
+    }
+    std::size_t size() const {
+        return m_size;
+    }
+    bool isOpen() const {
+        return m_open;
+    }
+
+private:
+    const unsigned char *m_data = nullptr;
+    std::size_t m_size = 0;
+    bool m_open = false;
+#ifdef _WIN32
+    void *m_mapping = nullptr;  // HANDLE
+#endif
+};
@@ -0,0 +1,105 @@
+#include "physicsSystems.h"
+#include "entities/gameObject.h"
+#include "jobSystem.h"
+
+namespace {
+// Bodies per job; small enough to balance, large enough to amortize a steal.
+constexpr std::size_t kBodiesPerJob = 2048;
+
+template <class Fn>
+void forEachDynamic(const ComponentStore &store, JobSystem *jobs, Fn &&fn) {
+    const std::size_t n = store.dynamicCount();
+    if (!jobs) {
+        fn(std::size_t(0), n);
+        return;
+    }
+    jobs->parallelFor(n, kBodiesPerJob, fn);
+}
+}  // namespace
+
+void Systems::integrate(ComponentStore &store, float dt, JobSystem *jobs) {
+    forEachDynamic(store, jobs, [&store, dt](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            if (store.mass[i] > 0.0f) {
+                store.velocity[i].y -= 1.0f * dt * store.mass[i];  // Multiply by mass instead of dividing
+            }
+            // Move in X/Y, keep Z unchanged
+            store.position[i] += glm::vec3(store.velocity[i] * store.speed[i] * dt, 0.0f);
+        }
+    });
+}
+
+void Systems::syncHitboxes(ComponentStore &store, JobSystem *jobs) {
+    forEachDynamic(store, jobs, [&store](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            const glm::vec3 &p = store.position[i];
+            const glm::vec2 &size = store.hitboxSize[i];
+            store.bounds[i] = {glm::vec2(p.x - size.x / 2, p.y - size.y / 2),
+                               glm::vec2(p.x + size.x / 2, p.y + size.y / 2)};
+        }
+    });
+}
+
+void Systems::gatherMovers(const ComponentStore &store, std::vector<BroadphaseProxy> &out) {
+    out.clear();
+    const std::size_t n = store.dynamicCount();
+    for (std::size_t i = 0; i < n; ++i) {
+        if (store.flags[i] & BodyFlags::hitboxActive)
+            out.push_back({store.denseToSparse[i], store.bounds[i]});
+    }
+}
+
+namespace {
+void resolveBody(ComponentStore &store, uint32_t self, uint32_t other) {
+    const glm::vec2 resolution = resolveOverlap(store.bounds[self], store.bounds[other]);
+    store.position[self] += glm::vec3(resolution, 0.0f);
+
+    // Kill velocity in the direction of collision
+    if (resolution.x != 0.0f) {
+        store.velocity[self].x = 0.0f;
+    }
+    if (resolution.y != 0.0f) {
+        store.velocity[self].y = 0.0f;
+    }
+    if (GameObject *obj = store.owner[self]) {
+        obj->onCollision(resolution);
+    }
+}
+}  // namespace
+
+std::size_t Systems::collide(ComponentStore &store, const std::vector<BroadphasePair> &pairs) {
+    std::size_t contacts = 0;
+    for (const auto &[slotA, slotB]: pairs) {
+        const uint32_t a = store.denseIndexOfSlot(slotA);
+        const uint32_t b = store.denseIndexOfSlot(slotB);
+        const uint8_t fa = store.flags[a];
+        const uint8_t fb = store.flags[b];
+
+        if (!(fa & BodyFlags::hitboxActive) || !(fb & BodyFlags::hitboxActive))
+            continue;
+        if ((!(fa & BodyFlags::collides) && !(fb & BodyFlags::collides)) ||
+            !overlaps(store.bounds[a], store.bounds[b])) {
+            continue;
+        }
+        ++contacts;
+
+        if (fa & BodyFlags::movesOnCollision) {
+            resolveBody(store, a, b);
+        }
+        if (fb & BodyFlags::movesOnCollision) {
+            resolveBody(store, b, a);
+        }
+    }
+    return contacts;
+}
+
+void Systems::syncRenderObjects(ComponentStore &store) {
+    const std::size_t n = store.dynamicCount();
+    for (std::size_t i = 0; i < n; ++i) {
+        GameObject *obj = store.owner[i];
+        if (!obj || !obj->renderObject)
+            continue;
+        obj->renderObject->m_transform.m_position = store.position[i];
+        obj->renderObject->m_transform.m_scale = glm::vec3(store.scale[i], 1.0f);
+    }
+}
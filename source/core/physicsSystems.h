@@ -0,0 +1,36 @@
+#pragma once
+
+#include "broadphase.h"
+#include "componentStore.h"
+
+#include <vector>
+
+class JobSystem;
+
+// Per-tick passes over ComponentStore's dense arrays, run in this order by
+// EntityManager::update. Only the dynamic prefix of the store is touched;
+// static bodies are never written after creation.
+//
+// Passes that take a JobSystem only touch each body's own components and
+// are split across workers; collide() stays on the calling thread so
+// resolution order (and therefore the result) never depends on scheduling.
+namespace Systems {
+
+/// Gravity and velocity integration (was Character::update).
+void integrate(ComponentStore &store, float dt, JobSystem *jobs = nullptr);
+
+/// Recompute world AABBs from position and hitbox size.
+void syncHitboxes(ComponentStore &store, JobSystem *jobs = nullptr);
+
+/// Collect the active dynamic bodies as broadphase proxies (id = sparse slot).
+void gatherMovers(const ComponentStore &store, std::vector<BroadphaseProxy> &out);
+
+/// Narrow-phase test and resolution for candidate pairs, in the given order.
+/// Movers are pushed out along the axis of least penetration, lose velocity
+/// on that axis, and get GameObject::onCollision. Returns the contact count.
+std::size_t collide(ComponentStore &store, const std::vector<BroadphasePair> &pairs);
+
+/// Copy transforms of dynamic bodies into their owners' render objects.
+void syncRenderObjects(ComponentStore &store);
+
+}  // namespace Systems
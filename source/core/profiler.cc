@@ -0,0 +1,238 @@
+#include "profiler.h"
+
+#if INK_PROFILE
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+// Written only by its owning thread (head) and the collector (tail).
+struct Profiler::ThreadRing {
+    Event events[kRingCapacity];
+    std::atomic<uint64_t> head{0};
+    std::atomic<uint64_t> tail{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<const char *> name{nullptr};
+    bool inUse = false;  // guarded by m_threadsMutex; a finished thread's ring is reused
+    uint32_t id = 0;
+    uint32_t depth = 0;  // owner only
+
+    void push(const Event &e) {
+        const uint64_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == kRingCapacity) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        events[h % kRingCapacity] = e;
+        head.store(h + 1, std::memory_order_release);
+    }
+};
+
+namespace {
+const auto s_epoch = std::chrono::steady_clock::now();
+
+void writeJsonString(std::ostream &out, std::string_view s) {
+    out << '"';
+    for (char c: s) {
+        if (c == '"' || c == '\\')
+            out << '\\';
+        out << c;
+    }
+    out << '"';
+}
+}  // namespace
+
+Profiler &Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+uint64_t Profiler::now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now() - s_epoch)
+                                         .count());
+}
+
+Profiler::ThreadRing &Profiler::localRing() {
+    // Hands the ring back when its thread exits, so short-lived threads
+    // don't grow m_threads. Undrained events stay and are collected later.
+    struct Lease {
+        ThreadRing *ring = nullptr;
+        ~Lease() {
+            if (ring) {
+                std::lock_guard<std::mutex> lock(instance().m_threadsMutex);
+                ring->inUse = false;
+            }
+        }
+    };
+    thread_local Lease lease;
+    if (!lease.ring) {
+        std::lock_guard<std::mutex> lock(m_threadsMutex);
+        for (const auto &r: m_threads) {
+            if (!r->inUse) {
+                lease.ring = r.get();
+                break;
+            }
+        }
+        if (!lease.ring) {
+            m_threads.push_back(std::make_unique<ThreadRing>());
+            lease.ring = m_threads.back().get();
+            lease.ring->id = static_cast<uint32_t>(m_threads.size() - 1);
+        }
+        lease.ring->inUse = true;
+        lease.ring->name.store(nullptr, std::memory_order_relaxed);
+    }
+    return *lease.ring;
+}
+
+Profiler::Zone::Zone(const char *name) : m_ring(&instance().localRing()), m_name(name) {
+    ++m_ring->depth;
+    m_start = now();
+}
+
+Profiler::Zone::~Zone() {
+    const uint64_t end = now();
+    --m_ring->depth;
+    m_ring->push({m_name, m_start, end - m_start, m_ring->id, m_ring->depth});
+}
+
+void Profiler::setThreadName(const char *name) {
+    localRing().name.store(name, std::memory_order_relaxed);
+}
+
+/*──────────────────────────── collector ─────────────────────────────────*/
+void Profiler::record(const Event &event) {
+    if (m_trace.size() < kTraceCapacity) {
+        m_trace.push_back(event);
+    } else {
+        m_trace[m_traceNext] = event;
+        m_traceNext = (m_traceNext + 1) % kTraceCapacity;
+    }
+
+    Samples &s = m_samples[event.name];
+    const float ms = static_cast<float>(event.duration * 1e-6);
+    if (s.ms.size() < kWindow) {
+        s.ms.push_back(ms);
+    } else {
+        s.ms[s.next] = ms;
+        s.next = (s.next + 1) % kWindow;
+    }
+}
+
+void Profiler::endFrame() {
+    const uint64_t t = now();
+    if (m_lastFrame) {
+        ThreadRing &ring = localRing();
+        record({"frame", m_lastFrame, t - m_lastFrame, ring.id, 0});
+    }
+    m_lastFrame = t;
+
+    std::vector<ThreadRing *> rings;
+    {
+        std::lock_guard<std::mutex> lock(m_threadsMutex);
+        for (const auto &r: m_threads)
+            rings.push_back(r.get());
+    }
+    for (ThreadRing *ring: rings) {
+        const uint64_t head = ring->head.load(std::memory_order_acquire);
+        for (uint64_t i = ring->tail.load(std::memory_order_relaxed); i < head; ++i) {
+            record(ring->events[i % kRingCapacity]);
+        }
+        ring->tail.store(head, std::memory_order_release);
+    }
+}
+
+void Profiler::addGpuSample(const char *name, uint64_t start, uint64_t duration) {
+    record({name, start, duration, kGpuThread, 0});
+}
+
+uint64_t Profiler::droppedEvents() const {
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    uint64_t dropped = 0;
+    for (const auto &r: m_threads)
+        dropped += r->dropped.load(std::memory_order_relaxed);
+    return dropped;
+}
+
+/*───────────────────────────── reports ──────────────────────────────────*/
+std::vector<Profiler::Summary> Profiler::summary() const {
+    std::vector<Summary> out;
+    std::vector<float> sorted;
+    for (const auto &[name, s]: m_samples) {
+        if (s.ms.empty())
+            continue;
+        sorted = s.ms;
+        std::sort(sorted.begin(), sorted.end());
+        double sum = 0.0;
+        for (float v: sorted)
+            sum += v;
+        const std::size_t p99 = std::min(sorted.size() - 1, sorted.size() * 99 / 100);
+        out.push_back({name, sorted.front(), sum / sorted.size(), sorted[p99], sorted.size()});
+    }
+    std::sort(out.begin(), out.end(),
+              [](const Summary &a, const Summary &b) { return a.name < b.name; });
+    return out;
+}
+
+void Profiler::printSummary(std::ostream &out) const {
+    out << "[profiler] zone                   min ms    avg ms    p99 ms  (last " << kWindow
+        << ")\n";
+    const auto flags = out.flags();
+    out << std::fixed << std::setprecision(3);
+    for (const Summary &s: summary()) {
+        out << "[profiler] " << std::left << std::setw(20) << std::string(s.name) << std::right
+            << std::setw(10) << s.minMs << std::setw(10) << s.avgMs << std::setw(10) << s.p99Ms
+            << "\n";
+    }
+    out.flags(flags);
+}
+
+bool Profiler::writeChromeTrace(const std::string &path) const {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "[profiler] Cannot write " << path << "\n";
+        return false;
+    }
+
+    out << "{\"traceEvents\":[\n";
+    bool first = true;
+    auto separator = [&] {
+        if (!first)
+            out << ",\n";
+        first = false;
+    };
+
+    // Thread names first so viewers label the tracks.
+    {
+        std::lock_guard<std::mutex> lock(m_threadsMutex);
+        for (const auto &r: m_threads) {
+            const char *name = r->name.load(std::memory_order_relaxed);
+            separator();
+            out << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << r->id
+                << R"(,"args":{"name":)";
+            writeJsonString(out, name ? name : "thread");
+            out << "}}";
+        }
+    }
+    separator();
+    out << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << kGpuThread
+        << R"(,"args":{"name":"GPU"}})";
+
+    // Oldest first; timestamps in microseconds.
+    out << std::fixed << std::setprecision(3);
+    for (std::size_t i = 0; i < m_trace.size(); ++i) {
+        const Event &e = m_trace[(m_traceNext + i) % m_trace.size()];
+        separator();
+        out << R"({"name":)";
+        writeJsonString(out, e.name);
+        out << R"(,"ph":"X","pid":1,"tid":)" << e.thread << R"(,"ts":)" << e.start * 1e-3
+            << R"(,"dur":)" << e.duration * 1e-3 << "}";
+    }
+    out << "\n]}\n";
+    std::cout << "[profiler] Wrote " << m_trace.size() << " events to " << path << "\n";
+    return static_cast<bool>(out);
+}
+
+#endif  // INK_PROFILE
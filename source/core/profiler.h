@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Frame profiler: nested CPU zones, GPU timer samples, Chrome trace export
+ * and a rolling min/avg/p99 per zone.
+ *
+ * Built only with -DINK_PROFILE=ON. Otherwise every INK_PROFILE_* macro
+ * expands to nothing and profiler.cc compiles to an empty object.
+ *
+ *     INK_PROFILE_THREAD("update");           // once per thread, optional
+ *     { INK_PROFILE_SCOPE("collision"); ... } // zone = enclosing scope
+ *     INK_PROFILE_FRAME();                    // render thread, once per frame
+ *
+ * Each thread writes finished zones into its own single-producer ring, so
+ * recording takes no lock. endFrame() drains every ring on the calling
+ * thread into the trace and the per-zone statistics. Zone names must be
+ * string literals (they are stored by pointer).
+ */
+#if INK_PROFILE
+#define INK_PROFILE_CAT2(a, b) a##b
+#define INK_PROFILE_CAT(a, b) INK_PROFILE_CAT2(a, b)
+#define INK_PROFILE_SCOPE(name) const Profiler::Zone INK_PROFILE_CAT(inkZone_, __LINE__)(name)
+#define INK_PROFILE_THREAD(name) Profiler::instance().setThreadName(name)
+#define INK_PROFILE_FRAME() Profiler::instance().endFrame()
+#else
+#define INK_PROFILE_SCOPE(name) ((void) 0)
+#define INK_PROFILE_THREAD(name) ((void) 0)
+#define INK_PROFILE_FRAME() ((void) 0)
+#endif
+
+class Profiler {
+    struct ThreadRing;
+
+public:
+    // One finished zone; times in nanoseconds since the profiler started.
+    struct Event {
+        const char *name;
+        uint64_t start;
+        uint64_t duration;
+        uint32_t thread;  // registration order; kGpuThread for GPU samples
+        uint32_t depth;   // nesting level within its thread
+    };
+
+    struct Summary {
+        std::string_view name;
+        double minMs, avgMs, p99Ms;
+        std::size_t samples;
+    };
+
+    static constexpr uint32_t kGpuThread = 0xffffffffu;
+    static constexpr std::size_t kRingCapacity = 1 << 14;      // per thread, between drains
+    static constexpr std::size_t kTraceCapacity = 1 << 20;     // most recent events kept
+    static constexpr std::size_t kWindow = 240;                // samples per zone summary
+
+    static Profiler &instance();
+
+    // RAII CPU zone; use INK_PROFILE_SCOPE.
+    class Zone {
+    public:
+        explicit Zone(const char *name);
+        ~Zone();
+
+        Zone(const Zone &) = delete;
+        Zone &operator=(const Zone &) = delete;
+
+    private:
+        ThreadRing *m_ring;
+        const char *m_name;
+        uint64_t m_start;
+    };
+
+    static uint64_t now();  // ns since the profiler started
+
+    void setThreadName(const char *name);
+
+    /*───── collector (render thread) ──────────────────────────────────────*/
+    // Drain every thread's ring and record the time since the last call as
+    // the zone "frame".
+    void endFrame();
+    // A GPU timer result (see GpuTimer); `start` is the CPU time it was issued.
+    void addGpuSample(const char *name, uint64_t start, uint64_t duration);
+
+    std::vector<Summary> summary() const;
+    void printSummary(std::ostream &out) const;
+    // Chrome trace event JSON (chrome://tracing, Perfetto) of the kept events.
+    bool writeChromeTrace(const std::string &path) const;
+
+    uint64_t droppedEvents() const;
+
+private:
+    struct Samples {
+        std::vector<float> ms;  // ring of the last kWindow durations
+        std::size_t next = 0;
+    };
+
+    Profiler() = default;
+    ThreadRing &localRing();
+    void record(const Event &event);
+
+    mutable std::mutex m_threadsMutex;  // registration only, never while recording
+    std::vector<std::unique_ptr<ThreadRing>> m_threads;
+
+    std::vector<Event> m_trace;  // ring of the last kTraceCapacity events
+    std::size_t m_traceNext = 0;
+    std::unordered_map<std::string_view, Samples> m_samples;
+    uint64_t m_lastFrame = 0;
+};
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "strokeRaster.h"
+
 #include <glm/glm.hpp>
+#include <cstddef>
 #include <optional>
 #include <string>
 #include <utility>
@@ -8,7 +11,11 @@
 
 // Simple stub recognizer for M3 wiring.
 // - submitStroke(points) triggers rasterize + mock classify immediately
+// - submitRaster(raster) classifies a stroke someone already rasterized
 // - popNewPrediction() returns a result once per submission
+// - classify(pixels) is the stateless part, for RecognizerService's worker;
+//   classifyBatch() takes every symbol the worker has ready at once (a
+//   per-symbol loop for now)
 class Recognizer {
 public:
     struct Prediction {
@@ -22,25 +29,29 @@ public:
     // Triggers immediate rasterization + mock inference.
     void submitStroke(const std::vector<glm::vec2>& points);
 
+    // Classify a finished stroke raster (CanvasOverlay keeps one as the
+    // stroke is drawn), skipping the rasterization.
+    void submitRaster(const StrokeRaster& raster);
+
     // Non-blocking: returns a prediction only once per submission.
     std::optional<Prediction> popNewPrediction();
 
-private:
-    Recognizer() = default;
+    // Classify a grayscale stroke raster (StrokeRaster::pixels()). Touches
+    // no recognizer state, so any thread may call it.
+    static Prediction classify(const unsigned char* pixels);
 
-    // Rasterization helpers (64x64 RGBA internally but we just need luminance).
-    static constexpr int kW = 64;
-    static constexpr int kH = 64;
-    std::vector<unsigned char> m_pixels; // grayscale 0..255
+    // Classify `count` rasters in one call, out[i] for pixels[i]. For now a
+    // per-symbol shim: it calls classify() on each and shares no work
+    // across the batch. It is the entry point a batched TinyCnn forward
+    // pass (M5) replaces, so per-call setup is paid once per batch.
+    static void classifyBatch(const unsigned char* const* pixels, std::size_t count,
+                              Prediction* out);
 
-    static std::pair<int,int> toCanvas(float nx, float ny);
-    void clear(unsigned char v = 0);
-    void setPixel(int x, int y, unsigned char v = 255);
-    void drawDisc(int cx, int cy, int r, unsigned char v = 255);
-    void drawLine(int x0, int y0, int x1, int y1, int r = 1, unsigned char v = 255);
+private:
+    Recognizer() = default;
 
-    // Very basic heuristic classifier for demo purposes
-    Prediction classifyStub() const;
+    // Rasterization: a 64x64 grayscale StrokeRaster (luminance is all we need).
+    StrokeRaster m_raster;  // submitStroke()'s canvas
 
     bool m_hasNew = false;
     Prediction m_last;
@@ -0,0 +1,231 @@
+#include "recognizerService.h"
+
+#include "profiler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace {
+// Longest the worker sleeps with nothing due, i.e. the worst case for a
+// wake-up lost to the race in wake().
+constexpr std::chrono::milliseconds kIdleWait(5);
+}  // namespace
+
+RecognizerService::RecognizerService(Settings settings)
+    : m_settings(settings), m_matcher(settings.matching), m_grouper(settings.grouping) {
+    if (!settings.gestureTemplates.empty())
+        m_matcher.load(settings.gestureTemplates);  // logs; dots and lines work without
+    m_ready.reserve(16);
+    m_readyResults.reserve(16);
+    m_batchGroups.reserve(16);
+    m_batchPixels.reserve(16);
+    m_batchPredictions.reserve(16);
+    m_worker = std::thread(&RecognizerService::workerThread, this);
+}
+
+RecognizerService::~RecognizerService() {
+    m_running.store(false, std::memory_order_release);
+    wake();
+    m_worker.join();
+}
+
+void RecognizerService::wake() {
+    m_signalled.store(true, std::memory_order_release);
+    m_wake.notify_one();
+}
+
+void RecognizerService::submitLive(const StrokeRaster &raster) {
+    Request &request = m_live.writeSlot();
+    std::memcpy(request.pixels.data(), raster.pixels(), kPixels);
+    request.stroke = m_stroke;
+    request.submitted = Clock::now();
+    if (!m_drawing) {
+        m_started = request.submitted;
+        m_drawing = true;
+    }
+    request.started = m_started;
+    m_live.publish();
+    wake();
+}
+
+bool RecognizerService::submitFinal(const StrokeRaster &raster,
+                                    const std::vector<glm::vec2> &points) {
+    Request request;
+    std::memcpy(request.pixels.data(), raster.pixels(), kPixels);
+    request.stroke = m_stroke++;
+    request.submitted = Clock::now();
+    request.started = m_drawing ? m_started : request.submitted;
+    m_drawing = false;
+    {
+        INK_PROFILE_SCOPE("recognize matcher");
+        request.matched = m_matcher.match(GestureMatcher::makePath(points));
+    }
+    if (request.matched) {
+        Result result;
+        result.prediction = *request.matched;
+        result.stroke = request.stroke;
+        result.provisional = true;
+        result.matched = true;
+        result.submitted = request.submitted;
+        result.classified = Clock::now();
+        m_matchedResults.push(std::move(result));  // the final result still follows
+    }
+    if (!m_finals.push(std::move(request))) {
+        std::cout << "[RecognizerService] Finished-stroke queue full, dropping stroke "
+                  << request.stroke << "\n";
+        return false;
+    }
+    wake();
+    return true;
+}
+
+std::optional<RecognizerService::Result> RecognizerService::poll() {
+    if (std::optional<Result> result = m_results.pop())
+        return result;
+    return m_matchedResults.pop();
+}
+
+RecognizerService::Stats RecognizerService::stats() const {
+    Stats stats;
+    stats.symbols = m_symbols.load(std::memory_order_relaxed);
+    stats.strokes = m_strokes.load(std::memory_order_relaxed);
+    stats.batches = m_batches.load(std::memory_order_relaxed);
+    stats.matched = m_matched.load(std::memory_order_relaxed);
+    stats.classifySeconds = m_classifyNs.load(std::memory_order_relaxed) * 1e-9;
+    return stats;
+}
+
+void RecognizerService::classifyLive(const Request &request) {
+    Result result;
+    result.prediction = Recognizer::classify(request.pixels.data());
+    result.stroke = request.stroke;
+    result.submitted = request.submitted;
+    result.classified = Clock::now();
+    m_results.push(std::move(result));  // a full mailbox just loses a live guess
+}
+
+void RecognizerService::classifyProvisional(const StrokeGrouper::Group &group) {
+    Result result;
+    result.prediction = Recognizer::classify(group.pixels.data());
+    result.stroke = group.lastStroke;
+    result.strokes = group.strokes;
+    result.provisional = true;
+    result.submitted = group.released;
+    result.classified = Clock::now();
+    m_results.push(std::move(result));  // the final result still follows
+}
+
+void RecognizerService::classifyGroups() {
+    const Clock::time_point start = Clock::now();
+    const std::size_t count = m_ready.size();
+    m_readyResults.assign(count, Result{});
+    m_batchGroups.clear();
+    m_batchPixels.clear();
+    uint64_t strokes = 0, matched = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const StrokeGrouper::Group &group = m_ready[i];
+        Result &result = m_readyResults[i];
+        result.stroke = group.lastStroke;
+        result.strokes = group.strokes;
+        result.final = true;
+        result.submitted = group.released;
+        strokes += group.strokes;
+
+        // Single strokes GestureMatcher labelled keep that label; the rest
+        // are batched.
+        const StrokeMatch &match = m_matches[group.lastStroke % kMatches];
+        if (group.strokes == 1 && match.stroke == group.lastStroke && match.prediction) {
+            result.prediction = *match.prediction;
+            result.matched = true;
+            ++matched;
+            continue;
+        }
+        m_batchGroups.push_back(i);
+        m_batchPixels.push_back(group.pixels.data());
+    }
+
+    if (!m_batchGroups.empty()) {
+        m_batchPredictions.resize(m_batchGroups.size());
+        Recognizer::classifyBatch(m_batchPixels.data(), m_batchGroups.size(),
+                                  m_batchPredictions.data());
+        for (std::size_t b = 0; b < m_batchGroups.size(); ++b)
+            m_readyResults[m_batchGroups[b]].prediction = std::move(m_batchPredictions[b]);
+    }
+    const Clock::time_point classified = Clock::now();
+
+    for (Result &result: m_readyResults) {
+        result.classified = classified;
+        const uint64_t stroke = result.stroke;
+        if (!m_results.push(std::move(result))) {
+            std::cout << "[RecognizerService] Result mailbox full, dropping the symbol ending at "
+                      << "stroke " << stroke << "\n";
+        }
+    }
+    m_ready.clear();
+
+    m_symbols.fetch_add(count, std::memory_order_relaxed);
+    m_strokes.fetch_add(strokes, std::memory_order_relaxed);
+    m_matched.fetch_add(matched, std::memory_order_relaxed);
+    m_batches.fetch_add(1, std::memory_order_relaxed);
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(classified - start);
+    m_classifyNs.fetch_add(uint64_t(ns.count()), std::memory_order_relaxed);
+}
+
+void RecognizerService::workerThread() {
+    INK_PROFILE_THREAD("recognizer");
+    const auto liveInterval = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / std::max(m_settings.liveRateHz, 1e-3)));
+    Clock::time_point nextLive;
+    uint64_t lastFinal = 0;  // stroke number of the last finished stroke grouped
+    bool livePending = false;
+    // Without a follow-up wait the final result is as quick as a provisional one.
+    const bool provisional = m_settings.grouping.followUpSeconds > 0.0;
+
+    while (m_running.load(std::memory_order_acquire)) {
+        while (std::optional<Request> request = m_finals.pop()) {
+            StrokeMatch &match = m_matches[request->stroke % kMatches];
+            match = StrokeMatch{request->stroke, std::move(request->matched)};
+            const StrokeGrouper::Group &group = m_grouper.add(
+                    request->stroke, request->pixels.data(), request->started, request->submitted);
+            // A matched stroke on its own already has submitFinal()'s answer.
+            if (provisional && !(group.strokes == 1 && match.prediction)) {
+                INK_PROFILE_SCOPE("recognize provisional");
+                classifyProvisional(group);
+            }
+            lastFinal = request->stroke;
+        }
+        livePending |= m_live.acquire();
+        if (livePending) {
+            const Request &live = m_live.readSlot();
+            if (live.stroke <= lastFinal)
+                livePending = false;  // that stroke has its final answer
+            else
+                m_grouper.begin(live.stroke, live.started);  // may join an open symbol
+        }
+
+        const Clock::time_point now = Clock::now();
+        if (m_grouper.takeReady(now, m_ready) > 0) {
+            INK_PROFILE_SCOPE("recognize symbols");
+            classifyGroups();
+            continue;
+        }
+        if (livePending && now >= nextLive) {
+            INK_PROFILE_SCOPE("recognize live");
+            classifyLive(m_live.readSlot());
+            livePending = false;
+            nextLive = now + liveInterval;
+            continue;
+        }
+
+        // Sleep until a submit wakes us, a symbol's follow-up time is up or
+        // the next live slot comes round.
+        Clock::time_point until = std::min(now + kIdleWait, m_grouper.nextDeadline());
+        if (livePending)
+            until = std::min(until, nextLive);
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_wake.wait_until(lock, until, [this] {
+            return m_signalled.exchange(false, std::memory_order_acq_rel);
+        });
+    }
+}
@@ -0,0 +1,167 @@
+#pragma once
+
+#include "gestureMatcher.h"
+#include "recognizer.h"
+#include "spscRing.h"
+#include "strokeGrouper.h"
+#include "strokeRaster.h"
+#include "tripleBuffer.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Runs the Recognizer's classifier on its own thread, so the render thread
+ * never waits for inference and can ask for predictions while a stroke is
+ * still being drawn.
+ *
+ * The render thread hands over stroke rasters:
+ *  - submitLive() while drawing, as often as it likes. Requests coalesce
+ *    (the worker only ever sees the newest) and live rasters are classified
+ *    at most `liveRateHz` times a second; docs/drawing_recognition_plan.md
+ *    asks for 10-20 Hz while drawing.
+ *  - submitFinal() at release. Finished strokes are queued, never coalesced
+ *    or rate limited, and go ahead of live work; a live request for a
+ *    stroke that has finished is dropped.
+ * The worker groups finished strokes into symbols (StrokeGrouper: close in
+ * time and space) and hands every symbol that is ready to
+ * Recognizer::classifyBatch() together, one final result per symbol. That
+ * is still a per-symbol loop over the stub classifier; sharing work across
+ * the symbols waits for the trained TinyCnn (M5).
+ * `grouping.followUpSeconds` is how long after a release a symbol waits
+ * for another stroke before its final result. So that the wait does not
+ * delay every prediction, each release also gets a provisional result at
+ * once: the symbol as it stands, which may still gain strokes.
+ * A finished stroke whose points came with it goes through GestureMatcher
+ * in submitFinal(), before any grouping. A confident label (a dot, a line,
+ * a template shape) is published as a provisional result at once, without
+ * waiting for the worker; if the stroke stays a symbol of its own, that
+ * label is also its final result and it skips the raster classifier.
+ * Results come back through a lock-free mailbox drained by poll(). The
+ * render thread's side is a 4 KB copy and an atomic swap or push; waking
+ * the worker takes no lock (a wake-up lost to the race is bounded by the
+ * worker's idle timeout).
+ *
+ * Construct, submit, poll and destroy on one thread.
+ */
+class RecognizerService {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Settings {
+        double liveRateHz = 15.0;
+        StrokeGrouper::Settings grouping;
+        GestureMatcher::Settings matching;
+        std::string gestureTemplates = "assets/gestures/templates.json";  // "": none
+    };
+
+    struct Result {
+        Recognizer::Prediction prediction;
+        uint64_t stroke = 0;       // 1 for the first stroke, +1 per submitFinal()
+        uint32_t strokes = 1;      // strokes in the symbol so far, `stroke` the last
+        bool final = false;        // false: a live guess while drawing, or provisional
+        bool provisional = false;  // at release, before the symbol's final result
+        bool matched = false;      // by GestureMatcher, no raster classifier
+        Clock::time_point submitted, classified;  // submitted: the symbol's last release
+    };
+
+    /// Totals since construction, for throughput.
+    struct Stats {
+        uint64_t symbols = 0, strokes = 0, batches = 0;
+        uint64_t matched = 0;          // final symbols GestureMatcher labelled
+        double classifySeconds = 0.0;  // worker time in classifyBatch()
+
+        double symbolsPerSecond() const {
+            return classifySeconds > 0.0 ? symbols / classifySeconds : 0.0;
+        }
+    };
+
+    explicit RecognizerService(Settings settings);
+    RecognizerService() : RecognizerService(Settings{}) {
+    }
+    // Joins the worker; unclassified requests are dropped.
+    ~RecognizerService();
+
+    RecognizerService(const RecognizerService &) = delete;
+    RecognizerService &operator=(const RecognizerService &) = delete;
+
+    /// The in-progress stroke as drawn so far; replaces any unread one.
+    void submitLive(const StrokeRaster &raster);
+
+    /// The finished stroke; ends it, so later live requests belong to the
+    /// next one. False (and logged) if too many finished strokes are waiting.
+    /// `points` (normalized window coordinates, e.g. the simplified stroke)
+    /// enable the GestureMatcher fast path, which runs here (a few
+    /// microseconds) so a confident label is ready for the next poll().
+    bool submitFinal(const StrokeRaster &raster, const std::vector<glm::vec2> &points = {});
+
+    /// Oldest result not yet returned, the worker's before submitFinal()'s
+    /// own matches; std::nullopt if none. Never blocks.
+    std::optional<Result> poll();
+
+    /// Any thread; the counters are read one by one, so a batch finishing
+    /// meanwhile may show up in some of them only.
+    Stats stats() const;
+
+private:
+    static constexpr std::size_t kPixels = StrokeRaster::kSize * StrokeRaster::kSize;
+
+    struct Request {
+        std::array<unsigned char, kPixels> pixels;
+        uint64_t stroke = 0;
+        Clock::time_point started;  // the stroke's first submitLive(), else release
+        Clock::time_point submitted;
+        std::optional<Recognizer::Prediction> matched;  // finals: GestureMatcher's label
+    };
+
+    // A finished stroke's GestureMatcher label, kept by the worker until
+    // its symbol is done.
+    struct StrokeMatch {
+        uint64_t stroke = 0;
+        std::optional<Recognizer::Prediction> prediction;
+    };
+    static constexpr std::size_t kMatches = 16;  // strokes in open symbols, at most
+
+    void workerThread();
+    void classifyLive(const Request &request);
+    void classifyProvisional(const StrokeGrouper::Group &group);
+    void classifyGroups();
+    void wake();
+
+    Settings m_settings;
+    uint64_t m_stroke = 1;  // render thread: the stroke being drawn
+    Clock::time_point m_started;  // render thread: m_stroke's first submitLive()
+    bool m_drawing = false;
+    GestureMatcher m_matcher;  // render thread
+    SpscRing<Result, 8> m_matchedResults;  // render thread: submitFinal() to poll()
+
+    // Worker thread: strokes waiting for follow-ups, and the batch buffers.
+    StrokeGrouper m_grouper;
+    std::array<StrokeMatch, kMatches> m_matches;  // by stroke number % kMatches
+    std::vector<StrokeGrouper::Group> m_ready;
+    std::vector<Result> m_readyResults;
+    std::vector<std::size_t> m_batchGroups;  // m_ready index of each batch entry
+    std::vector<const unsigned char *> m_batchPixels;
+    std::vector<Recognizer::Prediction> m_batchPredictions;
+
+    TripleBuffer<Request> m_live;
+    SpscRing<Request, 8> m_finals;
+    SpscRing<Result, 64> m_results;
+
+    std::atomic<uint64_t> m_symbols{0}, m_strokes{0}, m_batches{0}, m_matched{0};
+    std::atomic<uint64_t> m_classifyNs{0};
+
+    std::atomic<bool> m_running{true};
+    std::atomic<bool> m_signalled{false};
+    std::mutex m_wakeMutex;  // only for m_wake; submitters never take it
+    std::condition_variable m_wake;
+    std::thread m_worker;
+};
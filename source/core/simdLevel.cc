@@ -0,0 +1,41 @@
+#include "simdLevel.h"
+
+SimdLevel bestSimdLevel() {
+#if defined(INK_SIMD_AVX2) && defined(__AVX2__)
+    return SimdLevel::avx2;
+#elif defined(INK_SIMD_AVX2)
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    return hasAvx2 ? SimdLevel::avx2 : SimdLevel::sse2;
+#elif defined(INK_SIMD_SSE2)
+    return SimdLevel::sse2;
+#elif defined(INK_SIMD_NEON)
+    return SimdLevel::neon;
+#else
+    return SimdLevel::scalar;
+#endif
+}
+
+bool simdLevelSupported(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::sse2:
+    case SimdLevel::avx2:
+        return bestSimdLevel() != SimdLevel::neon && level <= bestSimdLevel();
+    case SimdLevel::neon:
+        return bestSimdLevel() == SimdLevel::neon;
+    default:
+        return true;
+    }
+}
+
+const char *simdLevelName(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::avx2:
+        return "avx2";
+    case SimdLevel::sse2:
+        return "sse2";
+    case SimdLevel::neon:
+        return "neon";
+    default:
+        return "scalar";
+    }
+}
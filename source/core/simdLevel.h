@@ -0,0 +1,33 @@
+#pragma once
+
+// Which vector instruction sets this build can use. Kernels that vectorize
+// (overlapBatch, the TinyCnn layers) include <immintrin.h> / <arm_neon.h>
+// themselves under these macros and take a SimdLevel to pick a path.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define INK_SIMD_SSE2 1
+#endif
+
+// GCC/Clang can build the AVX path without -mavx2 and pick it at runtime;
+// MSVC only gets it when the whole build targets AVX2.
+#if defined(INK_SIMD_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#define INK_SIMD_AVX2 1
+#define INK_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(INK_SIMD_SSE2) && defined(__AVX2__)
+#define INK_SIMD_AVX2 1
+#define INK_TARGET_AVX2
+#endif
+
+#if defined(__ARM_NEON) || defined(_M_ARM64)
+#define INK_SIMD_NEON 1
+#endif
+
+// Kernel width; bestSimdLevel() picks the widest the CPU runs. A kernel
+// without a path for the requested level runs its scalar one.
+enum class SimdLevel { scalar, sse2, avx2, neon };
+
+SimdLevel bestSimdLevel();
+
+// Whether this build and CPU can run `level` (scalar always can).
+bool simdLevelSupported(SimdLevel level);
+
+const char *simdLevelName(SimdLevel level);
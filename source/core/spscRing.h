@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+/**
+ * Bounded lock-free queue for exactly one producer thread and one consumer
+ * thread (they may be the same thread).
+ *
+ * The producer only writes m_head and the consumer only writes m_tail, so
+ * neither ever waits on the other: push() fails when the ring is full and
+ * pop() returns nothing when it is empty. `Capacity` must be a power of two.
+ */
+template <class T, std::size_t Capacity>
+class SpscRing {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscRing capacity must be a power of two");
+
+public:
+    /// Producer: false (and `value` is untouched) if the ring is full.
+    bool push(T &&value) {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) == Capacity)
+            return false;
+        m_slots[head & (Capacity - 1)] = std::move(value);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer: the oldest element, or std::nullopt if the ring is empty.
+    std::optional<T> pop() {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire))
+            return std::nullopt;
+        std::optional<T> value(std::move(m_slots[tail & (Capacity - 1)]));
+        m_tail.store(tail + 1, std::memory_order_release);
+        return value;
+    }
+
+    /// Either side; exact only on the consumer thread.
+    bool empty() const {
+        return m_tail.load(std::memory_order_acquire) == m_head.load(std::memory_order_acquire);
+    }
+
+private:
+    // Each index on its own cache line, so the two threads don't false-share.
+    alignas(64) std::atomic<std::size_t> m_head{0};
+    alignas(64) std::atomic<std::size_t> m_tail{0};
+    std::array<T, Capacity> m_slots{};
+};
@@ -0,0 +1,109 @@
+#include "strokeGrouper.h"
+
+#include "strokePreprocess.h"
+
+#include <algorithm>
+#include <climits>
+
+namespace {
+// Pixels of clear space between two boxes along the axis where they are
+// furthest apart; 0 when they touch or overlap.
+int gap(const StrokeGrouper::Box& a, const StrokeGrouper::Box& b) {
+    const int dx = std::max(a.minX - b.maxX, b.minX - a.maxX) - 1;
+    const int dy = std::max(a.minY - b.maxY, b.minY - a.maxY) - 1;
+    return std::max({dx, dy, 0});
+}
+}  // namespace
+
+StrokeGrouper::StrokeGrouper(Settings settings)
+    : m_settings(settings),
+      m_followUp(std::chrono::duration_cast<Clock::duration>(
+              std::chrono::duration<double>(std::max(settings.followUpSeconds, 0.0)))) {
+    m_open.reserve(8);
+}
+
+void StrokeGrouper::begin(uint64_t stroke, Clock::time_point started) {
+    if (stroke <= m_lastAdded || stroke == m_drawing)
+        return;
+    m_drawing = stroke;
+    m_drawingStarted = started;
+}
+
+bool StrokeGrouper::heldBack(const Group& group) const {
+    return m_drawing > group.lastStroke && m_drawingStarted <= group.released + m_followUp;
+}
+
+const StrokeGrouper::Group& StrokeGrouper::add(uint64_t stroke, const unsigned char* pixels,
+                                               Clock::time_point started,
+                                               Clock::time_point released) {
+    const StrokePreprocess::Moments m = StrokePreprocess::measure(pixels);
+    Box box;
+    if (!m.empty())
+        box = Box{m.minX, m.minY, m.maxX, m.maxY};
+
+    Group* join = nullptr;
+    int nearest = INT_MAX;
+    if (!box.empty() && m_followUp.count() > 0) {
+        for (Group& group: m_open) {
+            if (group.box.empty() || started > group.released + m_followUp)
+                continue;
+            const int d = gap(box, group.box);
+            if (d <= m_settings.joinDistance && d < nearest) {
+                join = &group;
+                nearest = d;
+            }
+        }
+    }
+
+    if (join) {
+        for (std::size_t i = 0; i < kPixels; ++i)
+            join->pixels[i] = std::max(join->pixels[i], pixels[i]);
+        join->box.minX = std::min(join->box.minX, box.minX);
+        join->box.minY = std::min(join->box.minY, box.minY);
+        join->box.maxX = std::max(join->box.maxX, box.maxX);
+        join->box.maxY = std::max(join->box.maxY, box.maxY);
+        join->lastStroke = stroke;
+        join->released = std::max(join->released, released);
+        ++join->strokes;
+    } else {
+        m_open.emplace_back();
+        join = &m_open.back();
+        std::copy(pixels, pixels + kPixels, join->pixels.begin());
+        join->box = box;
+        join->firstStroke = join->lastStroke = stroke;
+        join->strokes = 1;
+        join->started = started;
+        join->released = released;
+    }
+
+    m_lastAdded = stroke;
+    if (m_drawing <= stroke)
+        m_drawing = 0;
+    return *join;
+}
+
+std::size_t StrokeGrouper::takeReady(Clock::time_point now, std::vector<Group>& out) {
+    std::size_t taken = 0;
+    auto keep = m_open.begin();
+    for (auto it = m_open.begin(); it != m_open.end(); ++it) {
+        if (now >= it->released + m_followUp && !heldBack(*it)) {
+            out.push_back(std::move(*it));
+            ++taken;
+        } else {
+            if (keep != it)
+                *keep = std::move(*it);
+            ++keep;
+        }
+    }
+    m_open.erase(keep, m_open.end());
+    return taken;
+}
+
+StrokeGrouper::Clock::time_point StrokeGrouper::nextDeadline() const {
+    Clock::time_point next = Clock::time_point::max();
+    for (const Group& group: m_open) {
+        if (!heldBack(group))
+            next = std::min(next, group.released + m_followUp);
+    }
+    return next;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "strokeRaster.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// StrokeGrouper
+// - Clusters finished strokes into candidate symbols, so a glyph drawn in
+//   several strokes ("+", "=", an arrow) is classified once, as a whole.
+// - A stroke joins an open group when it was started within
+//   `followUpSeconds` of the group's last release and its ink box comes
+//   within `joinDistance` raster pixels of the group's (the nearest such
+//   group if there are several); otherwise it starts a group of its own.
+//   Strokes drawn far apart in quick succession stay separate symbols.
+// - A group is complete `followUpSeconds` after its last release, unless a
+//   stroke started before then is still being drawn (it may yet join).
+//   That makes followUpSeconds the latency budget: each symbol waits that
+//   long for follow-up strokes before it is complete. At 0 every stroke is
+//   a symbol of its own, ready at release. The default, 0.3 s, is the
+//   shortest wait that keeps every multi-stroke symbol of strokeGrouperBench
+//   together (0.2 s splits about one in five); RecognizerService covers the
+//   wait with a provisional result at release.
+// - A group keeps the union of its strokes' rasters. Every StrokeRaster
+//   covers the whole window, so they overlay without any transform.
+//
+// Stroke numbers must increase. Not thread safe: RecognizerService drives
+// one from its worker thread.
+class StrokeGrouper {
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr std::size_t kPixels = StrokeRaster::kSize * StrokeRaster::kSize;
+
+    struct Settings {
+        double followUpSeconds = 0.3;
+        int joinDistance = 6;  // raster pixels (64 across the window)
+    };
+
+    /// Inclusive ink box in raster pixels; empty until a stroke with ink joins.
+    struct Box {
+        int minX = StrokeRaster::kSize, minY = StrokeRaster::kSize, maxX = -1, maxY = -1;
+        bool empty() const { return maxX < minX; }
+    };
+
+    struct Group {
+        std::array<unsigned char, kPixels> pixels;  // per pixel, max over the strokes
+        Box box;
+        uint64_t firstStroke = 0, lastStroke = 0;
+        uint32_t strokes = 0;
+        Clock::time_point started, released;  // first stroke's start, last one's release
+    };
+
+    explicit StrokeGrouper(Settings settings);
+    StrokeGrouper() : StrokeGrouper(Settings{}) {}
+
+    /// Stroke `stroke`, started at `started`, is being drawn: groups it may
+    /// join are held back until it is add()ed.
+    void begin(uint64_t stroke, Clock::time_point started);
+
+    /// A finished stroke's raster (StrokeRaster::pixels()). Returns the
+    /// group it went into, valid until the next add() or takeReady().
+    const Group& add(uint64_t stroke, const unsigned char* pixels, Clock::time_point started,
+                     Clock::time_point released);
+
+    /// Move the groups complete at `now` to the end of `out`, oldest first;
+    /// returns how many.
+    std::size_t takeReady(Clock::time_point now, std::vector<Group>& out);
+
+    /// When the next group completes unless a stroke is added first;
+    /// Clock::time_point::max() if none is waiting only on the clock.
+    Clock::time_point nextDeadline() const;
+
+    std::size_t openGroups() const { return m_open.size(); }
+    const Settings& settings() const { return m_settings; }
+
+private:
+    // A group whose follow-up window is over but may still gain the stroke
+    // being drawn.
+    bool heldBack(const Group& group) const;
+
+    Settings m_settings;
+    Clock::duration m_followUp;
+    std::vector<Group> m_open;  // oldest first
+    uint64_t m_lastAdded = 0;
+    uint64_t m_drawing = 0;  // stroke being drawn, 0 if none
+    Clock::time_point m_drawingStarted;
+};
@@ -0,0 +1,321 @@
+#include "strokePreprocess.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#ifdef INK_SIMD_SSE2
+#include <immintrin.h>
+#endif
+#ifdef INK_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+using StrokePreprocess::kSize;
+using StrokePreprocess::Moments;
+
+namespace {
+static_assert(kSize == 64, "the SIMD passes walk a row as 64 bytes");
+
+// What a pass gathers: sum v and sum v*x per row, sum v*x^2 over the
+// image, and bit x of `columns` set when column x has ink. finish() turns
+// the row sums into the y-weighted moments after the vector loop, so that
+// loop makes no calls.
+struct RowSums {
+    uint32_t mass[kSize];
+    uint32_t sumX[kSize];
+    uint64_t sumXX = 0;
+    uint64_t columns = 0;
+};
+
+Moments finish(const RowSums &r) {
+    Moments m;
+    for (int y = 0; y < kSize; ++y) {
+        if (r.mass[y] == 0)
+            continue;
+        m.minY = std::min(m.minY, y);
+        m.maxY = y;
+        m.mass += r.mass[y];
+        m.sumX += r.sumX[y];
+        m.sumY += uint64_t(y) * r.mass[y];
+        m.sumYY += uint64_t(y) * y * r.mass[y];
+        m.sumXY += uint64_t(y) * r.sumX[y];
+    }
+    m.sumXX = r.sumXX;
+    if (r.columns != 0) {
+        int x = 0;
+        while (!(r.columns >> x & 1))
+            ++x;
+        m.minX = x;
+        x = kSize - 1;
+        while (!(r.columns >> x & 1))
+            --x;
+        m.maxX = x;
+    }
+    return m;
+}
+
+Moments measureScalar(const unsigned char *pixels) {
+    RowSums r;
+    for (int y = 0; y < kSize; ++y) {
+        const unsigned char *row = pixels + y * kSize;
+        uint32_t mass = 0, sumX = 0, sumXX = 0;
+        for (int x = 0; x < kSize; ++x) {
+            const uint32_t v = row[x];
+            mass += v;
+            sumX += v * x;
+            sumXX += v * x * x;
+            r.columns |= uint64_t(v != 0) << x;
+        }
+        r.mass[y] = mass;
+        r.sumX[y] = sumX;
+        r.sumXX += sumXX;
+    }
+    return finish(r);
+}
+
+#ifdef INK_SIMD_SSE2
+// Eight pixels widened to 16 bits: pmaddwd against x and x^2 (x^2 <= 3969
+// fits an int16) sums v*x and v*x^2 in pairs. A lane of the image-wide
+// v*x^2 accumulator sees 1024 pixels, at most 1024 * 255 * 3969 < 2^31.
+Moments measureSse2(const unsigned char *pixels) {
+    __m128i xs[8], xxs[8];
+    for (int i = 0; i < 8; ++i) {
+        alignas(16) int16_t x[8], xx[8];
+        for (int j = 0; j < 8; ++j) {
+            x[j] = int16_t(i * 8 + j);
+            xx[j] = int16_t(x[j] * x[j]);
+        }
+        xs[i] = _mm_load_si128(reinterpret_cast<const __m128i *>(x));
+        xxs[i] = _mm_load_si128(reinterpret_cast<const __m128i *>(xx));
+    }
+    const __m128i zero = _mm_setzero_si128();
+    __m128i sumXX = zero;
+    __m128i columns[4] = {zero, zero, zero, zero};
+
+    RowSums r;
+    for (int y = 0; y < kSize; ++y) {
+        const unsigned char *row = pixels + y * kSize;
+        __m128i mass = zero, sumX = zero;
+        for (int i = 0; i < 4; ++i) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + 16 * i));
+            columns[i] = _mm_or_si128(columns[i], v);
+            mass = _mm_add_epi64(mass, _mm_sad_epu8(v, zero));
+            const __m128i lo = _mm_unpacklo_epi8(v, zero);
+            const __m128i hi = _mm_unpackhi_epi8(v, zero);
+            sumX = _mm_add_epi32(sumX, _mm_add_epi32(_mm_madd_epi16(lo, xs[2 * i]),
+                                                     _mm_madd_epi16(hi, xs[2 * i + 1])));
+            sumXX = _mm_add_epi32(sumXX, _mm_add_epi32(_mm_madd_epi16(lo, xxs[2 * i]),
+                                                       _mm_madd_epi16(hi, xxs[2 * i + 1])));
+        }
+        sumX = _mm_add_epi32(sumX, _mm_shuffle_epi32(sumX, 0x4e));
+        sumX = _mm_add_epi32(sumX, _mm_shuffle_epi32(sumX, 0xb1));
+        mass = _mm_add_epi64(mass, _mm_unpackhi_epi64(mass, mass));
+        r.mass[y] = uint32_t(_mm_cvtsi128_si32(mass));
+        r.sumX[y] = uint32_t(_mm_cvtsi128_si32(sumX));
+    }
+
+    alignas(16) uint32_t lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i *>(lanes), sumXX);
+    r.sumXX = uint64_t(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+    for (int i = 0; i < 4; ++i) {
+        const int empty = _mm_movemask_epi8(_mm_cmpeq_epi8(columns[i], zero));
+        r.columns |= uint64_t(~empty & 0xffff) << (16 * i);
+    }
+    return finish(r);
+}
+#endif
+
+#ifdef INK_SIMD_AVX2
+// measureSse2 at sixteen pixels a step.
+INK_TARGET_AVX2
+Moments measureAvx2(const unsigned char *pixels) {
+    __m256i xs[4], xxs[4];
+    for (int i = 0; i < 4; ++i) {
+        alignas(32) int16_t x[16], xx[16];
+        for (int j = 0; j < 16; ++j) {
+            x[j] = int16_t(i * 16 + j);
+            xx[j] = int16_t(x[j] * x[j]);
+        }
+        xs[i] = _mm256_load_si256(reinterpret_cast<const __m256i *>(x));
+        xxs[i] = _mm256_load_si256(reinterpret_cast<const __m256i *>(xx));
+    }
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i sumXX = zero;
+    __m256i columns[2] = {zero, zero};
+
+    RowSums r;
+    for (int y = 0; y < kSize; ++y) {
+        const unsigned char *row = pixels + y * kSize;
+        __m256i mass = zero, sumX = zero;
+        for (int i = 0; i < 2; ++i) {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row + 32 * i));
+            columns[i] = _mm256_or_si256(columns[i], v);
+            mass = _mm256_add_epi64(mass, _mm256_sad_epu8(v, zero));
+            const __m256i lo = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(v));
+            const __m256i hi = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(v, 1));
+            sumX = _mm256_add_epi32(sumX, _mm256_add_epi32(_mm256_madd_epi16(lo, xs[2 * i]),
+                                                           _mm256_madd_epi16(hi, xs[2 * i + 1])));
+            sumXX = _mm256_add_epi32(sumXX,
+                                     _mm256_add_epi32(_mm256_madd_epi16(lo, xxs[2 * i]),
+                                                      _mm256_madd_epi16(hi, xxs[2 * i + 1])));
+        }
+        __m128i x4 = _mm_add_epi32(_mm256_castsi256_si128(sumX), _mm256_extracti128_si256(sumX, 1));
+        x4 = _mm_add_epi32(x4, _mm_shuffle_epi32(x4, 0x4e));
+        x4 = _mm_add_epi32(x4, _mm_shuffle_epi32(x4, 0xb1));
+        __m128i m2 = _mm_add_epi64(_mm256_castsi256_si128(mass), _mm256_extracti128_si256(mass, 1));
+        m2 = _mm_add_epi64(m2, _mm_unpackhi_epi64(m2, m2));
+        r.mass[y] = uint32_t(_mm_cvtsi128_si32(m2));
+        r.sumX[y] = uint32_t(_mm_cvtsi128_si32(x4));
+    }
+
+    alignas(32) uint32_t lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), sumXX);
+    for (uint32_t lane: lanes)
+        r.sumXX += lane;
+    for (int i = 0; i < 2; ++i) {
+        const uint32_t empty = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(columns[i], zero)));
+        r.columns |= uint64_t(~empty) << (32 * i);
+    }
+    _mm256_zeroupper();
+    return finish(r);
+}
+#endif
+
+#ifdef INK_SIMD_NEON
+inline uint32_t sumNeon(uint32x4_t v) {
+#if defined(__aarch64__) || defined(_M_ARM64)
+    return vaddvq_u32(v);
+#else
+    const uint32x2_t s = vadd_u32(vget_low_u32(v), vget_high_u32(v));
+    return vget_lane_u32(vpadd_u32(s, s), 0);
+#endif
+}
+
+// Widening multiply-accumulates into 32-bit lanes, eight pixels a step.
+Moments measureNeon(const unsigned char *pixels) {
+    uint16x8_t xs[8], xxs[8];
+    for (int i = 0; i < 8; ++i) {
+        uint16_t x[8], xx[8];
+        for (int j = 0; j < 8; ++j) {
+            x[j] = uint16_t(i * 8 + j);
+            xx[j] = uint16_t(x[j] * x[j]);
+        }
+        xs[i] = vld1q_u16(x);
+        xxs[i] = vld1q_u16(xx);
+    }
+    uint32x4_t sumXX = vdupq_n_u32(0);
+    uint8x16_t columns[4] = {vdupq_n_u8(0), vdupq_n_u8(0), vdupq_n_u8(0), vdupq_n_u8(0)};
+
+    RowSums r;
+    for (int y = 0; y < kSize; ++y) {
+        const unsigned char *row = pixels + y * kSize;
+        uint32x4_t mass = vdupq_n_u32(0), sumX = vdupq_n_u32(0);
+        for (int i = 0; i < 4; ++i) {
+            const uint8x16_t v = vld1q_u8(row + 16 * i);
+            columns[i] = vorrq_u8(columns[i], v);
+            mass = vpadalq_u16(mass, vpaddlq_u8(v));
+            const uint16x8_t halves[2] = {vmovl_u8(vget_low_u8(v)), vmovl_u8(vget_high_u8(v))};
+            for (int h = 0; h < 2; ++h) {
+                const uint16x8_t w = halves[h];
+                const uint16x8_t x = xs[2 * i + h], xx = xxs[2 * i + h];
+                sumX = vmlal_u16(sumX, vget_low_u16(w), vget_low_u16(x));
+                sumX = vmlal_u16(sumX, vget_high_u16(w), vget_high_u16(x));
+                sumXX = vmlal_u16(sumXX, vget_low_u16(w), vget_low_u16(xx));
+                sumXX = vmlal_u16(sumXX, vget_high_u16(w), vget_high_u16(xx));
+            }
+        }
+        r.mass[y] = sumNeon(mass);
+        r.sumX[y] = sumNeon(sumX);
+    }
+
+    r.sumXX = sumNeon(sumXX);
+    uint8_t occupied[kSize];
+    for (int i = 0; i < 4; ++i)
+        vst1q_u8(occupied + 16 * i, columns[i]);
+    for (int x = 0; x < kSize; ++x)
+        r.columns |= uint64_t(occupied[x] != 0) << x;
+    return finish(r);
+}
+#endif
+
+// Source pixels an output pixel covers along one axis, with the fraction
+// of the output pixel each one fills (they sum to 1 inside the image).
+struct Taps {
+    static constexpr int kMax = 5;  // covers up to kSize / kFit + 2 source pixels
+    int first = 0, count = 0;
+    float weight[kMax] = {};
+};
+
+// Output pixel o spans [o, o + 1); source coordinate = (o - kOutput / 2) /
+// scale + centre. Only [lo, hi) can hold ink.
+void makeTaps(double centre, double scale, int lo, int hi, Taps *taps) {
+    for (int o = 0; o < StrokePreprocess::kOutput; ++o) {
+        const double a = (o - StrokePreprocess::kOutput / 2) / scale + centre;
+        const double b = a + 1.0 / scale;
+        Taps &t = taps[o];
+        t.first = std::max(lo, int(std::floor(a)));
+        const int last = std::min(hi, int(std::ceil(b)));
+        t.count = std::max(0, std::min(last - t.first, Taps::kMax));
+        for (int i = 0; i < t.count; ++i) {
+            const int s = t.first + i;
+            t.weight[i] = float((std::min(b, double(s + 1)) - std::max(a, double(s))) * scale);
+        }
+    }
+}
+}  // namespace
+
+Moments StrokePreprocess::measure(const unsigned char *pixels, SimdLevel level) {
+    switch (level) {
+#ifdef INK_SIMD_AVX2
+    case SimdLevel::avx2:
+        return measureAvx2(pixels);
+#endif
+#ifdef INK_SIMD_SSE2
+    case SimdLevel::sse2:
+        return measureSse2(pixels);
+#endif
+#ifdef INK_SIMD_NEON
+    case SimdLevel::neon:
+        return measureNeon(pixels);
+#endif
+    default:
+        return measureScalar(pixels);
+    }
+}
+
+void StrokePreprocess::resample(const unsigned char *pixels, const Moments &moments, float *out) {
+    std::fill(out, out + kOutput * kOutput, 0.0f);
+    if (moments.empty())
+        return;
+
+    const int boxSide = std::max(moments.maxX - moments.minX, moments.maxY - moments.minY) + 1;
+    const double scale = double(kFit) / boxSide;
+    Taps tapsX[kOutput], tapsY[kOutput];
+    // +0.5: pixel x's centre is at coordinate x + 0.5.
+    makeTaps(moments.centroidX() + 0.5, scale, moments.minX, moments.maxX + 1, tapsX);
+    makeTaps(moments.centroidY() + 0.5, scale, moments.minY, moments.maxY + 1, tapsY);
+
+    // Horizontal pass over the rows with ink, then vertical into `out`.
+    float rows[kSize][kOutput];
+    for (int y = moments.minY; y <= moments.maxY; ++y) {
+        const unsigned char *src = pixels + y * kSize;
+        for (int o = 0; o < kOutput; ++o) {
+            const Taps &t = tapsX[o];
+            float sum = 0.0f;
+            for (int i = 0; i < t.count; ++i)
+                sum += t.weight[i] * src[t.first + i];
+            rows[y][o] = sum;
+        }
+    }
+    for (int o = 0; o < kOutput; ++o) {
+        const Taps &t = tapsY[o];
+        float *dst = out + o * kOutput;
+        for (int i = 0; i < t.count; ++i) {
+            const float w = t.weight[i] * (1.0f / 255.0f);
+            const float *src = rows[t.first + i];
+            for (int x = 0; x < kOutput; ++x)
+                dst[x] += w * src[x];
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "simdLevel.h"
+#include "strokeRaster.h"
+
+#include <cstdint>
+
+// Turns a StrokeRaster into classifier input, following the plan in
+// docs/drawing_recognition_plan.md (MNIST-style): ink bounding box scaled
+// so its longer side is kFit pixels, placed in a kOutput x kOutput frame
+// with the centre of mass in the middle, values in [0, 1].
+//
+// - measure() gathers everything that needs (bounding box, ink mass, first
+//   and second moments) in one integer pass over the raster: a few
+//   multiply-adds per pixel at 8 or 16 pixels a step, exact at any level.
+// - resample() area-filters the box into the output, separably (each
+//   output pixel averages the source pixels it covers), and writes floats
+//   wherever the caller points it, e.g. straight into TinyCnn::input().
+namespace StrokePreprocess {
+
+constexpr int kSize = StrokeRaster::kSize;  // input raster side
+constexpr int kOutput = 28;
+constexpr int kFit = 20;
+
+// Sums over the raster with pixel values v (0..255) as weights; x and y
+// are pixel indices (0 at the left / top).
+struct Moments {
+    int minX = kSize, minY = kSize, maxX = -1, maxY = -1;  // inclusive ink box
+    uint64_t mass = 0;          // sum v
+    uint64_t sumX = 0, sumY = 0;  // sum v x, sum v y
+    uint64_t sumXX = 0, sumYY = 0, sumXY = 0;
+
+    bool empty() const {
+        return mass == 0;
+    }
+    // Centre of mass in pixel indices; only meaningful when !empty().
+    double centroidX() const {
+        return double(sumX) / double(mass);
+    }
+    double centroidY() const {
+        return double(sumY) / double(mass);
+    }
+    // Second central moments (spread along x, along y), mass-weighted.
+    double varianceX() const {
+        return double(sumXX) - double(sumX) * double(sumX) / double(mass);
+    }
+    double varianceY() const {
+        return double(sumYY) - double(sumY) * double(sumY) / double(mass);
+    }
+};
+
+// One pass over kSize x kSize pixels (StrokeRaster::pixels()).
+Moments measure(const unsigned char *pixels, SimdLevel level = bestSimdLevel());
+
+// Write kOutput * kOutput floats to `out`, row-major; all zero when the
+// raster is empty. `moments` must be measure()'s for the same pixels.
+void resample(const unsigned char *pixels, const Moments &moments, float *out);
+
+}  // namespace StrokePreprocess
@@ -0,0 +1,52 @@
+#include "strokeRaster.h"
+
+#include "drawing.h"
+
+#include <algorithm>
+
+StrokeRaster::StrokeRaster() : m_pixels(kSize * kSize, 0) {
+    markDirty(0, 0, kSize, kSize);
+}
+
+void StrokeRaster::clear() {
+    std::fill(m_pixels.begin(), m_pixels.end(), 0);
+    m_points = 0;
+    markDirty(0, 0, kSize, kSize);
+}
+
+glm::ivec2 StrokeRaster::toPixel(const glm::vec2& p) {
+    const glm::vec2 n = glm::clamp(p, 0.0f, 1.0f);
+    return glm::ivec2(static_cast<int>(n.x * (kSize - 1) + 0.5f),
+                      static_cast<int>(n.y * (kSize - 1) + 0.5f));
+}
+
+void StrokeRaster::extend(const std::vector<glm::vec2>& points) {
+    Raster::ImageGray img{m_pixels.data(), kSize, kSize};
+    for (; m_points < points.size(); ++m_points) {
+        const glm::ivec2 p = toPixel(points[m_points]);
+        if (m_points == 0) {
+            Raster::drawDisc(img, p.x, p.y, kRadius, 255);
+        } else if (p != m_last) {
+            Raster::drawLine(img, m_last.x, m_last.y, p.x, p.y, kRadius, 255);
+        } else {
+            continue;  // same pixel: already drawn
+        }
+        const glm::ivec2 lo = glm::min(p, m_points == 0 ? p : m_last) - kRadius;
+        const glm::ivec2 hi = glm::max(p, m_points == 0 ? p : m_last) + kRadius + 1;
+        markDirty(lo.x, lo.y, hi.x, hi.y);
+        m_last = p;
+    }
+}
+
+StrokeRaster::DirtyRect StrokeRaster::takeDirty() {
+    const DirtyRect dirty = m_dirty;
+    m_dirty = DirtyRect{};
+    return dirty;
+}
+
+void StrokeRaster::markDirty(int x0, int y0, int x1, int y1) {
+    m_dirty.x0 = std::max(0, std::min(m_dirty.x0, x0));
+    m_dirty.y0 = std::max(0, std::min(m_dirty.y0, y0));
+    m_dirty.x1 = std::min(kSize, std::max(m_dirty.x1, x1));
+    m_dirty.y1 = std::min(kSize, std::max(m_dirty.y1, y1));
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <vector>
+
+// StrokeRaster
+// - Persistent 64x64 grayscale raster of one stroke, drawn incrementally:
+//   extend() only draws the segments added since the last call, so keeping
+//   it current costs O(new points), not O(stroke length).
+// - Tracks the rectangle changed since the last takeDirty(), for callers
+//   that mirror the raster somewhere else (CanvasOverlay's RGBA texture).
+// - The same pixels the recognizer classifies: it takes a finished raster
+//   (Recognizer::submitRaster) instead of drawing the stroke again.
+//
+// Input is StrokeRecorder's normalized window coordinates (origin top-left,
+// clamped to [0,1]); pixel row 0 is the top of the window.
+class StrokeRaster {
+public:
+    static constexpr int kSize = 64;
+    /// Brush radius in pixels (~2-3 px lines).
+    static constexpr int kRadius = 1;
+
+    /// Half-open pixel rectangle [x0,x1) x [y0,y1).
+    struct DirtyRect {
+        int x0 = kSize, y0 = kSize, x1 = 0, y1 = 0;
+        bool empty() const { return x0 >= x1 || y0 >= y1; }
+    };
+
+    StrokeRaster();
+
+    /// Blank raster for a new stroke; everything becomes dirty.
+    void clear();
+
+    /// Draw points[pointCount()..] on top of what is there; `points` must
+    /// start with the points already drawn since clear().
+    void extend(const std::vector<glm::vec2>& points);
+
+    /// Stroke points drawn since clear().
+    std::size_t pointCount() const { return m_points; }
+
+    /// kSize * kSize bytes, row-major from the top, 0 background / 255 ink.
+    const unsigned char* pixels() const { return m_pixels.data(); }
+
+    /// The rectangle changed since the last call (possibly empty); resets it.
+    DirtyRect takeDirty();
+
+    /// Pixel a normalized window point lands on.
+    static glm::ivec2 toPixel(const glm::vec2& p);
+
+private:
+    void markDirty(int x0, int y0, int x1, int y1);
+
+    std::vector<unsigned char> m_pixels;
+    std::size_t m_points = 0;
+    glm::ivec2 m_last{0};  // pixel of the last point drawn
+    DirtyRect m_dirty;
+};
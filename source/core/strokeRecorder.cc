@@ -1,95 +1,153 @@
 #include "strokeRecorder.h"
+#include "strokeSimplifier.h"
 
 #include <algorithm>
+#include <cstring>
 #include <iostream>
 
+namespace {
+template <class T>
+uint64_t pack(const T& v) {
+    static_assert(sizeof(T) == sizeof(uint64_t), "log slots are 64-bit");
+    uint64_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    return bits;
+}
+
+template <class T>
+T unpack(uint64_t bits) {
+    T v;
+    std::memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+}  // namespace
+
 StrokeRecorder* StrokeRecorder::instance() {
     static StrokeRecorder s;
     return &s;
 }
 
-glm::vec2 StrokeRecorder::normalizeToWindow(GLFWwindow* win, double x, double y) {
-    int w = 1, h = 1;
-    glfwGetWindowSize(win, &w, &h);
-    if (w <= 0) w = 1;
-    if (h <= 0) h = 1;
-    // Origin top-left; y increases downward
-    return glm::vec2(static_cast<float>(x / static_cast<double>(w)),
-                     static_cast<float>(y / static_cast<double>(h)));
+StrokeRecorder::StrokeRecorder()
+    : m_log(new std::atomic<uint64_t>[kPointLogSize]),
+      m_timeLog(new std::atomic<uint64_t>[kPointLogSize]) {}
+
+glm::vec2 StrokeRecorder::pointAt(uint64_t index) const {
+    return unpack<glm::vec2>(m_log[index & (kPointLogSize - 1)].load(std::memory_order_relaxed));
+}
+
+double StrokeRecorder::timeAt(uint64_t index) const {
+    return unpack<double>(m_timeLog[index & (kPointLogSize - 1)].load(std::memory_order_relaxed));
 }
 
 void StrokeRecorder::beginStroke(double now) {
-    m_current = Stroke{};
-    m_current.startTime = now;
-    m_state = State::Drawing;
+    m_begin = m_head.load(std::memory_order_relaxed);
+    m_startTime = now;
+    m_hasLast = false;
+    m_currentBegin.store(m_begin, std::memory_order_relaxed);
+    m_serial.fetch_add(1, std::memory_order_release);
 }
 
-void StrokeRecorder::appendPoint(const glm::vec2& p) {
+void StrokeRecorder::appendPoint(const glm::vec2& p, double now) {
     // Optional: dedupe if not moved enough
-    if (!m_current.points.empty()) {
-        const glm::vec2 d = p - m_current.points.back();
+    if (m_hasLast) {
+        const glm::vec2 d = p - m_last;
         const float dist2 = d.x * d.x + d.y * d.y;
         // ~1px at 1000px dimension -> threshold ~1e-6 in normalized coords
         if (dist2 < 1e-7f) return;
     }
-    m_current.points.emplace_back(p);
+    m_last = p;
+    m_hasLast = true;
+    const uint64_t head = m_head.load(std::memory_order_relaxed);
+    m_log[head & (kPointLogSize - 1)].store(pack(p), std::memory_order_relaxed);
+    m_timeLog[head & (kPointLogSize - 1)].store(pack(now), std::memory_order_relaxed);
+    m_head.store(head + 1, std::memory_order_release);  // publishes the point
 }
 
 void StrokeRecorder::endStroke(double now) {
-    m_current.endTime = now;
-    if (!m_current.points.empty()) {
-        m_completed.emplace_back(std::move(m_current));
+    const uint64_t end = m_head.load(std::memory_order_relaxed);
+    m_serial.fetch_add(1, std::memory_order_release);
+    if (end == m_begin) return;  // no points: nothing to recognize
+    if (!m_completed.push({m_begin, end, m_startTime, now})) {
+        std::cout << "[StrokeRecorder] Completed-stroke queue full, dropping a stroke of "
+                  << (end - m_begin) << " points\n";
     }
-    m_current = Stroke{};
-    m_state = State::Idle;
 }
 
-void StrokeRecorder::poll() {
-    GLFWwindow* win = glfwGetCurrentContext();
-    if (!win) return;
-
-    const int btn = glfwGetMouseButton(win, GLFW_MOUSE_BUTTON_LEFT);
-    const bool pressed = (btn == GLFW_PRESS);
-    const double now = glfwGetTime();
-
+void StrokeRecorder::feed(bool pressed, const glm::vec2& point, double now) {
     if (pressed && !m_wasPressedLastFrame) {
         // Edge: press started
-        std::lock_guard<std::mutex> lk(m_mutex);
         beginStroke(now);
     }
 
     if (pressed) {
         // Record point
-        double cx = 0.0, cy = 0.0;
-        glfwGetCursorPos(win, &cx, &cy);
-        const glm::vec2 p = normalizeToWindow(win, cx, cy);
-        std::lock_guard<std::mutex> lk(m_mutex);
-        if (m_state == State::Drawing) appendPoint(p);
+        appendPoint(point, now);
     }
 
     if (!pressed && m_wasPressedLastFrame) {
         // Edge: release
-        std::lock_guard<std::mutex> lk(m_mutex);
-        if (m_state == State::Drawing) endStroke(now);
+        endStroke(now);
     }
 
     m_wasPressedLastFrame = pressed;
 }
 
+void StrokeRecorder::cursorMoved(const glm::vec2& point, double now) {
+    m_cursor = point;
+    if (m_wasPressedLastFrame) feed(true, point, now);
+}
+
+void StrokeRecorder::buttonChanged(bool pressed, double now) {
+    feed(pressed, m_cursor, now);
+}
+
+StrokeRecorder::State StrokeRecorder::state() const {
+    return (m_serial.load(std::memory_order_acquire) & 1) ? State::Drawing : State::Idle;
+}
+
 bool StrokeRecorder::hasCompletedStroke() const {
-    std::lock_guard<std::mutex> lk(m_mutex);
     return !m_completed.empty();
 }
 
 std::optional<StrokeRecorder::Stroke> StrokeRecorder::popCompletedStroke() {
-    std::lock_guard<std::mutex> lk(m_mutex);
-    if (m_completed.empty()) return std::nullopt;
-    Stroke s = std::move(m_completed.front());
-    m_completed.erase(m_completed.begin());
+    std::optional<Completed> c = m_completed.pop();
+    if (!c) return std::nullopt;
+
+    // A stroke longer than the log keeps only its newest points.
+    const uint64_t head = m_head.load(std::memory_order_acquire);
+    const uint64_t first = std::max(c->begin, head > kPointLogSize ? head - kPointLogSize : 0);
+    Stroke s;
+    s.startTime = c->startTime;
+    s.endTime = c->endTime;
+    s.points.reserve(c->end - std::min(first, c->end));
+    s.times.reserve(s.points.capacity());
+    for (uint64_t i = first; i < c->end; ++i) {
+        s.points.push_back(pointAt(i));
+        s.times.push_back(timeAt(i));
+    }
+    s.simplified = StrokeSimplifier::simplify(s.points);
     return s;
 }
 
-std::vector<glm::vec2> StrokeRecorder::copyCurrentPoints() const {
-    std::lock_guard<std::mutex> lk(m_mutex);
-    return m_current.points;
+std::size_t StrokeRecorder::readCurrentPoints(Cursor& cursor, std::vector<glm::vec2>& out) const {
+    // Consistent (serial, begin, head): retry if a press or release lands in between.
+    uint64_t serial, begin, head;
+    do {
+        serial = m_serial.load(std::memory_order_acquire);
+        begin = m_currentBegin.load(std::memory_order_relaxed);
+        head = m_head.load(std::memory_order_acquire);
+    } while (serial != m_serial.load(std::memory_order_acquire));
+
+    if (serial != cursor.stroke) {
+        out.clear();
+        cursor.stroke = serial;
+        cursor.next = begin;
+    }
+    if (!(serial & 1)) return 0;  // idle
+
+    // Too far behind: the oldest points have been overwritten.
+    if (head - cursor.next > kPointLogSize) cursor.next = head - kPointLogSize;
+    const std::size_t added = static_cast<std::size_t>(head - cursor.next);
+    for (; cursor.next < head; ++cursor.next) out.push_back(pointAt(cursor.next));
+    return added;
 }
@@ -1,19 +1,34 @@
 #pragma once
 
+#include "spscRing.h"
+
 #include <glm/glm.hpp>
-#define GLFW_INCLUDE_NONE
-#include <GLFW/glfw3.h>
 
-#include <functional>
-#include <mutex>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <optional>
 #include <utility>
 #include <vector>
 
+struct GLFWwindow;
+
 // StrokeRecorder
 // - Milestone M1: Capture 2D points between LMB down/up.
-// - Polls GLFW each frame; records a sequence of points for the active stroke.
-// - Stores completed strokes for later consumption.
+// - Polls GLFW each frame (poll(), in glfwInput.cc), or, once attach()ed,
+//   takes every cursor event GLFW delivers (cursorMoved/buttonChanged);
+//   headless code calls feed() or the event entry points directly.
+// - Records a timestamped sequence of points for the active stroke and
+//   stores completed strokes for later consumption.
+//
+// Threading: feed()/poll() are the single producer. Points go into an
+// append-only log indexed by a running point number; readers on any
+// thread pick up only the points added since their last read
+// (readCurrentPoints). Completed strokes are queued in a lock-free SPSC
+// ring, so popCompletedStroke() has one consumer thread. No call blocks
+// another, and the producer side never allocates: the log is sized once,
+// at construction.
 //
 // Coordinates: window-normalized [0,1] with origin at top-left.
 //   x = 0 at left edge, x = 1 at right edge
@@ -24,6 +39,11 @@ public:
     struct Stroke {
         /// Normalized [0,1] window coordinates sampled during the drag.
         std::vector<glm::vec2> points;
+        /// Sample time of each point (seconds, same clock as startTime).
+        std::vector<double> times;
+        /// `points` through StrokeSimplifier: what the drawn-platform
+        /// placement (and the recognizer, without a canvas) consume.
+        std::vector<glm::vec2> simplified;
         /// Timestamp at press (glfwGetTime seconds).
         double startTime = 0.0;
         /// Timestamp at release (glfwGetTime seconds).
@@ -37,40 +57,97 @@ public:
     static StrokeRecorder* instance();
 
     /// Sample mouse state and append points if LMB is held.
-    /// Call once per frame from the main/render thread.
+    /// Call once per frame from the main/render thread (the producer).
+    /// Does nothing once attach()ed: the callbacks capture instead.
     void poll();
 
+    /// Event-driven capture (glfwInput.cc): install cursor-position and
+    /// mouse-button callbacks on `win`, so each motion event GLFW reports
+    /// becomes a sample instead of one cursor read per frame. Callbacks
+    /// run inside glfwPollEvents(), i.e. on the thread that calls poll().
+    /// `rawMotion` asks for unaccelerated motion where the platform has it;
+    /// GLFW applies that only while the cursor is disabled.
+    void attach(GLFWwindow* win, bool rawMotion = false);
+
+    /// One input sample: LMB state, cursor in normalized window coordinates
+    /// (ignored while released) and time in seconds. poll() reads these from
+    /// GLFW; headless code feeds them directly.
+    void feed(bool pressed, const glm::vec2& point, double now);
+
+    /// Event input, as the attach() callbacks deliver it: the cursor moved
+    /// to `point` (normalized window coordinates), or the left button
+    /// changed state at the last reported position. Every move with the
+    /// button held is one sample.
+    void cursorMoved(const glm::vec2& point, double now);
+    void buttonChanged(bool pressed, double now);
+
     /// True if one or more completed strokes are buffered.
     bool hasCompletedStroke() const;
 
     /// Remove and return the oldest completed stroke; std::nullopt if none.
+    /// The points are copied out of the log once, here.
     std::optional<Stroke> popCompletedStroke();
 
-    /// Current capture state (idle/drawing).
-    State state() const { return m_state; }
-    /// Points collected for the in-progress stroke (empty when idle).
-    const std::vector<glm::vec2>& currentPoints() const { return m_current.points; }
+    /// Current capture state (idle/drawing); any thread.
+    State state() const;
 
-    /// Thread-safe snapshot of the current stroke's points.
-    /// Copies the vector under a mutex so other threads can safely inspect.
-    std::vector<glm::vec2> copyCurrentPoints() const;
+    /// A reader's position in the in-progress stroke; see readCurrentPoints().
+    struct Cursor {
+        uint64_t stroke = 0;  // stroke serial `out` currently mirrors
+        uint64_t next = 0;    // first log index not read yet
+    };
+
+    /// Keep `out` equal to the in-progress stroke's points, appending only
+    /// those added since the last call with `cursor`. `out` is cleared when
+    /// a new stroke starts or the current one ends. Any thread, lock-free;
+    /// returns how many points were appended.
+    std::size_t readCurrentPoints(Cursor& cursor, std::vector<glm::vec2>& out) const;
+
+    /// Points the log holds. A reader (or a stroke) further behind than
+    /// this loses its oldest points.
+    static constexpr std::size_t kPointLogSize = std::size_t(1) << 18;
 
 private:
-    StrokeRecorder() = default;
+    StrokeRecorder();
+
+    struct Completed {
+        uint64_t begin = 0, end = 0;  // point log range
+        double startTime = 0.0, endTime = 0.0;
+    };
 
     // Helpers
     /// Convert raw cursor position (pixels) to normalized window coordinates.
     static glm::vec2 normalizeToWindow(GLFWwindow* win, double x, double y);
+    /// GLFW callbacks installed by attach().
+    static void cursorPosCallback(GLFWwindow* win, double x, double y);
+    static void mouseButtonCallback(GLFWwindow* win, int button, int action, int mods);
+    static void windowSizeCallback(GLFWwindow* win, int w, int h);
     /// Transition to Drawing and initialize a new Stroke.
     void beginStroke(double now);
     /// Append a point to the current stroke (with small de-duplication).
-    void appendPoint(const glm::vec2& p);
+    void appendPoint(const glm::vec2& p, double now);
     /// Finalize the stroke and queue it in the completed buffer.
     void endStroke(double now);
 
-    mutable std::mutex m_mutex;
-    State m_state = State::Idle;
-    Stroke m_current;
-    std::vector<Stroke> m_completed;
+    glm::vec2 pointAt(uint64_t index) const;
+    double timeAt(uint64_t index) const;
+
+    // Producer thread only.
     bool m_wasPressedLastFrame = false;
+    bool m_hasLast = false;
+    glm::vec2 m_last{0.0f};
+    uint64_t m_begin = 0;  // log index of the current stroke's first point
+    double m_startTime = 0.0;
+    bool m_attached = false;       // callbacks installed; poll() is a no-op
+    glm::vec2 m_cursor{0.0f};      // last cursorMoved() position
+    glm::vec2 m_windowSize{1.0f};  // cached for the callbacks (screen coordinates)
+
+    // Shared. Points are stored as bit-cast vec2s so a reader racing an
+    // overwrite reads stale data, never a torn float.
+    std::unique_ptr<std::atomic<uint64_t>[]> m_log;
+    std::unique_ptr<std::atomic<uint64_t>[]> m_timeLog;  // bit-cast doubles, same indices
+    std::atomic<uint64_t> m_head{0};          // points published so far
+    std::atomic<uint64_t> m_currentBegin{0};  // m_begin, for readers
+    std::atomic<uint64_t> m_serial{0};        // +1 at press and release: odd while drawing
+    SpscRing<Completed, 64> m_completed;
 };
@@ -0,0 +1,109 @@
+#include "strokeSimplifier.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr float kPi = 3.14159265358979f;
+
+// `a` folded into (-pi, pi].
+float wrapAngle(float a) {
+    while (a > kPi) a -= 2.0f * kPi;
+    while (a <= -kPi) a += 2.0f * kPi;
+    return a;
+}
+}  // namespace
+
+StrokeSimplifier::StrokeSimplifier(float tolerance) : m_tolerance(tolerance) {}
+
+void StrokeSimplifier::reset() {
+    m_points.clear();
+    m_lengths.clear();
+    m_committed = 0;
+    m_hasCone = false;
+}
+
+void StrokeSimplifier::setTail(const glm::vec2& p) {
+    if (m_points.size() == m_committed) {
+        m_points.push_back(p);
+        m_lengths.push_back(0.0f);
+    } else {
+        m_points.back() = p;
+    }
+    m_lengths.back() = m_lengths[m_committed - 1] + glm::length(p - m_points[m_committed - 1]);
+}
+
+void StrokeSimplifier::commitTail() {
+    m_committed = m_points.size();
+    m_hasCone = false;
+}
+
+void StrokeSimplifier::add(const glm::vec2& p) {
+    if (m_points.empty()) {
+        m_points.push_back(p);
+        m_lengths.push_back(0.0f);
+        m_committed = 1;
+        return;
+    }
+
+    for (;;) {
+        const glm::vec2 d = p - m_points[m_committed - 1];
+        const float dist = glm::length(d);
+        if (dist <= m_tolerance) {  // radial: within reach of the vertex whatever comes next
+            setTail(p);
+            return;
+        }
+        const float angle = std::atan2(d.y, d.x);
+        const float halfWidth = std::asin(m_tolerance / dist);
+        if (!m_hasCone) {
+            m_coneRef = angle;
+            m_coneLo = -halfWidth;
+            m_coneHi = halfWidth;
+            m_hasCone = true;
+            setTail(p);
+            return;
+        }
+        const float offset = wrapAngle(angle - m_coneRef);
+        if (offset >= m_coneLo && offset <= m_coneHi) {
+            m_coneLo = std::max(m_coneLo, offset - halfWidth);
+            m_coneHi = std::min(m_coneHi, offset + halfWidth);
+            setTail(p);
+            return;
+        }
+        // `p` leaves the sleeve: the previous point becomes a vertex and
+        // `p` is measured again from it (inside its radius or a new cone).
+        commitTail();
+    }
+}
+
+void StrokeSimplifier::add(const std::vector<glm::vec2>& points) {
+    for (const glm::vec2& p: points) add(p);
+}
+
+void StrokeSimplifier::resample(std::size_t n, std::vector<glm::vec2>& out) const {
+    out.clear();
+    if (m_points.empty() || n == 0) return;
+    out.reserve(n);
+    const float total = length();
+    std::size_t seg = 0;  // m_points[seg] -> m_points[seg + 1] holds the target
+    for (std::size_t k = 0; k < n; ++k) {
+        const float target = n > 1 ? total * static_cast<float>(k) / static_cast<float>(n - 1)
+                                   : 0.0f;
+        while (seg + 2 < m_points.size() && m_lengths[seg + 1] < target) ++seg;
+        if (seg + 1 >= m_points.size()) {
+            out.push_back(m_points[seg]);
+            continue;
+        }
+        const float span = m_lengths[seg + 1] - m_lengths[seg];
+        const float t = span > 0.0f ? std::clamp((target - m_lengths[seg]) / span, 0.0f, 1.0f)
+                                    : 0.0f;
+        out.push_back(glm::mix(m_points[seg], m_points[seg + 1], t));
+    }
+}
+
+std::vector<glm::vec2> StrokeSimplifier::simplify(const std::vector<glm::vec2>& points,
+                                                  float tolerance) {
+    StrokeSimplifier s(tolerance);
+    s.add(points);
+    return s.m_points;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <vector>
+
+// StrokeSimplifier
+// - Online polyline simplification: add() raw points as they arrive and
+//   points() is always the simplified stroke so far, ending at the newest
+//   raw point. O(1) per point, no re-walk of earlier points.
+// - Radial step: points within `tolerance` of the last kept vertex are
+//   absorbed. Beyond that, each point narrows a cone of directions from the
+//   last kept vertex that stays within `tolerance` of every point seen since
+//   (sleeve fitting); the first point outside the cone commits the previous
+//   point as a vertex. Every raw point is within about `tolerance` of the
+//   simplified polyline, so at canvas resolution the two rasterize to the
+//   same line up to Bresenham stair-stepping.
+// - resample(n) gives n points equidistant along the stroke, as the $1
+//   recognizer family expects, from arc lengths kept as vertices are added.
+//
+// Coordinates are whatever the caller feeds (StrokeRecorder's normalized
+// window coordinates in practice); `tolerance` is in the same units.
+class StrokeSimplifier {
+public:
+    /// ~2.5 px on a 1280 px window, well under a pixel of the 64x64 canvases.
+    static constexpr float kDefaultTolerance = 0.002f;
+
+    explicit StrokeSimplifier(float tolerance = kDefaultTolerance);
+
+    /// Start a new stroke (keeps the allocated capacity).
+    void reset();
+
+    /// Append the stroke's next raw point.
+    void add(const glm::vec2& p);
+
+    /// add() each of `points`.
+    void add(const std::vector<glm::vec2>& points);
+
+    /// Simplified stroke: kept vertices plus the newest raw point.
+    const std::vector<glm::vec2>& points() const { return m_points; }
+
+    /// Length of the simplified polyline.
+    float length() const { return m_lengths.empty() ? 0.0f : m_lengths.back(); }
+
+    /// Replace `out` with `n` points spaced evenly along the simplified
+    /// stroke, first and last on its endpoints. Empty stroke: `out` empty.
+    void resample(std::size_t n, std::vector<glm::vec2>& out) const;
+
+    /// The whole pass for a finished stroke.
+    static std::vector<glm::vec2> simplify(const std::vector<glm::vec2>& points,
+                                           float tolerance = kDefaultTolerance);
+
+private:
+    /// Make m_points[m_committed..] hold exactly `p` (the moving tail).
+    void setTail(const glm::vec2& p);
+    /// Keep the tail as a vertex; the next cone starts from it.
+    void commitTail();
+
+    float m_tolerance;
+    std::vector<glm::vec2> m_points;
+    std::vector<float> m_lengths;  // arc length at each of m_points
+    std::size_t m_committed = 0;   // m_points[0..m_committed) are kept vertices
+    // Directions from the last vertex, as offsets from m_coneRef (radians).
+    bool m_hasCone = false;
+    float m_coneRef = 0.0f, m_coneLo = 0.0f, m_coneHi = 0.0f;
+};
@@ -0,0 +1,389 @@
+#include "tinyCnn.h"
+
+#include "cnnKernels.h"
+#include "mappedFile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+using CnnFormat::LayerType;
+using CnnFormat::WeightType;
+
+namespace {
+uint32_t align4(std::size_t n) {
+    return static_cast<uint32_t>((n + 3) & ~std::size_t(3));
+}
+
+template <class T>
+void append(std::vector<char> &out, const T *values, std::size_t count) {
+    const char *p = reinterpret_cast<const char *>(values);
+    out.insert(out.end(), p, p + count * sizeof(T));
+    out.resize(align4(out.size()), '\0');
+}
+
+template <class T>
+std::vector<T> readArray(const unsigned char *data, uint32_t offset, uint32_t count) {
+    std::vector<T> values(count);
+    std::memcpy(values.data(), data + offset, count * sizeof(T));
+    return values;
+}
+
+bool hasWeights(LayerType type) {
+    return type == LayerType::conv2d || type == LayerType::dense;
+}
+}  // namespace
+
+TinyCnn::TinyCnn(Shape input) : m_input(input) {
+    if (input.channels <= 0 || input.height <= 0 || input.width <= 0)
+        throw std::invalid_argument("TinyCnn: input dimensions must be positive");
+    m_arena.resize(m_input.size());
+}
+
+/*──────────────────────────────   building   ────────────────────────────*/
+void TinyCnn::addConv2d(int outChannels, int kernel, int padding, std::vector<float> weights,
+                        std::vector<float> bias, int stride) {
+    Layer layer = convLayer(outChannels, kernel, padding, stride);
+    layer.weights = std::move(weights);
+    layer.bias = std::move(bias);
+    addWeighted(std::move(layer));
+}
+
+void TinyCnn::addDense(int outputs, std::vector<float> weights, std::vector<float> bias) {
+    Layer layer = denseLayer(outputs);
+    layer.weights = std::move(weights);
+    layer.bias = std::move(bias);
+    addWeighted(std::move(layer));
+}
+
+void TinyCnn::addRelu() {
+    Layer layer;
+    layer.type = LayerType::relu;
+    layer.in = layer.out = outputShape();
+    if (!m_layers.empty() && hasWeights(m_layers.back().type) && !m_layers.back().reluFused)
+        m_layers.back().reluFused = true;
+    push(std::move(layer));
+}
+
+void TinyCnn::addMaxPool(int size) {
+    const Shape in = outputShape();
+    if (size <= 0 || size > in.height || size > in.width)
+        throw std::invalid_argument("TinyCnn: bad max pool size");
+    Layer layer;
+    layer.type = LayerType::maxPool;
+    layer.kernel = size;
+    layer.in = in;
+    layer.out = {in.channels, in.height / size, in.width / size};
+    push(std::move(layer));
+}
+
+void TinyCnn::addSoftmax() {
+    Layer layer;
+    layer.type = LayerType::softmax;
+    layer.in = layer.out = outputShape();
+    push(std::move(layer));
+}
+
+void TinyCnn::setLabels(std::vector<std::string> labels) {
+    m_labels = std::move(labels);
+}
+
+TinyCnn::Layer TinyCnn::convLayer(int outChannels, int kernel, int padding, int stride) const {
+    const Shape in = outputShape();
+    if (outChannels <= 0 || kernel <= 0 || stride <= 0 || padding < 0)
+        throw std::invalid_argument("TinyCnn: bad conv2d parameters");
+    if (in.height + 2 * padding < kernel || in.width + 2 * padding < kernel)
+        throw std::invalid_argument("TinyCnn: conv2d kernel larger than its padded input");
+
+    Layer layer;
+    layer.type = LayerType::conv2d;
+    layer.in = in;
+    layer.kernel = kernel;
+    layer.stride = stride;
+    layer.padding = padding;
+    layer.out = {outChannels, (in.height + 2 * padding - kernel) / stride + 1,
+                 (in.width + 2 * padding - kernel) / stride + 1};
+    return layer;
+}
+
+TinyCnn::Layer TinyCnn::denseLayer(int outputs) const {
+    if (outputs <= 0)
+        throw std::invalid_argument("TinyCnn: dense layer needs outputs");
+    Layer layer;
+    layer.type = LayerType::dense;
+    layer.in = outputShape();
+    layer.out = {outputs, 1, 1};
+    return layer;
+}
+
+void TinyCnn::addWeighted(Layer layer) {
+    const std::size_t outputs = static_cast<std::size_t>(layer.out.channels);
+    const std::size_t weightCount =
+            layer.type == LayerType::conv2d
+                    ? outputs * layer.in.channels * layer.kernel * layer.kernel
+                    : outputs * layer.in.size();
+    const bool sized = layer.quantizedWeights.empty()
+                               ? layer.weights.size() == weightCount
+                               : layer.quantizedWeights.size() == weightCount &&
+                                         layer.scales.size() == outputs;
+    if (!sized || layer.bias.size() != outputs)
+        throw std::invalid_argument("TinyCnn: weight or bias count does not match the layer");
+    m_quantized |= !layer.quantizedWeights.empty();
+    push(std::move(layer));
+}
+
+void TinyCnn::push(Layer layer) {
+    if (m_input.size() == 0)
+        throw std::invalid_argument("TinyCnn: no input shape");
+    if (layer.type == LayerType::conv2d && !(layer.kernel == 1 && layer.stride == 1 &&
+                                             layer.padding == 0)) {
+        m_scratchSize = std::max(m_scratchSize, static_cast<std::size_t>(layer.in.channels) *
+                                                        layer.kernel * layer.kernel *
+                                                        layer.out.height * layer.out.width);
+    }
+    m_activationSize = std::max(m_activationSize, layer.out.size());
+    m_layers.push_back(std::move(layer));
+    m_arena.assign(m_input.size() + 2 * m_activationSize + m_scratchSize, 0.0f);
+}
+
+void TinyCnn::quantize() {
+    for (Layer &layer: m_layers) {
+        if (!hasWeights(layer.type) || layer.weights.empty())
+            continue;
+        const std::size_t outputs = layer.bias.size();
+        const std::size_t perOutput = layer.weights.size() / outputs;
+        layer.quantizedWeights.resize(layer.weights.size());
+        layer.scales.resize(outputs);
+        for (std::size_t o = 0; o < outputs; ++o) {
+            const float *w = layer.weights.data() + o * perOutput;
+            float peak = 0.0f;
+            for (std::size_t k = 0; k < perOutput; ++k)
+                peak = std::max(peak, std::abs(w[k]));
+            const float scale = peak > 0.0f ? peak / 127.0f : 1.0f;
+            for (std::size_t k = 0; k < perOutput; ++k) {
+                const float q = std::round(w[k] / scale);
+                layer.quantizedWeights[o * perOutput + k] =
+                        static_cast<int8_t>(std::clamp(q, -127.0f, 127.0f));
+            }
+            layer.scales[o] = scale;
+        }
+        layer.weights.clear();
+        layer.weights.shrink_to_fit();
+    }
+    m_quantized = true;
+}
+
+std::size_t TinyCnn::weightBytes() const {
+    std::size_t bytes = 0;
+    for (const Layer &layer: m_layers)
+        bytes += (layer.weights.size() + layer.scales.size() + layer.bias.size()) * sizeof(float) +
+                 layer.quantizedWeights.size();
+    return bytes;
+}
+
+/*───────────────────────────────   files   ──────────────────────────────*/
+bool TinyCnn::load(const std::string &path) {
+    MappedFile file;
+    if (!file.open(path))
+        return false;
+    CnnFormat::View view;
+    if (!CnnFormat::parse(file.data(), file.size(), view)) {
+        std::cerr << "[TinyCnn] " << path << " is not a version " << CnnFormat::kVersion
+                  << " model\n";
+        return false;
+    }
+
+    const CnnFormat::Header &h = *view.header;
+    try {
+        TinyCnn net(Shape{static_cast<int>(h.inputChannels), static_cast<int>(h.inputHeight),
+                          static_cast<int>(h.inputWidth)});
+        for (uint32_t i = 0; i < h.layerCount; ++i) {
+            const CnnFormat::LayerRecord &r = view.layers[i];
+            const int outputs = static_cast<int>(r.outputs);
+            switch (static_cast<LayerType>(r.type)) {
+            case LayerType::conv2d:
+            case LayerType::dense: {
+                Layer layer = r.type == static_cast<uint32_t>(LayerType::conv2d)
+                                      ? net.convLayer(outputs, static_cast<int>(r.kernel),
+                                                      static_cast<int>(r.padding),
+                                                      static_cast<int>(r.stride))
+                                      : net.denseLayer(outputs);
+                if (r.weightType == static_cast<uint32_t>(WeightType::i8)) {
+                    layer.quantizedWeights =
+                            readArray<int8_t>(view.data, r.weightOffset, r.weightCount);
+                    layer.scales = readArray<float>(view.data, r.scaleOffset, r.outputs);
+                } else {
+                    layer.weights = readArray<float>(view.data, r.weightOffset, r.weightCount);
+                }
+                layer.bias = readArray<float>(view.data, r.biasOffset, r.outputs);
+                net.addWeighted(std::move(layer));
+                break;
+            }
+            case LayerType::relu:
+                net.addRelu();
+                break;
+            case LayerType::maxPool:
+                net.addMaxPool(static_cast<int>(r.kernel));
+                break;
+            case LayerType::softmax:
+                net.addSoftmax();
+                break;
+            }
+        }
+        for (uint32_t i = 0; i < h.labelCount; ++i)
+            net.m_labels.emplace_back(view.label(i));
+        *this = std::move(net);
+    } catch (const std::invalid_argument &e) {
+        std::cerr << "[TinyCnn] " << path << ": " << e.what() << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool TinyCnn::save(const std::string &path) const {
+    // Records first, then every layer's arrays, then the labels.
+    CnnFormat::Header header{};
+    std::memcpy(header.magic, CnnFormat::kMagic, sizeof(header.magic));
+    header.version = CnnFormat::kVersion;
+    header.inputChannels = static_cast<uint32_t>(m_input.channels);
+    header.inputHeight = static_cast<uint32_t>(m_input.height);
+    header.inputWidth = static_cast<uint32_t>(m_input.width);
+    header.layerCount = static_cast<uint32_t>(m_layers.size());
+    header.layerOffset = sizeof(CnnFormat::Header);
+
+    const uint32_t dataOffset =
+            header.layerOffset + header.layerCount * sizeof(CnnFormat::LayerRecord);
+    std::vector<CnnFormat::LayerRecord> records;
+    std::vector<char> data;
+    for (const Layer &layer: m_layers) {
+        CnnFormat::LayerRecord r{};
+        r.type = static_cast<uint32_t>(layer.type);
+        r.outputs = static_cast<uint32_t>(layer.out.channels);
+        r.kernel = static_cast<uint32_t>(layer.kernel);
+        r.stride = static_cast<uint32_t>(layer.stride);
+        r.padding = static_cast<uint32_t>(layer.padding);
+        r.weightType = static_cast<uint32_t>(WeightType::none);
+        if (hasWeights(layer.type)) {
+            const bool q = !layer.quantizedWeights.empty();
+            r.weightType = static_cast<uint32_t>(q ? WeightType::i8 : WeightType::f32);
+            r.weightCount = static_cast<uint32_t>(q ? layer.quantizedWeights.size()
+                                                    : layer.weights.size());
+            r.weightOffset = dataOffset + static_cast<uint32_t>(data.size());
+            if (q) {
+                append(data, layer.quantizedWeights.data(), layer.quantizedWeights.size());
+                r.scaleOffset = dataOffset + static_cast<uint32_t>(data.size());
+                append(data, layer.scales.data(), layer.scales.size());
+            } else {
+                append(data, layer.weights.data(), layer.weights.size());
+            }
+            r.biasOffset = dataOffset + static_cast<uint32_t>(data.size());
+            append(data, layer.bias.data(), layer.bias.size());
+        }
+        records.push_back(r);
+    }
+
+    header.labelCount = static_cast<uint32_t>(m_labels.size());
+    header.labelOffset = dataOffset + static_cast<uint32_t>(data.size());
+    std::vector<uint32_t> labelOffsets;
+    uint32_t labelOffset = header.labelCount * sizeof(uint32_t);
+    for (const std::string &label: m_labels) {
+        labelOffsets.push_back(labelOffset);
+        labelOffset += static_cast<uint32_t>(label.size() + 1);
+    }
+    std::vector<char> table;
+    append(table, labelOffsets.data(), labelOffsets.size());
+    for (const std::string &label: m_labels)
+        table.insert(table.end(), label.c_str(), label.c_str() + label.size() + 1);
+    table.resize(align4(table.size()), '\0');
+    header.fileSize = header.labelOffset + static_cast<uint32_t>(table.size());
+
+    std::vector<char> out;
+    out.reserve(header.fileSize);
+    append(out, &header, 1);
+    append(out, records.data(), records.size());
+    out.insert(out.end(), data.begin(), data.end());
+    out.insert(out.end(), table.begin(), table.end());
+
+    std::ofstream outFile(path, std::ios::binary | std::ios::trunc);
+    if (!outFile.write(out.data(), static_cast<std::streamsize>(out.size()))) {
+        std::cerr << "[TinyCnn] Failed to write " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+/*─────────────────────────────   inference   ────────────────────────────*/
+const float *TinyCnn::forward(SimdLevel level) {
+    float *input = m_arena.data();
+    float *buffers[2] = {input + m_input.size(), input + m_input.size() + m_activationSize};
+    float *scratch = buffers[1] + m_activationSize;
+    const float *src = input;
+    int next = 0;
+
+    for (std::size_t i = 0; i < m_layers.size(); ++i) {
+        const Layer &layer = m_layers[i];
+        float *dst = buffers[next];
+        switch (layer.type) {
+        case LayerType::conv2d: {
+            const Shape &in = layer.in;
+            const float *cols = src;
+            if (!(layer.kernel == 1 && layer.stride == 1 && layer.padding == 0)) {
+                CnnKernels::im2col(src, in.channels, in.height, in.width, layer.kernel,
+                                   layer.stride, layer.padding, scratch);
+                cols = scratch;
+            }
+            const int depth = in.channels * layer.kernel * layer.kernel;
+            const int columns = layer.out.height * layer.out.width;
+            if (layer.quantizedWeights.empty()) {
+                CnnKernels::gemm(layer.weights.data(), layer.bias.data(), layer.out.channels, depth,
+                                 cols, columns, dst, layer.reluFused, level);
+            } else {
+                CnnKernels::gemm(layer.quantizedWeights.data(), layer.scales.data(),
+                                 layer.bias.data(), layer.out.channels, depth, cols, columns, dst,
+                                 layer.reluFused, level);
+            }
+            break;
+        }
+        case LayerType::dense: {
+            const int depth = static_cast<int>(layer.in.size());
+            if (layer.quantizedWeights.empty()) {
+                CnnKernels::gemv(layer.weights.data(), layer.bias.data(), layer.out.channels, depth,
+                                 src, dst, layer.reluFused, level);
+            } else {
+                CnnKernels::gemv(layer.quantizedWeights.data(), layer.scales.data(),
+                                 layer.bias.data(), layer.out.channels, depth, src, dst,
+                                 layer.reluFused, level);
+            }
+            break;
+        }
+        case LayerType::maxPool:
+            CnnKernels::maxPool(src, layer.in.channels, layer.in.height, layer.in.width,
+                                layer.kernel, dst);
+            break;
+        case LayerType::relu:
+        case LayerType::softmax:
+            if (layer.type == LayerType::relu && i > 0 && m_layers[i - 1].reluFused)
+                continue;  // already clamped by the layer before
+            // In place, except that input() is the caller's.
+            if (src != input) {
+                dst = const_cast<float *>(src);
+            } else {
+                std::memcpy(dst, src, layer.in.size() * sizeof(float));
+            }
+            if (layer.type == LayerType::relu) {
+                CnnKernels::relu(dst, layer.out.size(), level);
+            } else {
+                CnnKernels::softmax(dst, layer.out.size());
+            }
+            if (dst == src)
+                continue;
+            break;
+        }
+        src = dst;
+        next ^= 1;
+    }
+    return src;
+}
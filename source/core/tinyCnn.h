@@ -0,0 +1,126 @@
+#pragma once
+
+#include "cnnFormat.h"
+#include "simdLevel.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Forward pass of a small convolutional classifier on the CPU: conv2d,
+ * ReLU, max pool, dense and softmax layers in a straight line, which is
+ * all the stroke recognizer's nets need (docs/drawing_recognition_plan.md,
+ * M5). Weights come from a cooked .inkn file (load(), see cnnFormat.h and
+ * tools/cnn_export) or are added layer by layer.
+ *
+ *     TinyCnn net;
+ *     if (net.load("assets/models/shapes.inkn")) {
+ *         fill(net.input());                   // inputShape(), CHW floats
+ *         const float *scores = net.forward(); // outputShape().size() floats
+ *     }
+ *
+ * Adding a layer sizes one arena for the input, every activation and the
+ * convolution scratch, so forward() allocates nothing. Convolutions run as
+ * im2col + a register-blocked matrix product, dense layers as a matrix-
+ * vector product; a ReLU straight after either is folded into its store.
+ * quantize() keeps conv and dense weights as int8 with a scale per output,
+ * a quarter of the memory for a small loss of precision.
+ *
+ * One forward() at a time per TinyCnn: the arena holds its activations.
+ */
+class TinyCnn {
+public:
+    struct Shape {
+        int channels = 0, height = 0, width = 0;
+
+        std::size_t size() const {
+            return static_cast<std::size_t>(channels) * height * width;
+        }
+    };
+
+    TinyCnn() = default;  // empty until load()
+    // Throws std::invalid_argument unless every dimension is positive.
+    explicit TinyCnn(Shape input);
+
+    /*───── building ───────────────────────────────────────────────────────*/
+    // Each add* throws std::invalid_argument if the layer does not fit the
+    // previous layer's output or the weight counts are wrong. Weights are in
+    // the layouts of cnnFormat.h ([out][in][k][k] and [out][in]).
+    void addConv2d(int outChannels, int kernel, int padding, std::vector<float> weights,
+                   std::vector<float> bias, int stride = 1);
+    void addRelu();
+    void addMaxPool(int size);
+    void addDense(int outputs, std::vector<float> weights, std::vector<float> bias);
+    void addSoftmax();
+    void setLabels(std::vector<std::string> labels);
+
+    // Store conv and dense weights as int8, scale = max |w| / 127 per output.
+    void quantize();
+    bool quantized() const {
+        return m_quantized;
+    }
+
+    /*───── files ──────────────────────────────────────────────────────────*/
+    // Replace this net with the one in `path`; false (and logs, leaving the
+    // net as it was) if the file cannot be read or does not describe a
+    // chain of layers that fit together.
+    bool load(const std::string &path);
+    bool save(const std::string &path) const;
+
+    /*───── inference ──────────────────────────────────────────────────────*/
+    // Where forward() reads its input: inputShape().size() floats, CHW.
+    float *input() {
+        return m_arena.data();
+    }
+    // Runs every layer on input(); returns outputShape().size() floats (class
+    // probabilities after a softmax), valid until the next forward().
+    const float *forward(SimdLevel level = bestSimdLevel());
+
+    Shape inputShape() const {
+        return m_input;
+    }
+    Shape outputShape() const {
+        return m_layers.empty() ? m_input : m_layers.back().out;
+    }
+    std::size_t layerCount() const {
+        return m_layers.size();
+    }
+    // Class names from the file or setLabels(); may be empty.
+    const std::vector<std::string> &labels() const {
+        return m_labels;
+    }
+    std::size_t arenaBytes() const {
+        return m_arena.size() * sizeof(float);
+    }
+    std::size_t weightBytes() const;
+
+private:
+    struct Layer {
+        CnnFormat::LayerType type;
+        Shape in, out;
+        int kernel = 0, stride = 1, padding = 0;
+        std::vector<float> weights;  // float nets
+        std::vector<int8_t> quantizedWeights;
+        std::vector<float> scales;  // per output, with quantizedWeights
+        std::vector<float> bias;
+        bool reluFused = false;  // conv/dense: the next layer's ReLU runs in the store
+    };
+
+    Layer convLayer(int outChannels, int kernel, int padding, int stride) const;
+    Layer denseLayer(int outputs) const;
+    void addWeighted(Layer layer);
+    void push(Layer layer);
+
+    Shape m_input;
+    std::vector<Layer> m_layers;
+    std::vector<std::string> m_labels;
+    bool m_quantized = false;
+
+    // [input | activation A | activation B | im2col scratch]; each layer
+    // reads one activation buffer and writes the other.
+    std::vector<float> m_arena;
+    std::size_t m_activationSize = 0;
+    std::size_t m_scratchSize = 0;
+};
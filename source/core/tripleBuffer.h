@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Latest-wins hand-off of a T from one producer thread to one consumer
+ * thread, the same scheme as SnapshotBuffer (renderer/renderSnapshot.h)
+ * without the interpolation history.
+ *
+ * The producer fills writeSlot() and publish()es it; the consumer acquire()s
+ * the newest one. Each side owns a slot and the third is exchanged through
+ * one atomic, so neither side locks or waits, and publishing faster than
+ * the consumer reads just replaces the unread value. Slots are reused, so
+ * a T holding buffers keeps their capacity.
+ */
+template <class T>
+class TripleBuffer {
+public:
+    /*───── producer ───────────────────────────────────────────────────────*/
+    // Slot to fill for the next publish(); holds whatever was last in it.
+    T &writeSlot() {
+        return m_slots[m_write];
+    }
+    void publish() {
+        m_write = m_middle.exchange(m_write | kFresh, std::memory_order_acq_rel) & kIndexMask;
+    }
+
+    /*───── consumer ───────────────────────────────────────────────────────*/
+    // Take the newest published value, if one arrived since the last call.
+    bool acquire() {
+        if (!(m_middle.load(std::memory_order_relaxed) & kFresh))
+            return false;
+        m_read = m_middle.exchange(m_read, std::memory_order_acq_rel) & kIndexMask;
+        return true;
+    }
+    // The value acquire() last took; stable until the next acquire().
+    const T &readSlot() const {
+        return m_slots[m_read];
+    }
+
+private:
+    static constexpr uint8_t kIndexMask = 0x3;
+    static constexpr uint8_t kFresh = 0x4;  // middle slot holds an unread value
+
+    T m_slots[3];
+    std::atomic<uint8_t> m_middle{1};
+    uint8_t m_write = 0;  // producer only
+    uint8_t m_read = 2;   // consumer only
+};
@@ -1,9 +1,6 @@
 #include "canvasOverlay.h"
 #include "renderer/textureManager.h"
-#include "renderer/buffers.h"
-#include "renderer/shader.h"
 #include "core/strokeRecorder.h"
-#include "core/drawing.h"
 
 #include <cassert>
 #include <memory>
@@ -13,15 +10,16 @@
 using std::make_shared;
 
 namespace {
-    constexpr int kW = 64;
-    constexpr int kH = 64;
+    constexpr int kW = StrokeRaster::kSize;
+    constexpr int kH = StrokeRaster::kSize;
+    constexpr unsigned char kBackground = 16;  // dark, for contrast with the ink
 }  // namespace
 
 // Create a small quad with default scale and a position likely visible with the
 // current camera. Defer GL allocations to ensureInitialized(). Disable the
 // hitbox so this overlay never participates in collision.
 CanvasOverlay::CanvasOverlay() : GameObject(glm::vec2(0.2f, 0.2f), glm::vec3(-0.8f, 0.8f, 0.0f)) {
-    hitbox.setActive(false);
+    setHitboxActive(false);
     ensureInitialized();
 }
 
@@ -43,7 +41,6 @@ void CanvasOverlay::fillChecker(unsigned char a, int phase) {
 }
 
 void CanvasOverlay::clearCanvas(unsigned char value, unsigned char a) {
-    std::lock_guard<std::mutex> lk(m_pixelsMutex);
     if (m_pixels.size() != static_cast<size_t>(kW * kH * 4))
         m_pixels.resize(kW * kH * 4);
     for (int y = 0; y < kH; ++y) {
@@ -57,34 +54,6 @@ void CanvasOverlay::clearCanvas(unsigned char value, unsigned char a) {
     }
 }
 
-void CanvasOverlay::setPixel(int x, int y, unsigned char v, unsigned char a) {
-    Raster::ImageRgba img{m_pixels.data(), kW, kH};
-    Raster::plot(img, x, y, v, a);
-}
-
-void CanvasOverlay::drawDisc(int cx, int cy, int radius, unsigned char v, unsigned char a) {
-    Raster::ImageRgba img{m_pixels.data(), kW, kH};
-    Raster::drawDisc(img, cx, cy, radius, v, a);
-}
-
-void CanvasOverlay::drawLine(int x0, int y0, int x1, int y1, int radius, unsigned char v,
-                             unsigned char a) {
-    Raster::ImageRgba img{m_pixels.data(), kW, kH};
-    Raster::drawLine(img, x0, y0, x1, y1, radius, v, a);
-}
-
-std::pair<int, int> CanvasOverlay::toCanvas(float nx, float ny) const {
-    // Clamp to [0,1] then scale to pixel indices.
-    // StrokeRecorder provides window-normalized coords with origin top-left (y down).
-    // Textures in OpenGL sample with v=0 at bottom, so flip Y here to match display.
-    nx = std::max(0.0f, std::min(1.0f, nx));
-    ny = std::max(0.0f, std::min(1.0f, ny));
-    int x = static_cast<int>(nx * (kW - 1) + 0.5f);
-    // why only y needs to be flipped?
-    int y = static_cast<int>((1.0f - ny) * (kH - 1) + 0.5f);
-    return {x, y};
-}
-
 // Allocate the dynamic texture and build a basic textured quad (VAO/VBO/IBO + shader).
 void CanvasOverlay::ensureInitialized() {
     if (m_init)
@@ -93,71 +62,123 @@ void CanvasOverlay::ensureInitialized() {
     auto tm = TextureManager::instance();
     // Initialize to a blank canvas
     m_pixels.resize(kW * kH * 4);
-    clearCanvas(0, 255);
+    clearCanvas(kBackground, 255);
     tm->createDynamicTexture("draw_canvas", kW, kH, m_pixels.data());
 
-    // Simple textured quad (positions, normals, uvs)
-    float verts[] = {-0.5f, -0.5f, 0.0f, 0,     0,    1,    0.0f, 0.0f, -0.5f, 0.5f, 0.0f,
-                     0,     0,     1,    0.0f,  1.0f, 0.5f, 0.5f, 0.0f, 0,     0,    1,
-                     1.0f,  1.0f,  0.5f, -0.5f, 0.0f, 0,    0,    1,    1.0f,  0.0f};
-    unsigned int idx[] = {0, 1, 2, 0, 2, 3};
-
+    // Drawn as a screen-space sprite with the canvas texture
     renderObject = make_shared<SceneObject>();
     renderObject->m_mesh = make_shared<Mesh>();
-    renderObject->m_mesh->m_vertexArray =
-            make_shared<VertexArray>(make_shared<VertexBuffer>(verts, sizeof(verts)),
-                                     make_shared<IndexBuffer>(idx, sizeof(idx) / sizeof(idx[0])));
-    renderObject->m_mesh->m_shader = make_shared<Shader>("char.vs", "char.fs");
     renderObject->m_mesh->m_texture = tm->getTexture("draw_canvas");
 
     // Use GameObject's initial position/scale
-    renderObject->m_transform.m_position = position;
-    renderObject->m_transform.m_scale = glm::vec3(scale, 1.0f);
+    renderObject->m_transform.m_position = position();
+    renderObject->m_transform.m_scale = glm::vec3(scale(), 1.0f);
 
     renderObject->m_screenSpace = true;
     m_init = true;
 }
 
-// Advance animation and update the CPU buffer. GPU upload is done on the
-// render thread via uploadToGpu() to respect GL context ownership.
-void CanvasOverlay::update(float dt) {
+// Nothing to simulate; the canvas is drawn on the render thread.
+// Transform sync (in case caller changed position/scale) happens in
+// EntityManager's render-object pass.
+void CanvasOverlay::update(float) {
     ensureInitialized();
+}
 
-    // Snapshot current stroke points (normalized coords) safely
-    auto pts = StrokeRecorder::instance()->copyCurrentPoints();
-
-    // Redraw the canvas from scratch each tick: black background + white stroke
-    {
-        std::lock_guard<std::mutex> lk(m_pixelsMutex);
-        // Clear to dark background for contrast
-        Raster::ImageRgba img{m_pixels.data(), kW, kH};
-        Raster::clear(img, 16, 255);
-
-        // Draw stroke if there are points
-        const int radius = 1;  // ~2-3px thickness
-        if (!pts.empty()) {
-            auto [x0, y0] = toCanvas(pts[0].x, pts[0].y);
-            drawDisc(x0, y0, radius);
-            for (size_t i = 1; i < pts.size(); ++i) {
-                auto [x1, y1] = toCanvas(pts[i].x, pts[i].y);
-                drawLine(x0, y0, x1, y1, radius);
-                x0 = x1;
-                y0 = y1;
-            }
-        }
+void CanvasOverlay::rasterizeStroke() {
+    // Pick up only the points added since last frame (normalized coords); a
+    // fresh mirror means a new stroke (or none), so start from a blank raster.
+    const std::size_t added =
+            StrokeRecorder::instance()->readCurrentPoints(m_strokeCursor, m_strokePoints);
+    if (added == m_strokePoints.size())
+        resetStroke();
+    drawSimplified(m_strokePoints, m_strokePoints.size() - added);
+    copyDirtyRect();
+}
+
+const StrokeRaster &CanvasOverlay::finishStroke(const StrokeRecorder::Stroke &stroke) {
+    // Normally the canvas already holds a prefix of this stroke, read by the
+    // last frame. With an empty mirror no frame saw it (it was quick, or
+    // several strokes finished within one frame), so the canvas may hold
+    // another stroke: draw this one from its simplified points.
+    const bool prefix = !m_strokePoints.empty() &&
+                        m_strokePoints.size() <= stroke.points.size() &&
+                        m_drawnPoints.size() == m_raster.pointCount() &&
+                        m_strokePoints.front() == stroke.points.front();
+    if (prefix) {
+        drawSimplified(stroke.points, m_strokePoints.size());
+    } else {
+        resetStroke();
+        m_drawnPoints = stroke.simplified;
+        m_drawnVertices = m_drawnPoints.size();
+        m_raster.extend(m_drawnPoints);
     }
+    copyDirtyRect();
+    m_strokePoints.clear();  // used up: a stroke finishing next is not its continuation
+    return m_raster;
+}
+
+void CanvasOverlay::resetStroke() {
+    m_strokeSimplifier.reset();
+    m_drawnPoints.clear();
+    m_drawnVertices = 0;
+    if (m_raster.pointCount() > 0)
+        m_raster.clear();
+}
 
-    // Keep transform in sync (in case caller changed position/scale)
-    if (renderObject) {
-        renderObject->m_transform.m_position = position;
-        renderObject->m_transform.m_scale = glm::vec3(scale, 1.0f);
+void CanvasOverlay::drawSimplified(const std::vector<glm::vec2> &raw, std::size_t from) {
+    for (std::size_t i = from; i < raw.size(); ++i)
+        m_strokeSimplifier.add(raw[i]);
+    const std::vector<glm::vec2> &simplified = m_strokeSimplifier.points();
+    if (simplified.empty())
+        return;
+    // All but the last point are kept vertices; the last is the tail, which
+    // moves until the simplifier keeps it too.
+    for (; m_drawnVertices + 1 < simplified.size(); ++m_drawnVertices) {
+        if (m_drawnPoints.empty() || m_drawnPoints.back() != simplified[m_drawnVertices])
+            m_drawnPoints.push_back(simplified[m_drawnVertices]);
+    }
+    if (m_drawnPoints.empty() || m_drawnPoints.back() != simplified.back())
+        m_drawnPoints.push_back(simplified.back());
+    m_raster.extend(m_drawnPoints);
+}
+
+void CanvasOverlay::copyDirtyRect() {
+    const StrokeRaster::DirtyRect dirty = m_raster.takeDirty();
+    if (dirty.empty())
+        return;
+    const unsigned char *gray = m_raster.pixels();
+    for (int y = dirty.y0; y < dirty.y1; ++y) {
+        unsigned char *row = m_pixels.data() + static_cast<size_t>((kH - 1 - y) * kW) * 4;
+        for (int x = dirty.x0; x < dirty.x1; ++x) {
+            const unsigned char v = gray[y * kW + x] ? gray[y * kW + x] : kBackground;
+            row[x * 4 + 0] = v;
+            row[x * 4 + 1] = v;
+            row[x * 4 + 2] = v;
+            row[x * 4 + 3] = 255;
+        }
+    }
+    // Same rows in m_pixels' (flipped) order, merged into the upload rect.
+    const TextureRegion flipped{dirty.x0, kH - dirty.y1, dirty.x1 - dirty.x0, dirty.y1 - dirty.y0};
+    if (m_uploadDirty.empty()) {
+        m_uploadDirty = flipped;
+    } else {
+        const int x1 = std::max(m_uploadDirty.x + m_uploadDirty.width, flipped.x + flipped.width);
+        const int y1 = std::max(m_uploadDirty.y + m_uploadDirty.height, flipped.y + flipped.height);
+        m_uploadDirty.x = std::min(m_uploadDirty.x, flipped.x);
+        m_uploadDirty.y = std::min(m_uploadDirty.y, flipped.y);
+        m_uploadDirty.width = x1 - m_uploadDirty.x;
+        m_uploadDirty.height = y1 - m_uploadDirty.y;
     }
+    ++m_version;
 }
 
-// Upload the current CPU pixels to the GPU texture (call on render thread).
+// Upload the changed CPU pixels to the GPU texture (call on render thread);
+// the texture manager skips it when the version hasn't moved.
 void CanvasOverlay::uploadToGpu() {
-    std::lock_guard<std::mutex> lk(m_pixelsMutex);
-    TextureManager::instance()->updateDynamicTexture("draw_canvas", m_pixels.data(), false);
+    TextureManager::instance()->updateDynamicTexture("draw_canvas", m_pixels.data(), m_version,
+                                                     m_uploadDirty);
+    m_uploadDirty = TextureRegion{};
 }
 
 // No-op: Renderer submits our SceneObject; nothing to do here.
@@ -1,30 +1,54 @@
 #pragma once
 
 #include "gameObject.h"
+#include "core/strokeRaster.h"
+#include "core/strokeRecorder.h"
+#include "core/strokeSimplifier.h"
+#include "renderer/renderBackend.h"
 #include <memory>
 #include <vector>
-#include <mutex>
 
 // A tiny on-screen quad that displays a dynamic 64x64 RGBA texture.
 // Used to validate the dynamic texture pipeline (M0) and will later
 // show the live drawing canvas during stroke capture (M1–M2).
+//
+// The stroke is simplified as it grows (StrokeSimplifier, like the
+// recorder's Stroke::simplified) and kept in a persistent StrokeRaster that
+// only gains the simplified segments added since the last frame; only its
+// dirty rectangle is copied into the RGBA buffer. All pixel work happens on
+// the render thread (rasterizeStroke/finishStroke/uploadToGpu), where the
+// recognizer picks up the finished raster without drawing the stroke again.
 class CanvasOverlay : public GameObject {
 public:
     // Constructs the overlay with a small scale and a sensible default position.
     // Creates GPU resources lazily on first update via ensureInitialized().
     CanvasOverlay();
 
-    // Per-frame tick: animates a simple checker pattern and uploads it to the
-    // GPU using TextureManager::updateDynamicTexture(). Keeps the transform in sync.
-    void update(float dt) override;
+    // Fixed-step tick (update thread). The canvas itself is drawn on the
+    // render thread, see rasterizeStroke().
+    void update(float) override;
 
     // No direct GL calls here; the Renderer consumes our SceneObject.
     void draw() override;
 
+    // Render thread, once per frame before uploadToGpu(): draw the stroke
+    // points recorded since the last call (a new stroke starts a blank canvas).
+    void rasterizeStroke();
+
+    // Render thread: bring the canvas up to the whole of `stroke`, just
+    // completed, and return its raster for Recognizer::submitRaster(). Call
+    // before the next rasterizeStroke(), which clears it for the next stroke.
+    const StrokeRaster &finishStroke(const StrokeRecorder::Stroke &stroke);
+
     // Must be called on the render thread (the thread that owns the GL ctx).
-    // Uploads the current CPU pixel buffer to the GPU texture.
+    // Uploads the part of the CPU pixel buffer that changed, if any.
     void uploadToGpu();
 
+    // Render thread: the in-progress stroke's raster (blank between
+    // strokes), and a stamp that moves whenever the canvas changes.
+    const StrokeRaster &raster() const { return m_raster; }
+    uint64_t version() const { return m_version; }
+
 private:
     // Allocates the CPU pixel buffer, creates the GPU texture via
     // TextureManager::createDynamicTexture(), and builds a quad mesh+shader.
@@ -37,17 +61,33 @@ private:
     // Clear the canvas to a solid color (grayscale)
     void clearCanvas(unsigned char value = 0, unsigned char a = 255);
 
-    // Rasterize helpers
-    void setPixel(int x, int y, unsigned char v = 255, unsigned char a = 255);
-    void drawDisc(int cx, int cy, int radius, unsigned char v = 255, unsigned char a = 255);
-    void drawLine(int x0, int y0, int x1, int y1, int radius = 0, unsigned char v = 255, unsigned char a = 255);
+    // Start the canvas over for a new stroke.
+    void resetStroke();
+
+    // Simplify raw[from..] and draw what changed of the simplified stroke:
+    // vertices kept since the last call, then its moving tail.
+    void drawSimplified(const std::vector<glm::vec2> &raw, std::size_t from);
 
-    // Convert normalized [0,1] window coords (origin top-left)
-    // into integer canvas pixel coords [0..kW-1],[0..kH-1]
-    std::pair<int,int> toCanvas(float nx, float ny) const;
+    // Copy the raster's dirty rectangle into m_pixels: ink white on a dark
+    // background, rows flipped since GL samples textures bottom-up.
+    void copyDirtyRect();
 
     std::vector<unsigned char> m_pixels; // 64x64x4 RGBA CPU buffer
+    // The in-progress stroke, read incrementally from the StrokeRecorder
+    // (raw) and simplified as it grows.
+    std::vector<glm::vec2> m_strokePoints;
+    StrokeRecorder::Cursor m_strokeCursor;
+    StrokeSimplifier m_strokeSimplifier;
+    // What m_raster has drawn (grayscale, top row first): the simplified
+    // vertices, with the tail as it stood at each frame in between. Every
+    // raw point is within the simplifier's tolerance (~0.13 canvas px) of
+    // the simplified line, so those tails add nothing visible.
+    std::vector<glm::vec2> m_drawnPoints;
+    std::size_t m_drawnVertices = 0;  // simplified vertices in m_drawnPoints
+    StrokeRaster m_raster;
+    // Stamp of m_pixels' contents, and what changed since the last upload.
+    uint64_t m_version = 1;
+    TextureRegion m_uploadDirty;
     bool m_init = false;
     float m_time = 0.0f;
-    std::mutex m_pixelsMutex; // guard m_pixels across update/render threads
 };
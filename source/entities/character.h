@@ -1,20 +1,13 @@
 #pragma once
 
 #include <glm/glm.hpp>
-// Ensure GLFW does not include OpenGL headers (we use glad)
-#define GLFW_INCLUDE_NONE
 #include "gameObject.h"
-#include "renderer/renderer.h"
-#include <GLFW/glfw3.h>
 
 // drawMode_e lets us easily add new brush types later
 enum class DrawMode { none, platform, weapon, projectile };
 
 class Character : public GameObject {
 public:
-    // speed scalar for planar movement
-    float speed = 1.0f;
-
     DrawMode drawMode = DrawMode::none;
 
     // Constructor: initialize position and speed, optional mass
@@ -24,16 +17,38 @@ public:
         float massValue,
         const glm::vec2 &scale);
 
-    // Input handling
-    void handleKeyInput();
+    // Movement keys: horizontal direction (-1..1) and whether jump is held.
+    struct KeyInput {
+        float moveX = 0.0f;
+        bool jumpHeld = false;
+
+        bool operator==(const KeyInput &o) const {
+            return moveX == o.moveX && jumpHeld == o.jumpHeld;
+        }
+        bool operator!=(const KeyInput &o) const {
+            return !(*this == o);
+        }
+    };
+
+    // Input handling: poll GLFW (core/glfwInput.cc, windowed build only).
+    // readKeyInput() only reads the keyboard, so the render thread can poll
+    // it and hand the result to the update thread.
+    static KeyInput readKeyInput();
     void handleMouseInput();
 
+    // Apply movement keys to the body (update thread). Headless callers
+    // drive the character with this.
+    void applyInput(float moveX, bool jumpHeld);
+    void nextDrawMode() {
+        drawMode = static_cast<DrawMode>((int(drawMode) + 1) % 4);
+    }
+
     // Overrides
     void update(float dt) override;
     void draw() override {
         return;
     }
-    void resolveCollision(GameObject *other);
+    void onCollision(const glm::vec2 &resolution) override;
     bool hasCollision() const override {
         return true;
     }
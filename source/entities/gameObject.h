@@ -1,21 +1,66 @@
 #pragma once
 #include "hitbox.h"
+#include "core/componentStore.h"
 #include <glm/glm.hpp>
-#include <renderer/renderer.h>
+#include <renderer/scene_object.h>
 #include <renderer/textureManager.h>
 #include <string>
 
+/**
+ * Gameplay-facing façade over one body in EntityManager's ComponentStore.
+ *
+ * Position, velocity, scale, mass and hitbox live in the store's dense
+ * arrays once the object has been added; until then they are kept in a
+ * local BodyDesc so constructors can set them up. Physics (gravity,
+ * integration, hitbox sync, collision) runs as store-wide passes, so
+ * update() is only for per-object gameplay logic.
+ */
 class GameObject {
 public:
     GameObject(const glm::vec2 &s = glm::vec2(1.0f, 1.0f),
-               const glm::vec3 &p = glm::vec3(0.0f, 0.0f, 0.0f))
-        : position(p), velocity(0.0f), scale(s), hitbox(s, p) {} // build hit-box once, with real data
+               const glm::vec3 &p = glm::vec3(0.0f, 0.0f, 0.0f)) {
+        m_body.position = p;
+        m_body.scale = s;
+        m_body.hitboxSize = s;  // build hit-box once, with real data
+    }
+    virtual ~GameObject() = default;
 
-    glm::vec3 position;
-    glm::vec2 velocity;
-    glm::vec2 scale;
-    Hitbox hitbox;
-    float mass = 0.0f;  // 0 ⇒ static / not affected by gravity
+    /*───── components ────────────────────────────────────────────────────*/
+    glm::vec3 &position() {
+        return m_store ? m_store->position[dense()] : m_body.position;
+    }
+    const glm::vec3 &position() const {
+        return m_store ? m_store->position[dense()] : m_body.position;
+    }
+    glm::vec2 &velocity() {
+        return m_store ? m_store->velocity[dense()] : m_body.velocity;
+    }
+    glm::vec2 &scale() {
+        return m_store ? m_store->scale[dense()] : m_body.scale;
+    }
+    const glm::vec2 &scale() const {
+        return m_store ? m_store->scale[dense()] : m_body.scale;
+    }
+    float &mass() {  // 0 ⇒ static / not affected by gravity
+        return m_store ? m_store->mass[dense()] : m_body.mass;
+    }
+    float mass() const {
+        return m_store ? m_store->mass[dense()] : m_body.mass;
+    }
+    float &speed() {  // velocity multiplier applied when integrating
+        return m_store ? m_store->speed[dense()] : m_body.speed;
+    }
+
+    void setHitboxSize(const glm::vec2 &size) {
+        (m_store ? m_store->hitboxSize[dense()] : m_body.hitboxSize) = size;
+    }
+    void setHitboxActive(bool active) {
+        uint8_t &f = m_store ? m_store->flags[dense()] : m_body.flags;
+        f = active ? (f | BodyFlags::hitboxActive) : (f & ~BodyFlags::hitboxActive);
+    }
+    bool isHitboxActive() const {
+        return (m_store ? m_store->flags[dense()] : m_body.flags) & BodyFlags::hitboxActive;
+    }
 
     std::shared_ptr<SceneObject> renderObject = nullptr;
 
@@ -26,14 +71,51 @@ public:
     virtual bool hasCollision() const {
         return false;
     }
-    virtual void resolveCollision(GameObject *other) {
+    // Called after the collide pass pushed this object out of another one
+    // (only for objects that shouldMoveOnCollision).
+    virtual void onCollision(const glm::vec2 &) {
     }
     virtual bool shouldMoveOnCollision() const {
         return false;
     }
+    // Static bodies never move once spawned; the broadphase inserts them once
+    // instead of every tick. Must stay constant for the object's lifetime.
+    virtual bool isStatic() const {
+        return false;
+    }
 
     bool affectedByGravity() const {
-        return mass > 0.0f;
+        return mass() > 0.0f;
+    }
+
+    /*───── EntityManager plumbing ────────────────────────────────────────*/
+    // Body description including flags derived from the virtuals above.
+    BodyDesc bodyDesc() const {
+        BodyDesc desc = m_body;
+        desc.flags &= BodyFlags::hitboxActive;
+        if (hasCollision())
+            desc.flags |= BodyFlags::collides;
+        if (shouldMoveOnCollision())
+            desc.flags |= BodyFlags::movesOnCollision;
+        if (isStatic())
+            desc.flags |= BodyFlags::isStatic;
+        return desc;
     }
-    ~GameObject() = default;
+    // Switch component access over to the store.
+    void attach(ComponentStore *store, EntityHandle handle) {
+        m_store = store;
+        m_handle = handle;
+    }
+    EntityHandle handle() const {
+        return m_handle;
+    }
+
+private:
+    uint32_t dense() const {
+        return m_store->denseIndex(m_handle);
+    }
+
+    ComponentStore *m_store = nullptr;
+    EntityHandle m_handle;
+    BodyDesc m_body;  // authoritative until attach()
 };
@@ -31,18 +31,26 @@ bool Hitbox::intersects(const Hitbox &other) const {
     return isIntersecting;
 }
 
+Aabb Hitbox::bounds() const {
+    return {glm::vec2(position.x - size.x / 2, position.y - size.y / 2),
+            glm::vec2(position.x + size.x / 2, position.y + size.y / 2)};
+}
+
 glm::vec2 Hitbox::getCollisionResolution(const Hitbox &other) const {
+    return resolveOverlap(bounds(), other.bounds());
+}
 
+glm::vec2 resolveOverlap(const Aabb &self, const Aabb &other) {
     // Calculate overlap in each direction
-    float left1 = position.x - size.x / 2;
-    float right1 = position.x + size.x / 2;
-    float top1 = position.y + size.y / 2;
-    float bottom1 = position.y - size.y / 2;
+    float left1 = self.min.x;
+    float right1 = self.max.x;
+    float top1 = self.max.y;
+    float bottom1 = self.min.y;
 
-    float left2 = other.position.x - other.size.x / 2;
-    float right2 = other.position.x + other.size.x / 2;
-    float top2 = other.position.y + other.size.y / 2;
-    float bottom2 = other.position.y - other.size.y / 2;
+    float left2 = other.min.x;
+    float right2 = other.max.x;
+    float top2 = other.max.y;
+    float bottom2 = other.min.y;
 
     // Calculate penetration depths
     float overlapLeft = right1 - left2;
@@ -1,6 +1,21 @@
 #pragma once
 #include <glm/glm.hpp>
 
+// Axis-aligned bounds in world units (min = bottom-left, max = top-right)
+struct Aabb {
+    glm::vec2 min;
+    glm::vec2 max;
+};
+
+// Inclusive overlap, same convention as Hitbox::intersects
+inline bool overlaps(const Aabb &a, const Aabb &b) {
+    return !(a.min.x > b.max.x || a.max.x < b.min.x || a.max.y < b.min.y || a.min.y > b.max.y);
+}
+
+// Minimum-penetration push that moves `self` out of `other` along one axis.
+// Shared by Hitbox::getCollisionResolution and the component-store collide pass.
+glm::vec2 resolveOverlap(const Aabb &self, const Aabb &other);
+
 class Hitbox {
 public:
     Hitbox();
@@ -15,6 +30,9 @@ public:
     // Get collision resolution vector (how much to move to resolve collision)
     glm::vec2 getCollisionResolution(const Hitbox &other) const;
 
+    // World-space bounds, computed with the same arithmetic as intersects()
+    Aabb bounds() const;
+
     // Getters
     const glm::vec2 &getPosition() const {
         return position;
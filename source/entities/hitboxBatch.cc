@@ -0,0 +1,211 @@
+#include "hitboxBatch.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef INK_SIMD_SSE2
+#include <immintrin.h>
+#endif
+
+/*──────────────────────────────   AabbBatch   ───────────────────────────*/
+void AabbBatch::clear() {
+    m_minX.clear();
+    m_minY.clear();
+    m_maxX.clear();
+    m_maxY.clear();
+}
+
+void AabbBatch::reserve(std::size_t count) {
+    m_minX.reserve(count);
+    m_minY.reserve(count);
+    m_maxX.reserve(count);
+    m_maxY.reserve(count);
+}
+
+void AabbBatch::push_back(const Aabb &box) {
+    m_minX.push_back(box.min.x);
+    m_minY.push_back(box.min.y);
+    m_maxX.push_back(box.max.x);
+    m_maxY.push_back(box.max.y);
+}
+
+void AabbBatch::insert(std::size_t at, const Aabb &box) {
+    m_minX.insert(m_minX.begin() + at, box.min.x);
+    m_minY.insert(m_minY.begin() + at, box.min.y);
+    m_maxX.insert(m_maxX.begin() + at, box.max.x);
+    m_maxY.insert(m_maxY.begin() + at, box.max.y);
+}
+
+/*───────────────────────────────   kernels   ────────────────────────────*/
+namespace {
+// movemask results are at most 8 bits wide.
+std::size_t countBits(int bits) {
+    std::size_t n = 0;
+    for (; bits != 0; bits &= bits - 1)
+        ++n;
+    return n;
+}
+
+// Handles [begin, count) one box at a time; also the tail of the SIMD paths.
+std::size_t overlapScalar(const Aabb &self, const AabbBatch &boxes, std::size_t first,
+                          std::size_t begin, std::size_t count, uint64_t *mask,
+                          glm::vec2 *resolution) {
+    std::size_t hits = 0;
+    for (std::size_t i = begin; i < count; ++i) {
+        const Aabb box = boxes.at(first + i);
+        const bool hit = overlaps(self, box);
+        if (hit) {
+            mask[i / 64] |= uint64_t(1) << (i % 64);
+            ++hits;
+        }
+        if (resolution)
+            resolution[i] = hit ? resolveOverlap(self, box) : glm::vec2(0.0f);
+    }
+    return hits;
+}
+
+#ifdef INK_SIMD_SSE2
+std::size_t overlapSse2(const Aabb &self, const AabbBatch &boxes, std::size_t first,
+                        std::size_t count, uint64_t *mask, glm::vec2 *resolution) {
+    const __m128 sMinX = _mm_set1_ps(self.min.x);
+    const __m128 sMinY = _mm_set1_ps(self.min.y);
+    const __m128 sMaxX = _mm_set1_ps(self.max.x);
+    const __m128 sMaxY = _mm_set1_ps(self.max.y);
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+
+    std::size_t hits = 0;
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 bMinX = _mm_loadu_ps(boxes.minX() + first + i);
+        const __m128 bMinY = _mm_loadu_ps(boxes.minY() + first + i);
+        const __m128 bMaxX = _mm_loadu_ps(boxes.maxX() + first + i);
+        const __m128 bMaxY = _mm_loadu_ps(boxes.maxY() + first + i);
+
+        // Negated compares keep overlaps()'s !(a > b) semantics, NaNs included.
+        const __m128 hit = _mm_and_ps(
+                _mm_and_ps(_mm_cmpngt_ps(sMinX, bMaxX), _mm_cmpnlt_ps(sMaxX, bMinX)),
+                _mm_and_ps(_mm_cmpnlt_ps(sMaxY, bMinY), _mm_cmpngt_ps(sMinY, bMaxY)));
+        const int bits = _mm_movemask_ps(hit);
+        mask[i / 64] |= uint64_t(bits) << (i % 64);
+        hits += countBits(bits);
+
+        if (!resolution)
+            continue;
+        if (bits == 0) {
+            std::memset(resolution + i, 0, 4 * sizeof(glm::vec2));
+            continue;
+        }
+        // Same subtractions and tie order (left, right, top, bottom) as resolveOverlap.
+        const __m128 oLeft = _mm_sub_ps(sMaxX, bMinX);
+        const __m128 oRight = _mm_sub_ps(bMaxX, sMinX);
+        const __m128 oTop = _mm_sub_ps(bMaxY, sMinY);
+        const __m128 oBottom = _mm_sub_ps(sMaxY, bMinY);
+        const __m128 m = _mm_min_ps(_mm_min_ps(oLeft, oRight), _mm_min_ps(oTop, oBottom));
+
+        const __m128 isLeft = _mm_cmpeq_ps(m, oLeft);
+        const __m128 isRight = _mm_andnot_ps(isLeft, _mm_cmpeq_ps(m, oRight));
+        const __m128 taken = _mm_or_ps(isLeft, isRight);
+        const __m128 isTop = _mm_andnot_ps(taken, _mm_cmpeq_ps(m, oTop));
+        const __m128 isBottom = _mm_andnot_ps(_mm_or_ps(taken, isTop), hit);
+
+        __m128 x = _mm_or_ps(_mm_and_ps(isLeft, _mm_xor_ps(oLeft, signBit)),
+                             _mm_and_ps(isRight, oRight));
+        __m128 y = _mm_or_ps(_mm_and_ps(isTop, oTop),
+                             _mm_and_ps(isBottom, _mm_xor_ps(oBottom, signBit)));
+        x = _mm_and_ps(x, hit);
+        y = _mm_and_ps(y, hit);
+
+        float *out = &resolution[i].x;
+        _mm_storeu_ps(out, _mm_unpacklo_ps(x, y));
+        _mm_storeu_ps(out + 4, _mm_unpackhi_ps(x, y));
+    }
+    return hits + overlapScalar(self, boxes, first, i, count, mask, resolution);
+}
+#endif
+
+#ifdef INK_SIMD_AVX2
+INK_TARGET_AVX2
+std::size_t overlapAvx2(const Aabb &self, const AabbBatch &boxes, std::size_t first,
+                        std::size_t count, uint64_t *mask, glm::vec2 *resolution) {
+    const __m256 sMinX = _mm256_set1_ps(self.min.x);
+    const __m256 sMinY = _mm256_set1_ps(self.min.y);
+    const __m256 sMaxX = _mm256_set1_ps(self.max.x);
+    const __m256 sMaxY = _mm256_set1_ps(self.max.y);
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+
+    std::size_t hits = 0;
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 bMinX = _mm256_loadu_ps(boxes.minX() + first + i);
+        const __m256 bMinY = _mm256_loadu_ps(boxes.minY() + first + i);
+        const __m256 bMaxX = _mm256_loadu_ps(boxes.maxX() + first + i);
+        const __m256 bMaxY = _mm256_loadu_ps(boxes.maxY() + first + i);
+
+        const __m256 hit = _mm256_and_ps(
+                _mm256_and_ps(_mm256_cmp_ps(sMinX, bMaxX, _CMP_NGT_UQ),
+                              _mm256_cmp_ps(sMaxX, bMinX, _CMP_NLT_UQ)),
+                _mm256_and_ps(_mm256_cmp_ps(sMaxY, bMinY, _CMP_NLT_UQ),
+                              _mm256_cmp_ps(sMinY, bMaxY, _CMP_NGT_UQ)));
+        const int bits = _mm256_movemask_ps(hit);
+        mask[i / 64] |= uint64_t(bits) << (i % 64);
+        hits += countBits(bits);
+
+        if (!resolution)
+            continue;
+        if (bits == 0) {
+            std::memset(resolution + i, 0, 8 * sizeof(glm::vec2));
+            continue;
+        }
+        const __m256 oLeft = _mm256_sub_ps(sMaxX, bMinX);
+        const __m256 oRight = _mm256_sub_ps(bMaxX, sMinX);
+        const __m256 oTop = _mm256_sub_ps(bMaxY, sMinY);
+        const __m256 oBottom = _mm256_sub_ps(sMaxY, bMinY);
+        const __m256 m =
+                _mm256_min_ps(_mm256_min_ps(oLeft, oRight), _mm256_min_ps(oTop, oBottom));
+
+        const __m256 isLeft = _mm256_cmp_ps(m, oLeft, _CMP_EQ_OQ);
+        const __m256 isRight = _mm256_andnot_ps(isLeft, _mm256_cmp_ps(m, oRight, _CMP_EQ_OQ));
+        const __m256 taken = _mm256_or_ps(isLeft, isRight);
+        const __m256 isTop = _mm256_andnot_ps(taken, _mm256_cmp_ps(m, oTop, _CMP_EQ_OQ));
+        const __m256 isBottom = _mm256_andnot_ps(_mm256_or_ps(taken, isTop), hit);
+
+        __m256 x = _mm256_or_ps(_mm256_and_ps(isLeft, _mm256_xor_ps(oLeft, signBit)),
+                                _mm256_and_ps(isRight, oRight));
+        __m256 y = _mm256_or_ps(_mm256_and_ps(isTop, oTop),
+                                _mm256_and_ps(isBottom, _mm256_xor_ps(oBottom, signBit)));
+        x = _mm256_and_ps(x, hit);
+        y = _mm256_and_ps(y, hit);
+
+        // unpack works per 128-bit lane; permute restores box order.
+        const __m256 lo = _mm256_unpacklo_ps(x, y);
+        const __m256 hi = _mm256_unpackhi_ps(x, y);
+        float *out = &resolution[i].x;
+        _mm256_storeu_ps(out, _mm256_permute2f128_ps(lo, hi, 0x20));
+        _mm256_storeu_ps(out + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+    }
+    return hits + overlapScalar(self, boxes, first, i, count, mask, resolution);
+}
+#endif
+}  // namespace
+
+std::size_t overlapBatch(const Aabb &self,
+                         const AabbBatch &boxes,
+                         std::size_t first,
+                         std::size_t count,
+                         uint64_t *mask,
+                         glm::vec2 *resolution,
+                         SimdLevel level) {
+    std::fill(mask, mask + overlapMaskWords(count), uint64_t(0));
+    switch (level) {
+#ifdef INK_SIMD_AVX2
+    case SimdLevel::avx2:
+        return overlapAvx2(self, boxes, first, count, mask, resolution);
+#endif
+#ifdef INK_SIMD_SSE2
+    case SimdLevel::sse2:
+        return overlapSse2(self, boxes, first, count, mask, resolution);
+#endif
+    default:
+        return overlapScalar(self, boxes, first, 0, count, mask, resolution);
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include "hitbox.h"
+#include "core/simdLevel.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Packed AABBs in min/max structure-of-arrays layout, so one box can be
+// tested against many with SIMD loads instead of per-Hitbox math.
+class AabbBatch {
+public:
+    void clear();
+    void reserve(std::size_t count);
+    void push_back(const Aabb &box);
+    void insert(std::size_t at, const Aabb &box);
+
+    std::size_t size() const {
+        return m_minX.size();
+    }
+    Aabb at(std::size_t i) const {
+        return {glm::vec2(m_minX[i], m_minY[i]), glm::vec2(m_maxX[i], m_maxY[i])};
+    }
+
+    const float *minX() const {
+        return m_minX.data();
+    }
+    const float *minY() const {
+        return m_minY.data();
+    }
+    const float *maxX() const {
+        return m_maxX.data();
+    }
+    const float *maxY() const {
+        return m_maxY.data();
+    }
+
+private:
+    std::vector<float> m_minX, m_minY, m_maxX, m_maxY;
+};
+
+// Number of 64-bit mask words needed for `count` boxes.
+inline std::size_t overlapMaskWords(std::size_t count) {
+    return (count + 63) / 64;
+}
+
+// Index of the lowest set bit of a non-zero mask word.
+inline unsigned lowestBit(uint64_t bits) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(bits));
+#endif
+}
+
+// Test `self` against boxes[first, first + count) in one pass.
+// - mask: bit i (word i / 64) is set when boxes[first + i] overlaps `self`
+//   (same inclusive rule as Hitbox::intersects). Needs overlapMaskWords(count).
+// - resolution (optional, `count` entries): resolveOverlap(self, box) for
+//   overlapping boxes, (0, 0) otherwise.
+// All levels produce bit-identical output to the scalar Hitbox path.
+// Returns the number of overlapping boxes.
+std::size_t overlapBatch(const Aabb &self,
+                         const AabbBatch &boxes,
+                         std::size_t first,
+                         std::size_t count,
+                         uint64_t *mask,
+                         glm::vec2 *resolution = nullptr,
+                         SimdLevel level = bestSimdLevel());
@@ -1,16 +1,8 @@
 #include "platform.h"
-#include "renderer/buffers.h"
-#include "renderer/shader.h"
-#include <GLFW/glfw3.h>
-#include <glad/glad.h>
+#include <cassert>
 #include <glm/gtc/matrix_transform.hpp>
 #include <iostream>
 
-// Quad vertex data: positions only (we stride through 8 floats, but only read
-// 3) In case we want to do more complex shaders later, probably can be
-// simplified
-static unsigned int s_idx[] = {0, 1, 2, 0, 2, 3};
-
 Platform::Platform(PlatformType type,
                    std::shared_ptr<Texture> texture,
                    const glm::vec3 &startPos,
@@ -18,49 +10,26 @@ Platform::Platform(PlatformType type,
                    const glm::vec2 &scale,
                    bool isDrawn)
     : GameObject(scale, startPos), type(type), isDrawn(isDrawn) {
-    this->scale = scale;
-    position = startPos;
-    mass = 0.f;
-
     std::cout << "[platform] Created:\n";
     std::cout << "  Type: " << static_cast<int>(type) << "\n";
-    std::cout << "  Position: (" << position.x << ", " << position.y << ", " << position.z << ")\n";
+    std::cout << "  Position: (" << startPos.x << ", " << startPos.y << ", " << startPos.z << ")\n";
     std::cout << "  Scale: (" << scale.x << ", " << scale.y << ")\n";
-    std::cout << "  Mass: " << mass << "\n";
+    std::cout << "  Mass: " << mass() << "\n";
 
+    // Drawn as a sprite (shared quad, batched by texture); UVs tile with size.
     renderObject = std::make_shared<SceneObject>();
     renderObject->m_mesh = std::make_shared<Mesh>();
     assert(texture && "Texture pointer is null!");
-    assert(renderObject && "renderObject is null!");
-    assert(renderObject->m_mesh && "renderObject->m_mesh is null!");
     renderObject->m_mesh->m_texture = texture;
+    renderObject->m_uvRect = glm::vec4(0.0f, 0.0f, scale.x, scale.y);
 
-    float repeatX = scale.x;
-    float repeatY = scale.y;
-    float verts[] = {
-        -0.5f, -0.5f, 0.0f, 0, 0, 1, 0.0f, 0.0f,
-        -0.5f,  0.5f, 0.0f, 0, 0, 1, 0.0f, repeatY,
-         0.5f,  0.5f, 0.0f, 0, 0, 1, repeatX, repeatY,
-         0.5f, -0.5f, 0.0f, 0, 0, 1, repeatX, 0.0f
-    };
-
-    static unsigned int s_idx[] = {0, 1, 2, 0, 2, 3};
-
-    renderObject->m_mesh->m_vertexArray = std::make_shared<VertexArray>(
-        std::make_shared<VertexBuffer>(verts, sizeof(verts)),
-        std::make_shared<IndexBuffer>(s_idx, sizeof(s_idx) / sizeof(s_idx[0])));
-    renderObject->m_mesh->m_shader = std::make_shared<Shader>("platform.vs", "platform.fs");
-
-    renderObject->m_transform.m_position = position;
+    renderObject->m_transform.m_position = startPos;
     renderObject->m_transform.m_scale = glm::vec3(scale, 1.0f);
 }
 
 void Platform::update(float dt) {
-    // Update hitbox position to match platform position
-    hitbox.updatePosition(glm::vec3(position));
-
-    renderObject->m_transform.m_position = position;
-    renderObject->m_transform.m_scale = glm::vec3(scale, 1.0);
+    // Hitbox and render transform follow the body via EntityManager passes;
+    // stationary platforms are in the static partition and never get here.
 }
 
 void Platform::draw() {
@@ -1,6 +1,5 @@
 #pragma once
 #include "gameObject.h"
-#include "renderer/renderer.h"
 #include "renderer/textureManager.h"
 #include <glm/glm.hpp>
 
@@ -24,4 +23,7 @@ public:
         // Only stationary and moving platforms have collision
         return type == PlatformType::stationary || type == PlatformType::moving;
     }
+    bool isStatic() const override {
+        return type == PlatformType::stationary || type == PlatformType::drawn;
+    }
 };
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include "glRenderBackend.h"
+
+#include <cstring>
+#include <glad/glad.h>
+#include <iostream>
+#include <stb_image.h>
+
+namespace {
+// Owns the GL name; deleting the Texture deletes the GL texture (unless
+// the name is borrowed from a placeholder).
+std::shared_ptr<Texture> makeGlTexture() {
+    return std::shared_ptr<Texture>(new Texture(), [](Texture *texture) {
+        if (texture->m_rendererID && !texture->m_pending) {
+            glDeleteTextures(1, &texture->m_rendererID);
+        }
+        delete texture;
+    });
+}
+
+// Mipmapped, repeating storage for a file texture; `pixels` is a client
+// pointer, or an offset into the bound pixel unpack buffer.
+void uploadFileTexture(Texture &texture, int width, int height, const void *pixels) {
+    glGenTextures(1, &texture.m_rendererID);
+    glBindTexture(GL_TEXTURE_2D, texture.m_rendererID);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    texture.m_width = width;
+    texture.m_height = height;
+    texture.m_hasMipmaps = true;
+
+    // Reasonable defaults for file textures
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+}
+}  // namespace
+
+GlRenderBackend::GlRenderBackend(bool pixelBufferUploads)
+    : m_pixelBufferUploads(pixelBufferUploads) {
+}
+
+GlRenderBackend::~GlRenderBackend() {
+    if (m_pixelBuffer) {
+        glDeleteBuffers(1, &m_pixelBuffer);
+    }
+    if (m_updateBuffers[0]) {
+        glDeleteBuffers(2, m_updateBuffers);
+    }
+}
+
+std::shared_ptr<Texture> GlRenderBackend::loadTexture(const std::string &path) {
+    stbi_set_flip_vertically_on_load(true);
+    int width = 0, height = 0, channels = 0;
+    unsigned char *data = stbi_load(path.c_str(), &width, &height, &channels, 4);
+    if (!data) {
+        std::cerr << "Failed to load texture: " << path << '\n';
+        return nullptr;
+    }
+
+    auto texture = makeGlTexture();
+    texture->m_channels = channels;
+    uploadFileTexture(*texture, width, height, data);
+
+    stbi_image_free(data);
+    return texture;
+}
+
+std::shared_ptr<Texture> GlRenderBackend::createDynamicTexture(int width,
+                                                               int height,
+                                                               const unsigned char *rgba) {
+    auto texture = makeGlTexture();
+    texture->m_width = width;
+    texture->m_height = height;
+    texture->m_channels = 4;
+
+    glGenTextures(1, &texture->m_rendererID);
+    glBindTexture(GL_TEXTURE_2D, texture->m_rendererID);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+
+    // Defaults for HUD/overlay textures: clamp, linear, no mipmaps
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    return texture->m_rendererID ? texture : nullptr;
+}
+
+std::size_t GlRenderBackend::updateTexture(Texture &texture, const unsigned char *rgba,
+                                           const TextureRegion &region, bool regenerateMipmaps) {
+    if (!texture.m_rendererID || region.empty())
+        return 0;
+    const std::size_t rowBytes = static_cast<std::size_t>(region.width) * 4;
+    const std::size_t bytes = rowBytes * region.height;
+    const unsigned char *first =
+            rgba + (static_cast<std::size_t>(region.y) * texture.m_width + region.x) * 4;
+    glBindTexture(GL_TEXTURE_2D, texture.m_rendererID);
+
+    void *staging = nullptr;
+    if (m_pixelBufferUploads) {
+        if (!m_updateBuffers[0]) {
+            glGenBuffers(2, m_updateBuffers);
+        }
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_updateBuffers[m_nextUpdateBuffer]);
+        m_nextUpdateBuffer ^= 1;
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr,
+                     GL_STREAM_DRAW);
+        staging = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(bytes),
+                                   GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    }
+    if (staging) {
+        // Packed tightly: the buffer holds just the region's rows.
+        auto *dst = static_cast<unsigned char *>(staging);
+        for (int row = 0; row < region.height; ++row) {
+            std::memcpy(dst + row * rowBytes, first + row * texture.m_width * 4, rowBytes);
+        }
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, region.x, region.y, region.width, region.height,
+                        GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    }
+    if (m_pixelBufferUploads) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+    if (!staging) {
+        // Straight from the caller's image, striding over the rest of each row.
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, texture.m_width);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, region.x, region.y, region.width, region.height,
+                        GL_RGBA, GL_UNSIGNED_BYTE, first);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    }
+    if (regenerateMipmaps) {
+        glGenerateMipmap(GL_TEXTURE_2D);
+        texture.m_hasMipmaps = true;
+    }
+    return bytes;
+}
+
+std::shared_ptr<Texture> GlRenderBackend::createTexture(int width, int height,
+                                                        const unsigned char *rgba) {
+    auto texture = makeGlTexture();
+    uploadFileTexture(*texture, width, height, rgba);
+    return texture->m_rendererID ? texture : nullptr;
+}
+
+int GlRenderBackend::maxTextureSize() const {
+    GLint size = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &size);
+    return size;
+}
+
+std::shared_ptr<Texture> GlRenderBackend::createPendingTexture(const Texture &placeholder) {
+    auto texture = makeGlTexture();
+    *texture = placeholder;
+    texture->m_pending = true;
+    return texture;
+}
+
+std::size_t GlRenderBackend::finishTexture(Texture &texture, int width, int height,
+                                           const unsigned char *rgba) {
+    const std::size_t bytes = static_cast<std::size_t>(width) * height * 4;
+    texture.m_rendererID = 0;  // the placeholder keeps its name
+    texture.m_channels = 4;
+    texture.m_pending = false;
+    if (!m_pixelBufferUploads) {
+        uploadFileTexture(texture, width, height, rgba);
+        return bytes;
+    }
+
+    if (!m_pixelBuffer) {
+        glGenBuffers(1, &m_pixelBuffer);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pixelBuffer);
+    // Orphan last upload's storage so mapping never waits for its copy.
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_DRAW);
+    void *staging = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(bytes),
+                                     GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (staging) {
+        std::memcpy(staging, rgba, bytes);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        uploadFileTexture(texture, width, height, nullptr);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    if (!staging) {
+        uploadFileTexture(texture, width, height, rgba);
+    }
+    return bytes;
+}
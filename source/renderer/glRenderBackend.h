@@ -0,0 +1,43 @@
+#ifndef INK_GLRENDERBACKEND_H
+#define INK_GLRENDERBACKEND_H
+
+#include "renderBackend.h"
+
+#include <cstdint>
+
+// OpenGL textures. Needs a current GL context for every call, and the
+// textures it returns must be released on that context's thread.
+//
+// With `pixelBufferUploads`, finishTexture() stages pixels in a pixel
+// unpack buffer so the driver can copy them to the GPU asynchronously
+// instead of inside glTexImage2D. updateTexture() alternates between two
+// such buffers, so filling one never waits on the copy out of the other.
+class GlRenderBackend : public RenderBackend {
+public:
+    explicit GlRenderBackend(bool pixelBufferUploads = false);
+    ~GlRenderBackend() override;
+
+    GlRenderBackend(const GlRenderBackend &) = delete;
+    GlRenderBackend &operator=(const GlRenderBackend &) = delete;
+
+    std::shared_ptr<Texture> loadTexture(const std::string &path) override;
+    std::shared_ptr<Texture> createDynamicTexture(int width,
+                                                  int height,
+                                                  const unsigned char *rgba) override;
+    std::size_t updateTexture(Texture &texture, const unsigned char *rgba,
+                              const TextureRegion &region, bool regenerateMipmaps) override;
+    std::shared_ptr<Texture> createTexture(int width, int height,
+                                           const unsigned char *rgba) override;
+    int maxTextureSize() const override;
+    std::shared_ptr<Texture> createPendingTexture(const Texture &placeholder) override;
+    std::size_t finishTexture(Texture &texture, int width, int height,
+                              const unsigned char *rgba) override;
+
+private:
+    bool m_pixelBufferUploads;
+    uint32_t m_pixelBuffer = 0;  // created on first use
+    uint32_t m_updateBuffers[2] = {0, 0};  // updateTexture()'s pair, likewise
+    int m_nextUpdateBuffer = 0;
+};
+
+#endif  // INK_GLRENDERBACKEND_H
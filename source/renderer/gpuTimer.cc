@@ -0,0 +1,51 @@
+#include "gpuTimer.h"
+#include "core/profiler.h"
+
+#if INK_PROFILE
+
+#include <glad/glad.h>
+
+GpuTimer::GpuTimer(const char *name) : m_name(name) {
+    glGenQueries(kQueries, m_queries);
+}
+
+GpuTimer::~GpuTimer() {
+    glDeleteQueries(kQueries, m_queries);
+}
+
+void GpuTimer::collect() {
+    for (int i = 0; i < kQueries; ++i) {
+        if (!m_pending[i])
+            continue;
+        GLint available = 0;
+        glGetQueryObjectiv(m_queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            continue;
+        GLuint64 ns = 0;
+        glGetQueryObjectui64v(m_queries[i], GL_QUERY_RESULT, &ns);
+        Profiler::instance().addGpuSample(m_name, m_cpuStart[i], ns);
+        m_pending[i] = false;
+    }
+}
+
+void GpuTimer::begin() {
+    collect();
+    if (m_pending[m_next]) {
+        m_current = -1;  // all queries in flight; skip this frame rather than wait
+        return;
+    }
+    m_current = m_next;
+    m_next = (m_next + 1) % kQueries;
+    m_cpuStart[m_current] = Profiler::now();
+    glBeginQuery(GL_TIME_ELAPSED, m_queries[m_current]);
+}
+
+void GpuTimer::end() {
+    if (m_current < 0)
+        return;
+    glEndQuery(GL_TIME_ELAPSED);
+    m_pending[m_current] = true;
+    m_current = -1;
+}
+
+#endif  // INK_PROFILE
@@ -0,0 +1,41 @@
+#ifndef INK_GPUTIMER_H
+#define INK_GPUTIMER_H
+
+#include <cstdint>
+
+/**
+ * GL_TIME_ELAPSED query around a span of GL commands, reported to the
+ * Profiler as a GPU zone.
+ *
+ * Results arrive a few frames late. The timer cycles through kQueries
+ * query objects and only reads those whose result is already available,
+ * so it never stalls the pipeline. When every query is still in flight,
+ * that frame goes untimed.
+ *
+ * Needs a current GL context; use it from the render thread only.
+ */
+class GpuTimer {
+public:
+    static constexpr int kQueries = 4;
+
+    explicit GpuTimer(const char *name);  // name must outlive the timer (a literal)
+    ~GpuTimer();
+
+    GpuTimer(const GpuTimer &) = delete;
+    GpuTimer &operator=(const GpuTimer &) = delete;
+
+    void begin();
+    void end();
+
+private:
+    void collect();
+
+    const char *m_name;
+    uint32_t m_queries[kQueries] = {};
+    uint64_t m_cpuStart[kQueries] = {};  // Profiler::now() at begin(), for the trace
+    bool m_pending[kQueries] = {};
+    int m_current = -1;  // query between begin() and end()
+    int m_next = 0;
+};
+
+#endif  // INK_GPUTIMER_H
@@ -0,0 +1,56 @@
+#include "renderBackend.h"
+
+#include <stb_image.h>
+
+std::shared_ptr<Texture> NullRenderBackend::loadTexture(const std::string &path) {
+    auto texture = std::make_shared<Texture>();
+    int channels = 0;
+    if (!stbi_info(path.c_str(), &texture->m_width, &texture->m_height, &channels))
+        return nullptr;
+    texture->m_hasMipmaps = true;  // as the GL backend would
+    return texture;
+}
+
+std::shared_ptr<Texture> NullRenderBackend::createDynamicTexture(int width,
+                                                                 int height,
+                                                                 const unsigned char *) {
+    auto texture = std::make_shared<Texture>();
+    texture->m_width = width;
+    texture->m_height = height;
+    return texture;
+}
+
+std::size_t NullRenderBackend::updateTexture(Texture &texture, const unsigned char *,
+                                             const TextureRegion &region, bool regenerateMipmaps) {
+    texture.m_hasMipmaps = texture.m_hasMipmaps || regenerateMipmaps;
+    return static_cast<std::size_t>(region.width) * region.height * 4;
+}
+
+std::shared_ptr<Texture> NullRenderBackend::createTexture(int width, int height,
+                                                          const unsigned char *) {
+    auto texture = std::make_shared<Texture>();
+    texture->m_width = width;
+    texture->m_height = height;
+    texture->m_hasMipmaps = true;
+    return texture;
+}
+
+int NullRenderBackend::maxTextureSize() const {
+    return 16384;
+}
+
+std::shared_ptr<Texture> NullRenderBackend::createPendingTexture(const Texture &placeholder) {
+    auto texture = std::make_shared<Texture>(placeholder);
+    texture->m_pending = true;
+    return texture;
+}
+
+std::size_t NullRenderBackend::finishTexture(Texture &texture, int width, int height,
+                                             const unsigned char *) {
+    texture.m_width = width;
+    texture.m_height = height;
+    texture.m_channels = 4;
+    texture.m_hasMipmaps = true;
+    texture.m_pending = false;
+    return static_cast<std::size_t>(width) * height * 4;
+}
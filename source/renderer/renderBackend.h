@@ -0,0 +1,79 @@
+#ifndef INK_RENDERBACKEND_H
+#define INK_RENDERBACKEND_H
+
+#include "texture.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+/// A rectangle of texels, rows counted from the bottom like GL's.
+struct TextureRegion {
+    int x = 0, y = 0, width = 0, height = 0;
+    bool empty() const { return width <= 0 || height <= 0; }
+};
+
+/**
+ * Where render resources come from. Gameplay code (entities, the level
+ * loader, TextureManager) only creates textures through this interface, so
+ * the simulation builds and runs without a window or GL context:
+ *  - GlRenderBackend (glRenderBackend.h) is the real one, used by Ink.
+ *  - NullRenderBackend keeps sizes but owns no GPU memory; InkSim
+ *    tools, benchmarks and CI use it.
+ *
+ * Textures come back as shared_ptrs whose deleter releases the GPU side,
+ * so callers never free them through the backend.
+ */
+class RenderBackend {
+public:
+    virtual ~RenderBackend() = default;
+
+    /// Load an image file as an RGBA texture; nullptr if it can't be read.
+    virtual std::shared_ptr<Texture> loadTexture(const std::string &path) = 0;
+
+    /// RGBA texture meant for frequent CPU updates; `rgba` may be null.
+    virtual std::shared_ptr<Texture> createDynamicTexture(int width,
+                                                          int height,
+                                                          const unsigned char *rgba) = 0;
+
+    /// Copy `region` of `rgba` (the whole image, width * height * 4 bytes)
+    /// into the same texels of `texture`. Returns the bytes uploaded.
+    virtual std::size_t updateTexture(Texture &texture, const unsigned char *rgba,
+                                      const TextureRegion &region, bool regenerateMipmaps) = 0;
+
+    /// RGBA texture from `rgba` (width * height * 4 bytes, rows bottom-up),
+    /// set up as loadTexture() would; nullptr on failure.
+    virtual std::shared_ptr<Texture> createTexture(int width, int height,
+                                                   const unsigned char *rgba) = 0;
+
+    /// Largest width or height createTexture() accepts.
+    virtual int maxTextureSize() const = 0;
+
+    /// Texture that draws as `placeholder` until finishTexture(); see
+    /// TextureLoader. `placeholder` must outlive its pending state.
+    virtual std::shared_ptr<Texture> createPendingTexture(const Texture &placeholder) = 0;
+
+    /// Give a pending texture its own RGBA image (width * height * 4 bytes),
+    /// set up as loadTexture() would. Returns the bytes uploaded.
+    virtual std::size_t finishTexture(Texture &texture, int width, int height,
+                                      const unsigned char *rgba) = 0;
+};
+
+// Headless backend: reads only image headers, uploads nothing.
+class NullRenderBackend : public RenderBackend {
+public:
+    std::shared_ptr<Texture> loadTexture(const std::string &path) override;
+    std::shared_ptr<Texture> createDynamicTexture(int width,
+                                                  int height,
+                                                  const unsigned char *rgba) override;
+    std::size_t updateTexture(Texture &texture, const unsigned char *rgba,
+                              const TextureRegion &region, bool regenerateMipmaps) override;
+    std::shared_ptr<Texture> createTexture(int width, int height,
+                                           const unsigned char *rgba) override;
+    int maxTextureSize() const override;
+    std::shared_ptr<Texture> createPendingTexture(const Texture &placeholder) override;
+    std::size_t finishTexture(Texture &texture, int width, int height,
+                              const unsigned char *rgba) override;
+};
+
+#endif  // INK_RENDERBACKEND_H
@@ -0,0 +1,37 @@
+#include "renderSnapshot.h"
+
+#include <utility>
+
+void SnapshotBuffer::publish() {
+    // Hand our slot over as the fresh middle and continue in whatever was there.
+    m_write = m_middle.exchange(m_write | kFresh, std::memory_order_acq_rel) & kIndexMask;
+}
+
+bool SnapshotBuffer::acquire() {
+    if (!(m_middle.load(std::memory_order_relaxed) & kFresh))
+        return false;
+
+    // Keep the outgoing latest as previous. Swapping (not copying) leaves the
+    // slot with old data, which is fine: the writer rebuilds every slot it gets.
+    if (m_hasLatest)
+        std::swap(m_previous, m_slots[m_read]);
+    m_hasPrevious = m_hasLatest;
+
+    m_read = m_middle.exchange(m_read, std::memory_order_acq_rel) & kIndexMask;
+    m_hasLatest = true;
+    return true;
+}
+
+RenderItem interpolate(const RenderItem &item, const RenderSnapshot *prev, std::size_t index,
+                       float alpha) {
+    // Items are in spawn order, so the same entity is almost always at the
+    // same index; anything else (just spawned) is drawn where it is.
+    if (!prev || index >= prev->items.size() || prev->items[index].id != item.id)
+        return item;
+
+    const RenderItem &from = prev->items[index];
+    RenderItem out = item;
+    out.position = glm::mix(from.position, item.position, alpha);
+    out.scale = glm::mix(from.scale, item.scale, alpha);
+    return out;
+}
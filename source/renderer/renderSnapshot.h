@@ -0,0 +1,86 @@
+#ifndef INK_RENDERSNAPSHOT_H
+#define INK_RENDERSNAPSHOT_H
+
+#include <atomic>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+struct Mesh;
+
+// One drawable as the update thread saw it at the end of a tick.
+struct RenderItem {
+    enum Flags : uint32_t {
+        screenSpace = 1 << 0,  // SceneObject::m_screenSpace
+    };
+
+    uint32_t id;     // EntityHandle slot; matches the same entity across snapshots
+    uint32_t flags;  // RenderItem::Flags
+    Mesh *mesh;      // owned by the entity's SceneObject, which outlives the snapshot
+    glm::vec3 position;
+    glm::vec3 scale;
+    glm::vec4 uvRect;  // SceneObject::m_uvRect
+};
+
+// Everything the render thread needs for one frame, flat and self-contained.
+struct RenderSnapshot {
+    uint64_t tick = 0;
+    double time = 0.0;                     // simulation time the tick ended at (seconds)
+    glm::vec3 focus = glm::vec3(0.0f);     // camera target (player position)
+    std::vector<RenderItem> items;         // static level sprites, then entities in spawn order
+};
+
+/**
+ * Single-producer / single-consumer triple buffer of RenderSnapshots.
+ *
+ * The update thread fills writeSlot() and publish()es it; the render thread
+ * calls acquire() once per frame. Each side owns one slot and the third is
+ * exchanged through one atomic, so neither side ever locks, waits, or sees
+ * a half-written snapshot. Publishing faster than the reader drains simply
+ * replaces the pending snapshot.
+ *
+ * The reader keeps the snapshot it read before the latest one so frames
+ * can interpolate between the two most recent ticks.
+ */
+class SnapshotBuffer {
+public:
+    /*───── update thread ──────────────────────────────────────────────────*/
+    // Slot to overwrite for the next publish(); its previous contents are stale.
+    RenderSnapshot &writeSlot() {
+        return m_slots[m_write];
+    }
+    void publish();
+
+    /*───── render thread ──────────────────────────────────────────────────*/
+    // Take the newest published snapshot, if any. Returns true when a new one
+    // arrived since the last call.
+    bool acquire();
+    // Newest snapshot seen by acquire(); nullptr until the first publish.
+    const RenderSnapshot *latest() const {
+        return m_hasLatest ? &m_slots[m_read] : nullptr;
+    }
+    // The snapshot acquired before latest(); nullptr until two have arrived.
+    const RenderSnapshot *previous() const {
+        return m_hasPrevious ? &m_previous : nullptr;
+    }
+
+private:
+    static constexpr uint8_t kIndexMask = 0x3;
+    static constexpr uint8_t kFresh = 0x4;  // middle slot holds an unread snapshot
+
+    RenderSnapshot m_slots[3];
+    std::atomic<uint8_t> m_middle{1};
+    uint8_t m_write = 0;  // update thread only
+    uint8_t m_read = 2;   // render thread only
+
+    RenderSnapshot m_previous;  // render thread only
+    bool m_hasLatest = false;
+    bool m_hasPrevious = false;
+};
+
+// Interpolated transform of `item` between the snapshot before it and now.
+// `prev` may be nullptr or not contain the item; then `item` is used as is.
+RenderItem interpolate(const RenderItem &item, const RenderSnapshot *prev, std::size_t index,
+                       float alpha);
+
+#endif  // INK_RENDERSNAPSHOT_H
@@ -3,7 +3,12 @@
 
 #include "textureManager.h"
 
+#include "core/profiler.h"
+#include "gpuTimer.h"
+#include "renderSnapshot.h"
 #include "scene_object.h"
+#include "spriteBatch.h"
+#include "spriteRenderer.h"
 
 #include <memory>
 #include <vector>
@@ -11,16 +16,33 @@
 using std::shared_ptr;
 using std::vector;
 
+// Draws the frame's RenderItems.
+// - Items whose mesh has no vertex array are quads: they go through the
+//   SpriteBatch and are drawn instanced, one call per (shader, texture).
+// - Items with their own vertex array keep the per-object path.
+// View/projection go into one uniform buffer per frame (block "Camera",
+// shared by every program) instead of two uniforms per program and object.
+// getStats() reports the GL work of the last frame.
 class Renderer {
     static Renderer *s_instance;
 
     Renderer() = default;
     ~Renderer() = default;
 
-    vector<shared_ptr<SceneObject>> m_renderQueue;
+    vector<RenderItem> m_renderQueue;  // flat copies; no entity state is read while drawing
     glm::mat4 m_viewMat;
     glm::mat4 m_projMat;
 
+    std::unique_ptr<SpriteRenderer> m_spriteRenderer;  // created on first use (needs GL)
+    u32 m_cameraUbo = 0;                               // likewise
+    glm::mat4 m_uploadedCamera[2];                     // view, projection in m_cameraUbo
+    bool m_cameraUploaded = false;
+#if INK_PROFILE
+    std::unique_ptr<GpuTimer> m_gpuTimer;  // GPU time of endScene()
+#endif
+    SpriteBatch m_sprites;
+    RenderStats m_stats;
+
 public:
     static Renderer *getInstance() {
         if (s_instance == nullptr) {
@@ -32,37 +54,104 @@ public:
     void beginScene(const glm::mat4 &viewMat, const glm::mat4 &projMat) {
         m_viewMat = viewMat;
         m_projMat = projMat;
+        m_stats = {};
+        Shader::stats() = {};
     }
 
-    void submit(const std::shared_ptr<SceneObject> &object) {
-        m_renderQueue.push_back(object);
+    void submit(const RenderItem &item) {
+        m_renderQueue.push_back(item);
     }
 
     void clearQueue() {
         m_renderQueue.clear();
     }
 
+    const RenderStats &getStats() const {
+        return m_stats;
+    }
+
     void endScene() {
+        INK_PROFILE_SCOPE("render endScene");
+#if INK_PROFILE
+        if (!m_gpuTimer) {
+            m_gpuTimer = std::make_unique<GpuTimer>("gpu endScene");
+        }
+        m_gpuTimer->begin();
+#endif
         glClear(GL_COLOR_BUFFER_BIT);
 
-        for (const auto &obj: m_renderQueue) {
-            obj->m_mesh->m_vertexArray->bind();
-            obj->m_mesh->m_shader->bind();
+        if (!m_spriteRenderer) {
+            m_spriteRenderer = std::make_unique<SpriteRenderer>();
+        }
+        uploadCamera();
+
+        m_sprites.clear();
+        for (const auto &item: m_renderQueue) {
+            const Mesh &mesh = *item.mesh;
+            if (!mesh.m_vertexArray) {
+                const bool screen = item.flags & RenderItem::screenSpace;
+                // Atlas regions batch under their page.
+                const Texture *texture = mesh.m_texture.get();
+                glm::vec4 atlasRect(0.0f, 0.0f, 1.0f, 1.0f);
+                if (texture && texture->m_atlasPage) {
+                    const float *r = texture->m_atlasRect;
+                    atlasRect = glm::vec4(r[0], r[1], r[2], r[3]);
+                    texture = texture->m_atlasPage;
+                }
+                m_sprites.submit(m_spriteRenderer->shader(), texture,
+                                 {item.position, glm::vec2(item.scale), item.uvRect,
+                                  screen ? 1.0f : 0.0f, atlasRect});
+                continue;
+            }
+
+            mesh.m_vertexArray->bind();
+            mesh.m_shader->bind();
+            ++m_stats.shaderBinds;
 
-            if (obj->m_mesh->m_texture) {
-                obj->m_mesh->m_texture->bind();
+            if (mesh.m_texture) {
+                mesh.m_texture->bind();
+                ++m_stats.textureBinds;
             }
 
-            obj->m_mesh->m_shader->setMat4("u_viewMat", m_viewMat);
-            obj->m_mesh->m_shader->setMat4("u_projMat", m_projMat);
+            constexpr UniformId kPosition("u_position"), kScale("u_scale"),
+                    kScreenSpace("u_screenSpace");
+            mesh.m_shader->setVec3(kPosition, item.position);
+            mesh.m_shader->setVec3(kScale, item.scale);
+            mesh.m_shader->setInt(kScreenSpace, (item.flags & RenderItem::screenSpace) ? 1 : 0);
 
-            obj->m_mesh->m_shader->setVec3("u_position", obj->m_transform.m_position);
-            obj->m_mesh->m_shader->setVec3("u_scale", obj->m_transform.m_scale);
-            obj->m_mesh->m_shader->setInt("u_screenSpace", obj->m_screenSpace ? 1 : 0);
+            glDrawElements(GL_TRIANGLES, mesh.m_vertexArray->getIndexCount(), GL_UNSIGNED_INT,
+                           nullptr);
+            ++m_stats.drawCalls;
+        }
 
-            glDrawElements(GL_TRIANGLES, obj->m_mesh->m_vertexArray->getIndexCount(),
-                           GL_UNSIGNED_INT, nullptr);
+        m_sprites.build();
+        m_spriteRenderer->draw(m_sprites, m_stats);
+        m_stats.shader = Shader::stats();
+#if INK_PROFILE
+        m_gpuTimer->end();
+#endif
+    }
+
+private:
+    // std140 block "Camera" { mat4 u_viewMat; mat4 u_projMat; }: two
+    // column-major mat4s back to back, bound at Shader::kCameraBinding.
+    void uploadCamera() {
+        if (!m_cameraUbo) {
+            glGenBuffers(1, &m_cameraUbo);
+            glBindBuffer(GL_UNIFORM_BUFFER, m_cameraUbo);
+            glBufferData(GL_UNIFORM_BUFFER, 2 * sizeof(glm::mat4), nullptr, GL_DYNAMIC_DRAW);
+            glBindBufferBase(GL_UNIFORM_BUFFER, Shader::kCameraBinding, m_cameraUbo);
+        }
+        if (m_cameraUploaded && m_uploadedCamera[0] == m_viewMat &&
+            m_uploadedCamera[1] == m_projMat) {
+            return;
         }
+        m_uploadedCamera[0] = m_viewMat;
+        m_uploadedCamera[1] = m_projMat;
+        m_cameraUploaded = true;
+        glBindBuffer(GL_UNIFORM_BUFFER, m_cameraUbo);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(m_uploadedCamera), m_uploadedCamera);
+        ++m_stats.cameraUploads;
     }
 };
 
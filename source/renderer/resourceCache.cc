@@ -0,0 +1,38 @@
+#include "resourceCache.h"
+
+#include <chrono>
+#include <iostream>
+
+namespace {
+double msSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+}
+}  // namespace
+
+std::shared_ptr<ResourceCache> ResourceCache::instance() {
+    static auto inst = std::make_shared<ResourceCache>();
+    return inst;
+}
+
+std::shared_ptr<Shader> ResourceCache::getShader(const std::string &vertexPath,
+                                                 const std::string &fragmentPath) {
+    const std::string key = vertexPath + '|' + fragmentPath;
+    auto it = m_shaders.find(key);
+    if (it != m_shaders.end()) {
+        ++m_stats.shaderHits;
+        return it->second;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    auto shader = std::make_shared<Shader>(vertexPath.c_str(), fragmentPath.c_str());
+    m_stats.missMs += msSince(start);
+    ++m_stats.shaderMisses;
+    std::cout << "[ResourceCache] Compiled shader " << key << "\n";
+    m_shaders.emplace(key, shader);
+    return shader;
+}
+
+void ResourceCache::clear() {
+    m_shaders.clear();
+}
@@ -0,0 +1,51 @@
+#ifndef INK_RESOURCECACHE_H
+#define INK_RESOURCECACHE_H
+
+#include "shader.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+/// Hit/miss counters; missMs is time spent loading/compiling/uploading on misses.
+struct ResourceCacheStats {
+    uint64_t shaderHits = 0;
+    uint64_t shaderMisses = 0;
+    double missMs = 0.0;
+};
+
+/**
+ * Shared GL programs.
+ *
+ * Shaders are keyed by their (vertex, fragment) file pair, so asking twice
+ * returns the same program and only the first request reads files and
+ * compiles. Entries live until clear(); everything handed out is shared, so
+ * treat it as immutable. Geometry needs no cache: entities are sprites on
+ * SpriteRenderer's one quad.
+ *
+ * Render thread only (misses need the GL context).
+ */
+class ResourceCache {
+public:
+    /// Get the singleton instance
+    static std::shared_ptr<ResourceCache> instance();
+
+    std::shared_ptr<Shader> getShader(const std::string &vertexPath,
+                                      const std::string &fragmentPath);
+
+    const ResourceCacheStats &stats() const {
+        return m_stats;
+    }
+    void clear();
+
+    ResourceCache() = default;
+    ResourceCache(const ResourceCache &) = delete;
+    ResourceCache &operator=(const ResourceCache &) = delete;
+
+private:
+    std::unordered_map<std::string, std::shared_ptr<Shader>> m_shaders;  // "vs|fs" -> program
+    ResourceCacheStats m_stats;
+};
+
+#endif  // INK_RESOURCECACHE_H
@@ -13,9 +13,11 @@ using std::shared_ptr;
 using std::vector;
 
 
+// A mesh with no vertex array is a sprite: the Renderer draws it as the
+// shared unit quad through its SpriteBatch, so only the texture is needed.
 struct Mesh {
-    shared_ptr<VertexArray> m_vertexArray;
-    shared_ptr<Shader> m_shader;
+    shared_ptr<VertexArray> m_vertexArray;  // null for sprites
+    shared_ptr<Shader> m_shader;            // null for sprites
     shared_ptr<Texture> m_texture;
 };
 
@@ -23,6 +25,7 @@ struct SceneObject {
     shared_ptr<Mesh> m_mesh;
     Transform m_transform;
     bool m_screenSpace = false; // true to render in NDC/screen space
+    glm::vec4 m_uvRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f); // sprite UVs: xy offset, zw size
 };
 
 
@@ -1,5 +1,7 @@
 // shader.cc
 #include "shader.h"
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
@@ -71,33 +73,159 @@ Shader::Shader(const char *vertexPath, const char *fragmentPath) {
 
     glDeleteShader(vertID);
     glDeleteShader(fragID);
+
+    GLuint camera = glGetUniformBlockIndex(rendererID, kCameraBlock);
+    if (camera != GL_INVALID_INDEX) {
+        glUniformBlockBinding(rendererID, camera, kCameraBinding);
+    }
+    buildUniformTable();
+}
+
+ShaderStats &Shader::stats() {
+    static ShaderStats s_stats;
+    return s_stats;
+}
+
+namespace {
+// 4-byte words a uniform of `type` holds; 0 for types we don't cache.
+uint16_t uniformWords(GLenum type) {
+    switch (type) {
+        case GL_FLOAT:
+        case GL_INT:
+        case GL_BOOL:
+        case GL_SAMPLER_2D:
+            return 1;
+        case GL_FLOAT_VEC2:
+            return 2;
+        case GL_FLOAT_VEC3:
+            return 3;
+        case GL_FLOAT_VEC4:
+            return 4;
+        case GL_FLOAT_MAT4:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+// Program last made current through Shader::bind(); 0 if unknown.
+GLuint s_boundProgram = 0;
+}  // namespace
+
+void Shader::buildUniformTable() {
+    GLint count = 0, maxName = 0;
+    glGetProgramiv(rendererID, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(rendererID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxName);
+
+    std::string name(static_cast<std::size_t>(std::max(maxName, 1)), '\0');
+    uint16_t offset = 0;
+    for (GLuint i = 0; i < static_cast<GLuint>(count); ++i) {
+        GLint block = -1;
+        glGetActiveUniformsiv(rendererID, 1, &i, GL_UNIFORM_BLOCK_INDEX, &block);
+        if (block != -1)
+            continue;  // lives in a uniform buffer (Camera)
+
+        GLsizei length = 0;
+        GLint arraySize = 0;
+        GLenum type = 0;
+        glGetActiveUniform(rendererID, i, maxName, &length, &arraySize, &type, &name[0]);
+        std::string_view view(name.data(), static_cast<std::size_t>(length));
+        if (view.size() > 3 && view.substr(view.size() - 3) == "[0]")
+            view.remove_suffix(3);  // arrays: cache element 0, like glUniform* on the name
+
+        const uint16_t words = uniformWords(type);
+        const int location = glGetUniformLocation(rendererID, std::string(view).c_str());
+        m_uniforms.push_back({UniformId(view).hash, location, offset, words, false});
+        offset = static_cast<uint16_t>(offset + words);
+    }
+    m_values.assign(offset, 0u);
+
+    std::sort(m_uniforms.begin(), m_uniforms.end(),
+              [](const Uniform &a, const Uniform &b) { return a.hash < b.hash; });
+    for (std::size_t i = 1; i < m_uniforms.size(); ++i) {
+        if (m_uniforms[i].hash == m_uniforms[i - 1].hash) {
+            throw std::runtime_error("ERROR::SHADER::PROGRAM::UNIFORM_HASH_COLLISION");
+        }
+    }
+}
+
+Shader::Uniform *Shader::changed(UniformId id, const void *data, std::size_t bytes) const {
+    // A handful of uniforms per program: a linear scan beats anything fancier.
+    for (Uniform &u: m_uniforms) {
+        if (u.hash != id.hash)
+            continue;
+        if (u.size * sizeof(uint32_t) != bytes) {
+            ++stats().uniformUploads;  // type we don't cache, or a mismatched setter
+            return &u;
+        }
+        uint32_t *last = &m_values[u.offset];
+        if (u.uploaded && std::memcmp(last, data, bytes) == 0) {
+            ++stats().uniformUploadsSkipped;
+            return nullptr;
+        }
+        std::memcpy(last, data, bytes);
+        u.uploaded = true;
+        ++stats().uniformUploads;
+        return &u;
+    }
+    ++stats().unknownUniforms;
+    return nullptr;
 }
 
 void Shader::bind() {
+    if (s_boundProgram == rendererID) {
+        ++stats().programBindsSkipped;
+        return;
+    }
     glUseProgram(rendererID);
+    s_boundProgram = rendererID;
+    ++stats().programBinds;
+}
+
+void Shader::setBool(UniformId id, bool value) const {
+    setInt(id, value ? 1 : 0);
+}
+
+void Shader::setInt(UniformId id, int value) const {
+    if (const Uniform *u = changed(id, &value, sizeof(value)))
+        glUniform1i(u->location, value);
+}
+
+void Shader::setFloat(UniformId id, float value) const {
+    if (const Uniform *u = changed(id, &value, sizeof(value)))
+        glUniform1f(u->location, value);
+}
+
+void Shader::setVec3(UniformId id, glm::vec3 value) const {
+    if (const Uniform *u = changed(id, glm::value_ptr(value), sizeof(value)))
+        glUniform3fv(u->location, 1, glm::value_ptr(value));
+}
+
+void Shader::setMat4(UniformId id, const glm::mat4 &value) const {
+    if (const Uniform *u = changed(id, glm::value_ptr(value), sizeof(value)))
+        glUniformMatrix4fv(u->location, 1, GL_FALSE, glm::value_ptr(value));
 }
 
 void Shader::setBool(const std::string &name, bool value) const {
-    glUniform1i(glGetUniformLocation(rendererID, name.c_str()), (int) value);
+    setBool(UniformId(name), value);
 }
 
 void Shader::setInt(const std::string &name, int value) const {
-    glUniform1i(glGetUniformLocation(rendererID, name.c_str()), value);
+    setInt(UniformId(name), value);
 }
 
 void Shader::setFloat(const std::string &name, float value) const {
-    glUniform1f(glGetUniformLocation(rendererID, name.c_str()), value);
+    setFloat(UniformId(name), value);
 }
 
 void Shader::setVec3(const std::string &name, glm::vec3 value) const {
-    glUniform3fv(glGetUniformLocation(rendererID, name.c_str()), 1, glm::value_ptr(value));
+    setVec3(UniformId(name), value);
 }
 
 void Shader::setVec3(const std::string &name, float x, float y, float z) const {
-    glUniform3f(glGetUniformLocation(rendererID, name.c_str()), x, y, z);
+    setVec3(UniformId(name), glm::vec3(x, y, z));
 }
 
 void Shader::setMat4(const std::string &name, glm::mat4 value) const {
-    glUniformMatrix4fv(glGetUniformLocation(rendererID, name.c_str()), 1, GL_FALSE,
-                       glm::value_ptr(value));
+    setMat4(UniformId(name), value);
 }
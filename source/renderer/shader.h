@@ -9,16 +9,46 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <vector>
 #include <filesystem>
 
 namespace fs = std::filesystem;
 
+// Handle for a uniform: FNV-1a of its name. Built from a string literal in a
+// constexpr context it costs nothing at runtime, e.g.
+//     constexpr UniformId kPosition("u_position");
+struct UniformId {
+    uint32_t hash;
+
+    constexpr explicit UniformId(std::string_view name) : hash(2166136261u) {
+        for (char c: name) {
+            hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+        }
+    }
+};
+
+// GL calls issued through Shader, summed over every program. The Renderer
+// resets this each frame and reports it in RenderStats.
+struct ShaderStats {
+    uint32_t programBinds = 0;
+    uint32_t programBindsSkipped = 0;  // program was already current
+    uint32_t uniformUploads = 0;
+    uint32_t uniformUploadsSkipped = 0;  // value matched the last upload
+    uint32_t unknownUniforms = 0;        // inactive or misspelled; never uploaded
+};
+
 class Shader {
 public:
+    // Uniform block every program shares for view/projection (see Renderer).
+    static constexpr const char *kCameraBlock = "Camera";
+    static constexpr unsigned int kCameraBinding = 0;
+
     // ID or shader handle
     unsigned int rendererID;
 
@@ -26,16 +56,46 @@ public:
     // Local path is accepted, must be prepended with '/'
     Shader(const char *vertexPath, const char *fragmentPath);
 
-    // Binds shader for use
+    // Binds shader for use; no GL call if it is already the current program
     void bind();
 
-    // Setting shader uniforms
+    // Setting shader uniforms. Locations are resolved once after linking, and
+    // a value equal to the last one uploaded is skipped. Like glUniform*,
+    // these act on the current program, so bind() first.
+    void setBool(UniformId id, bool value) const;
+    void setInt(UniformId id, int value) const;
+    void setFloat(UniformId id, float value) const;
+    void setVec3(UniformId id, glm::vec3 value) const;
+    void setMat4(UniformId id, const glm::mat4 &value) const;
+
+    // Same, hashing the name at runtime
     void setBool(const std::string &name, bool value) const;
     void setInt(const std::string &name, int value) const;
     void setFloat(const std::string &name, float value) const;
     void setVec3(const std::string &name, glm::vec3 value) const;
     void setVec3(const std::string &name, float x, float y, float z) const;
     void setMat4(const std::string &name, glm::mat4 value) const;
+
+    static ShaderStats &stats();
+
+private:
+    // One active uniform outside any block; its last value lives in
+    // m_values[offset, offset + size).
+    struct Uniform {
+        uint32_t hash;
+        int location;
+        uint16_t offset;
+        uint16_t size;  // in 4-byte words
+        bool uploaded;
+    };
+
+    void buildUniformTable();
+    // The uniform to upload to, or nullptr when `id` is unknown or `data`
+    // matches its last upload. Records `data` as the new value.
+    Uniform *changed(UniformId id, const void *data, std::size_t bytes) const;
+
+    mutable std::vector<Uniform> m_uniforms;  // sorted by hash
+    mutable std::vector<uint32_t> m_values;
 };
 
 #endif  // CESIUM_SHADER_H
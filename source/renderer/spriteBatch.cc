@@ -0,0 +1,43 @@
+#include "spriteBatch.h"
+
+#include <algorithm>
+#include <tuple>
+
+void SpriteBatch::clear() {
+    m_pending.clear();
+    m_instances.clear();
+    m_batches.clear();
+}
+
+void SpriteBatch::submit(Shader *shader, const Texture *texture, const SpriteInstance &instance) {
+    m_pending.push_back({shader, texture, instance});
+}
+
+void SpriteBatch::build() {
+    m_order.resize(m_pending.size());
+    for (uint32_t i = 0; i < m_order.size(); ++i)
+        m_order[i] = i;
+
+    auto key = [this](uint32_t i) {
+        const Pending &p = m_pending[i];
+        return std::make_tuple(p.instance.screenSpace, p.instance.position.z,
+                               reinterpret_cast<uintptr_t>(p.shader),
+                               reinterpret_cast<uintptr_t>(p.texture));
+    };
+    std::stable_sort(m_order.begin(), m_order.end(), [&](uint32_t a, uint32_t b) {
+        return key(a) < key(b);
+    });
+
+    m_instances.clear();
+    m_batches.clear();
+    m_instances.reserve(m_pending.size());
+    for (uint32_t i: m_order) {
+        const Pending &p = m_pending[i];
+        if (m_batches.empty() || m_batches.back().shader != p.shader ||
+            m_batches.back().texture != p.texture) {
+            m_batches.push_back({p.shader, p.texture, static_cast<uint32_t>(m_instances.size()), 0});
+        }
+        ++m_batches.back().count;
+        m_instances.push_back(p.instance);
+    }
+}
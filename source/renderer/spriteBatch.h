@@ -0,0 +1,71 @@
+#ifndef INK_SPRITEBATCH_H
+#define INK_SPRITEBATCH_H
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+class Shader;
+struct Texture;
+
+// Per-instance vertex data for sprite.vs; the layout is the GL attribute layout.
+struct SpriteInstance {
+    glm::vec3 position;
+    glm::vec2 scale;
+    glm::vec4 uvRect;   // xy = offset, zw = size
+    float screenSpace;  // 0 or 1
+    // The texture's region when it lives in an atlas page; uvRect wraps
+    // inside it (sprite.fs). The default is the whole texture.
+    glm::vec4 atlasRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+};
+
+// A run of instances that share shader and texture: one instanced draw call.
+struct SpriteBatchRange {
+    Shader *shader;
+    const Texture *texture;
+    uint32_t first;  // index into SpriteBatch::instances()
+    uint32_t count;
+};
+
+/**
+ * CPU side of the sprite renderer: collects quads for one frame, sorts them
+ * into (layer, shader, texture) order and packs the instance array that
+ * SpriteRenderer streams to the GPU.
+ *
+ * Layer is screen-space last, then ascending z, so overlays stay on top of
+ * the world. Within a layer, sprites of different textures no longer draw
+ * in submission order; the sort is stable for sprites sharing one.
+ * No GL calls, so it is usable (and benchmarked) headless.
+ */
+class SpriteBatch {
+public:
+    void clear();
+    void submit(Shader *shader, const Texture *texture, const SpriteInstance &instance);
+
+    // Sort submissions and rebuild instances() and batches().
+    void build();
+
+    std::size_t size() const {
+        return m_pending.size();
+    }
+    const std::vector<SpriteInstance> &instances() const {
+        return m_instances;
+    }
+    const std::vector<SpriteBatchRange> &batches() const {
+        return m_batches;
+    }
+
+private:
+    struct Pending {
+        Shader *shader;
+        const Texture *texture;
+        SpriteInstance instance;
+    };
+
+    std::vector<Pending> m_pending;
+    std::vector<uint32_t> m_order;  // scratch for the sort
+    std::vector<SpriteInstance> m_instances;
+    std::vector<SpriteBatchRange> m_batches;
+};
+
+#endif  // INK_SPRITEBATCH_H
@@ -0,0 +1,116 @@
+#include "spriteRenderer.h"
+#include "resourceCache.h"
+#include "texture.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <glad/glad.h>
+
+namespace {
+constexpr f32 kQuadCorners[] = {-0.5f, -0.5f, -0.5f, 0.5f, 0.5f, 0.5f, 0.5f, -0.5f};
+constexpr u32 kQuadIndices[] = {0, 1, 2, 0, 2, 3};
+
+enum Attribute : u32 {
+    aCorner = 0,
+    iPosition = 1,
+    iScale = 2,
+    iUvRect = 3,
+    iScreenSpace = 4,
+    iAtlasRect = 5,
+};
+}  // namespace
+
+SpriteRenderer::SpriteRenderer()
+    : m_shader(ResourceCache::instance()->getShader("sprite.vs", "sprite.fs")) {
+    glGenVertexArrays(1, &m_vao);
+    glBindVertexArray(m_vao);
+
+    glGenBuffers(1, &m_quadVbo);
+    glBindBuffer(GL_ARRAY_BUFFER, m_quadVbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(kQuadCorners), kQuadCorners, GL_STATIC_DRAW);
+    glEnableVertexAttribArray(aCorner);
+    glVertexAttribPointer(aCorner, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(f32), nullptr);
+
+    glGenBuffers(1, &m_quadIbo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_quadIbo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(kQuadIndices), kQuadIndices, GL_STATIC_DRAW);
+
+    glGenBuffers(1, &m_instanceVbo);
+    for (u32 a: {iPosition, iScale, iUvRect, iScreenSpace, iAtlasRect}) {
+        glEnableVertexAttribArray(a);
+        glVertexAttribDivisor(a, 1);
+    }
+
+    glBindVertexArray(0);
+}
+
+SpriteRenderer::~SpriteRenderer() {
+    glDeleteBuffers(1, &m_instanceVbo);
+    glDeleteBuffers(1, &m_quadIbo);
+    glDeleteBuffers(1, &m_quadVbo);
+    glDeleteVertexArrays(1, &m_vao);
+}
+
+void SpriteRenderer::pointInstanceAttributes(u32 firstInstance) {
+    const auto stride = static_cast<GLsizei>(sizeof(SpriteInstance));
+    const std::size_t base = firstInstance * sizeof(SpriteInstance);
+    auto at = [base](std::size_t member) {
+        return reinterpret_cast<const void *>(base + member);
+    };
+    glVertexAttribPointer(iPosition, 3, GL_FLOAT, GL_FALSE, stride,
+                          at(offsetof(SpriteInstance, position)));
+    glVertexAttribPointer(iScale, 2, GL_FLOAT, GL_FALSE, stride, at(offsetof(SpriteInstance, scale)));
+    glVertexAttribPointer(iUvRect, 4, GL_FLOAT, GL_FALSE, stride,
+                          at(offsetof(SpriteInstance, uvRect)));
+    glVertexAttribPointer(iScreenSpace, 1, GL_FLOAT, GL_FALSE, stride,
+                          at(offsetof(SpriteInstance, screenSpace)));
+    glVertexAttribPointer(iAtlasRect, 4, GL_FLOAT, GL_FALSE, stride,
+                          at(offsetof(SpriteInstance, atlasRect)));
+}
+
+void SpriteRenderer::draw(const SpriteBatch &batch, RenderStats &stats) {
+    const auto &instances = batch.instances();
+    if (instances.empty())
+        return;
+
+    glBindVertexArray(m_vao);
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceVbo);
+
+    const std::size_t bytes = instances.size() * sizeof(SpriteInstance);
+    if (bytes > m_instanceCapacity) {
+        m_instanceCapacity = std::max(bytes, m_instanceCapacity * 2);
+    }
+    // Orphan, then fill: the previous frame's storage stays with the GPU.
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_instanceCapacity), nullptr,
+                 GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(bytes), instances.data());
+    stats.bytesStreamed += bytes;
+
+    const Shader *boundShader = nullptr;
+    const Texture *boundTexture = nullptr;
+    bool textureBound = false;
+    for (const SpriteBatchRange &range: batch.batches()) {
+        if (range.shader != boundShader) {
+            range.shader->bind();  // camera comes from the Renderer's uniform buffer
+            boundShader = range.shader;
+            ++stats.shaderBinds;
+        }
+        if (!textureBound || range.texture != boundTexture) {
+            if (range.texture)
+                range.texture->bind();
+            else
+                glBindTexture(GL_TEXTURE_2D, 0);
+            boundTexture = range.texture;
+            textureBound = true;
+            ++stats.textureBinds;
+        }
+
+        pointInstanceAttributes(range.first);
+        glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr,
+                                static_cast<GLsizei>(range.count));
+        ++stats.drawCalls;
+        stats.sprites += range.count;
+    }
+
+    glBindVertexArray(0);
+}
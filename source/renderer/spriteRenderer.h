@@ -0,0 +1,62 @@
+#ifndef INK_SPRITERENDERER_H
+#define INK_SPRITERENDERER_H
+
+#include "buffers.h"
+#include "shader.h"
+#include "spriteBatch.h"
+
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <memory>
+
+// Per-frame GL work done by the Renderer, reset in beginScene().
+struct RenderStats {
+    u32 drawCalls = 0;
+    u32 shaderBinds = 0;
+    u32 textureBinds = 0;
+    u32 sprites = 0;           // instances drawn through SpriteRenderer
+    std::size_t bytesStreamed = 0;  // instance data uploaded this frame
+    u32 cameraUploads = 0;          // view/projection uniform buffer updates
+    ShaderStats shader;             // program binds and uniform uploads
+};
+
+/**
+ * GL side of sprite batching: one unit quad (VBO + IBO) shared by every
+ * sprite, one streamed instance VBO, and sprite.vs/.fs. Each
+ * SpriteBatchRange becomes one glDrawElementsInstanced call.
+ *
+ * The instance buffer is orphaned (glBufferData with nullptr) before each
+ * upload so the driver never stalls on a buffer the GPU is still reading.
+ * GL 3.3 has no persistent mapping or base-instance draws, so each range
+ * re-points the instance attributes at its offset instead.
+ *
+ * Needs a current GL context; create it on the render thread.
+ */
+class SpriteRenderer {
+public:
+    SpriteRenderer();
+    ~SpriteRenderer();
+
+    SpriteRenderer(const SpriteRenderer &) = delete;
+    SpriteRenderer &operator=(const SpriteRenderer &) = delete;
+
+    // Shader every sprite is drawn with (the batch key's shader).
+    Shader *shader() {
+        return m_shader.get();
+    }
+
+    // Expects the camera uniform buffer to be bound (Renderer::endScene).
+    void draw(const SpriteBatch &batch, RenderStats &stats);
+
+private:
+    void pointInstanceAttributes(u32 firstInstance);
+
+    std::shared_ptr<Shader> m_shader;  // shared through ResourceCache
+    u32 m_vao = 0;
+    u32 m_quadVbo = 0;
+    u32 m_quadIbo = 0;
+    u32 m_instanceVbo = 0;
+    std::size_t m_instanceCapacity = 0;  // bytes allocated for m_instanceVbo
+};
+
+#endif  // INK_SPRITERENDERER_H
@@ -0,0 +1,15 @@
+#include "texture.h"
+
+#include <glad/glad.h>
+
+void Texture::bind() const {
+    glBindTexture(GL_TEXTURE_2D, m_rendererID);
+
+    // Keep filters consistent with mipmap availability
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_hasMipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+}
+
+void Texture::unbind() const {
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
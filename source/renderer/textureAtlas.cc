@@ -0,0 +1,166 @@
+#include "textureAtlas.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+/*────────────────────────────   skyline   ───────────────────────────────*/
+SkylinePacker::SkylinePacker(int width, int height) : m_width(width), m_height(height) {
+    m_skyline.push_back({0, 0, width});
+}
+
+int SkylinePacker::fitAt(std::size_t i, int w, int h) const {
+    if (m_skyline[i].x + w > m_width)
+        return -1;
+    int y = 0;
+    for (int left = w; left > 0 && i < m_skyline.size(); ++i) {
+        y = std::max(y, m_skyline[i].y);
+        if (y + h > m_height)
+            return -1;
+        left -= m_skyline[i].width;
+    }
+    return y;
+}
+
+bool SkylinePacker::insert(int w, int h, int &x, int &y) {
+    std::size_t best = m_skyline.size();
+    int bestTop = 0;
+    long long bestWaste = 0;
+    for (std::size_t i = 0; i < m_skyline.size(); ++i) {
+        const int top = fitAt(i, w, h);
+        if (top < 0)
+            continue;
+        // Area left empty under the rectangle.
+        long long waste = 0;
+        const int right = m_skyline[i].x + w;
+        for (std::size_t j = i; j < m_skyline.size() && m_skyline[j].x < right; ++j) {
+            const int span = std::min(right, m_skyline[j].x + m_skyline[j].width) - m_skyline[j].x;
+            waste += static_cast<long long>(top - m_skyline[j].y) * span;
+        }
+        if (best == m_skyline.size() || top < bestTop ||
+            (top == bestTop && waste < bestWaste)) {
+            best = i;
+            bestTop = top;
+            bestWaste = waste;
+        }
+    }
+    if (best == m_skyline.size())
+        return false;
+
+    x = m_skyline[best].x;
+    y = bestTop;
+    m_skyline.insert(m_skyline.begin() + best, {x, y + h, w});
+
+    // Trim or drop the segments the new one now covers.
+    for (std::size_t j = best + 1; j < m_skyline.size();) {
+        Segment &s = m_skyline[j];
+        const int overlap = x + w - s.x;
+        if (overlap <= 0)
+            break;
+        s.x += overlap;
+        s.width -= overlap;
+        if (s.width > 0)
+            break;
+        m_skyline.erase(m_skyline.begin() + j);
+    }
+    for (std::size_t j = 0; j + 1 < m_skyline.size();) {
+        if (m_skyline[j].y == m_skyline[j + 1].y) {
+            m_skyline[j].width += m_skyline[j + 1].width;
+            m_skyline.erase(m_skyline.begin() + j + 1);
+        } else {
+            ++j;
+        }
+    }
+
+    m_usedWidth = std::max(m_usedWidth, x + w);
+    m_usedHeight = std::max(m_usedHeight, y + h);
+    m_usedArea += static_cast<std::size_t>(w) * h;
+    return true;
+}
+
+/*─────────────────────────────   atlas   ────────────────────────────────*/
+namespace {
+struct Placement {
+    int page = -1;
+    int x = 0, y = 0;  // gutter corner
+};
+
+int wrap(int v, int n) {
+    return ((v % n) + n) % n;
+}
+
+// Copy `src` into `page` at (x, y) with `padding` texels of wrapped gutter.
+void blit(AtlasPage &page, const AtlasSource &src, int x, int y, int padding) {
+    const std::size_t rowBytes = static_cast<std::size_t>(src.width) * 4;
+    for (int py = 0; py < src.height + 2 * padding; ++py) {
+        const unsigned char *srcRow = src.rgba + wrap(py - padding, src.height) * rowBytes;
+        unsigned char *dst = page.rgba.data() +
+                             (static_cast<std::size_t>(y + py) * page.width + x) * 4;
+        for (int px = 0; px < padding; ++px) {
+            std::memcpy(dst + px * 4, srcRow + wrap(px - padding, src.width) * 4, 4);
+            std::memcpy(dst + (padding + src.width + px) * 4, srcRow + wrap(px, src.width) * 4,
+                        4);
+        }
+        std::memcpy(dst + padding * 4, srcRow, rowBytes);
+    }
+}
+}  // namespace
+
+TextureAtlas buildTextureAtlas(const std::vector<AtlasSource> &sources, int maxPageSize,
+                               int padding) {
+    TextureAtlas atlas;
+    std::vector<std::size_t> order(sources.size());
+    std::iota(order.begin(), order.end(), std::size_t(0));
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return sources[a].height > sources[b].height;
+    });
+
+    std::vector<SkylinePacker> packers;
+    std::vector<Placement> placed(sources.size());
+    for (std::size_t i: order) {
+        const AtlasSource &src = sources[i];
+        const int w = src.width + 2 * padding, h = src.height + 2 * padding;
+        if (!src.rgba || src.width <= 0 || src.height <= 0 || w > maxPageSize ||
+            h > maxPageSize) {
+            atlas.rejected.push_back(src.name);
+            continue;
+        }
+        Placement &p = placed[i];
+        for (std::size_t page = 0; page < packers.size() && p.page < 0; ++page) {
+            if (packers[page].insert(w, h, p.x, p.y))
+                p.page = static_cast<int>(page);
+        }
+        if (p.page < 0) {
+            packers.emplace_back(maxPageSize, maxPageSize);
+            packers.back().insert(w, h, p.x, p.y);
+            p.page = static_cast<int>(packers.size() - 1);
+        }
+    }
+
+    atlas.pages.resize(packers.size());
+    for (std::size_t page = 0; page < packers.size(); ++page) {
+        AtlasPage &out = atlas.pages[page];
+        out.width = packers[page].usedWidth();
+        out.height = packers[page].usedHeight();
+        out.rgba.assign(static_cast<std::size_t>(out.width) * out.height * 4, 0);
+    }
+    for (std::size_t i = 0; i < sources.size(); ++i) {
+        const Placement &p = placed[i];
+        if (p.page < 0)
+            continue;
+        const AtlasSource &src = sources[i];
+        AtlasPage &page = atlas.pages[p.page];
+        blit(page, src, p.x, p.y, padding);
+
+        AtlasRegion region;
+        region.name = src.name;
+        region.page = static_cast<uint32_t>(p.page);
+        region.uvRect[0] = float(p.x + padding) / float(page.width);
+        region.uvRect[1] = float(p.y + padding) / float(page.height);
+        region.uvRect[2] = float(src.width) / float(page.width);
+        region.uvRect[3] = float(src.height) / float(page.height);
+        atlas.regions.push_back(std::move(region));
+        atlas.usedTexels += static_cast<std::size_t>(src.width) * src.height;
+    }
+    return atlas;
+}
@@ -0,0 +1,91 @@
+#ifndef INK_TEXTUREATLAS_H
+#define INK_TEXTUREATLAS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Skyline bottom-left rectangle packer for one page.
+ *
+ * The skyline is the top edge of everything placed so far, kept as
+ * horizontal segments left to right. insert() tries every segment as the
+ * left end of the new rectangle and takes the lowest resulting top edge
+ * (ties: the least width wasted under it), so rows fill bottom-up without
+ * the bookkeeping of maxrects. Good enough for the tens of images a level
+ * uses; not thread safe.
+ */
+class SkylinePacker {
+public:
+    SkylinePacker(int width, int height);
+
+    /// Place a `w` x `h` rectangle; false (and nothing changes) if it does not fit.
+    bool insert(int w, int h, int &x, int &y);
+
+    /// Right and top edge of everything placed so far.
+    int usedWidth() const {
+        return m_usedWidth;
+    }
+    int usedHeight() const {
+        return m_usedHeight;
+    }
+    std::size_t usedArea() const {
+        return m_usedArea;
+    }
+
+private:
+    struct Segment {
+        int x, y, width;
+    };
+
+    // Top edge of a `w` wide rectangle whose left end is segment i; -1 if it does not fit.
+    int fitAt(std::size_t i, int w, int h) const;
+
+    int m_width, m_height;
+    int m_usedWidth = 0, m_usedHeight = 0;
+    std::size_t m_usedArea = 0;
+    std::vector<Segment> m_skyline;
+};
+
+/// One image to pack: RGBA rows bottom-up, as the loaders decode them.
+struct AtlasSource {
+    std::string name;
+    int width = 0, height = 0;
+    const unsigned char *rgba = nullptr;
+};
+
+/// Where a source landed: page index and its rectangle in that page's UVs.
+struct AtlasRegion {
+    std::string name;
+    uint32_t page = 0;
+    float uvRect[4] = {0.0f, 0.0f, 1.0f, 1.0f};  // xy = offset, zw = size
+};
+
+struct AtlasPage {
+    int width = 0, height = 0;
+    std::vector<unsigned char> rgba;  // width * height * 4
+};
+
+struct TextureAtlas {
+    std::vector<AtlasPage> pages;
+    std::vector<AtlasRegion> regions;   // in source order, packed sources only
+    std::vector<std::string> rejected;  // larger than a page; load them on their own
+    std::size_t usedTexels = 0;         // source texels, for occupancy
+};
+
+/**
+ * Pack `sources` (tallest first) into as few pages of at most
+ * `maxPageSize` square as needed. Each page is then trimmed to what it
+ * holds, so it is usually not a power of two.
+ *
+ * Every image gets `padding` texels of gutter filled with its own
+ * opposite edges, i.e. what GL_REPEAT would sample there. Bilinear
+ * filtering and the sprite shader's in-region wrapping (sprite.fs) then
+ * match a standalone repeating texture at mip levels below
+ * log2(padding); smaller mips blend neighbours slightly.
+ */
+TextureAtlas buildTextureAtlas(const std::vector<AtlasSource> &sources, int maxPageSize,
+                               int padding);
+
+#endif  // INK_TEXTUREATLAS_H
@@ -0,0 +1,134 @@
+#include "textureLoader.h"
+#include "core/profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <stb_image.h>
+
+namespace {
+// What a texture shows until its image arrives: flat mid grey.
+constexpr unsigned char kPlaceholderPixel[4] = {128, 128, 128, 255};
+
+double msSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+}
+}  // namespace
+
+TextureLoader::TextureLoader(std::shared_ptr<RenderBackend> backend, Settings settings)
+    : m_backend(std::move(backend)), m_settings(settings) {
+    m_placeholder = m_backend->createDynamicTexture(1, 1, kPlaceholderPixel);
+    const unsigned threads = std::max(1u, m_settings.decodeThreads);
+    for (unsigned i = 0; i < threads; ++i)
+        m_threads.emplace_back(&TextureLoader::decodeThread, this);
+}
+
+TextureLoader::~TextureLoader() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (std::thread &t: m_threads)
+        t.join();
+}
+
+std::shared_ptr<Texture> TextureLoader::load(const std::string &path) {
+    std::shared_ptr<Texture> texture = m_backend->createPendingTexture(*m_placeholder);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_requests.push_back({texture, path});
+        m_stats.queued = m_requests.size();
+    }
+    m_wake.notify_one();
+    return texture;
+}
+
+std::size_t TextureLoader::upload() {
+    INK_PROFILE_SCOPE("texture upload");
+    std::size_t bytes = 0, uploads = 0;
+    for (;;) {
+        Decoded image;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_decoded.empty())
+                break;
+            const Decoded &next = m_decoded.front();
+            const std::size_t nextBytes = std::size_t(4) * next.width * next.height;
+            if (uploads > 0 && bytes + nextBytes > m_settings.uploadBytesPerFrame)
+                break;
+            image = std::move(m_decoded.front());
+            m_decoded.pop_front();
+        }
+        if (std::shared_ptr<Texture> texture = image.texture.lock()) {
+            bytes += m_backend->finishTexture(*texture, image.width, image.height,
+                                              image.pixels.get());
+            ++uploads;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.decoded = m_decoded.size();
+    m_stats.uploadsLastFrame = uploads;
+    m_stats.uploadBytesLastFrame = bytes;
+    m_stats.uploadBytes += bytes;
+    m_stats.loaded += uploads;
+    return bytes;
+}
+
+bool TextureLoader::idle() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_requests.empty() && m_decoding == 0 && m_decoded.empty();
+}
+
+TextureLoadStats TextureLoader::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void TextureLoader::decodeThread() {
+    INK_PROFILE_THREAD("texture decode");
+    // Same orientation GlRenderBackend::loadTexture() asks for, without
+    // touching stb_image's process-wide setting.
+    stbi_set_flip_vertically_on_load_thread(true);
+    for (;;) {
+        Request request;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_stop || !m_requests.empty(); });
+            if (m_stop)
+                return;
+            request = std::move(m_requests.front());
+            m_requests.pop_front();
+            m_stats.queued = m_requests.size();
+            ++m_decoding;
+        }
+
+        Decoded image;
+        image.texture = request.texture;
+        double ms = 0.0;
+        if (!request.texture.expired()) {  // nobody wants it any more
+            INK_PROFILE_SCOPE("decode");
+            const auto start = std::chrono::steady_clock::now();
+            int channels = 0;
+            image.pixels = {stbi_load(request.path.c_str(), &image.width, &image.height, &channels,
+                                      4),
+                            stbi_image_free};
+            ms = msSince(start);
+            if (!image.pixels)
+                std::cerr << "[TextureLoader] Failed to load texture from " << request.path << "\n";
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        --m_decoding;
+        m_stats.decodeMs += ms;
+        m_stats.maxDecodeMs = std::max(m_stats.maxDecodeMs, ms);
+        if (image.pixels) {
+            m_decoded.push_back(std::move(image));
+            m_stats.decoded = m_decoded.size();
+        } else if (!request.texture.expired()) {
+            ++m_stats.failed;
+        }
+    }
+}
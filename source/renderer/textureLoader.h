@@ -0,0 +1,100 @@
+#ifndef INK_TEXTURELOADER_H
+#define INK_TEXTURELOADER_H
+
+#include "renderBackend.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// Counters for TextureLoader; a copy taken under its lock.
+struct TextureLoadStats {
+    std::size_t queued = 0;            // waiting for a decode thread
+    std::size_t decoded = 0;           // decoded, waiting for upload()
+    std::size_t uploadsLastFrame = 0;  // by the last upload() call
+    std::size_t uploadBytesLastFrame = 0;
+    uint64_t loaded = 0;               // totals since construction
+    uint64_t failed = 0;
+    uint64_t uploadBytes = 0;
+    double decodeMs = 0.0;             // summed over decode threads
+    double maxDecodeMs = 0.0;
+};
+
+/**
+ * Loads image files without stalling the render thread.
+ *
+ * load() returns at once with a pending Texture that draws as a small
+ * placeholder. Decode threads read and decode the file (stb_image), and
+ * upload(), called once per frame on the render thread, gives decoded
+ * images their GL storage, at most `uploadBytesPerFrame` per call (but
+ * always at least one image, so nothing waits forever). Holders of the
+ * handle see the real texture from the next draw on; nothing re-fetches.
+ *
+ * A file that fails to decode keeps the placeholder and is counted in
+ * `failed`. Construct, upload() and destroy on the render thread; load()
+ * and stats() may be called from any thread. Pending textures borrow the
+ * placeholder's GL name, so the loader must outlive them while pending.
+ */
+class TextureLoader {
+public:
+    struct Settings {
+        unsigned decodeThreads = 2;
+        std::size_t uploadBytesPerFrame = 4u << 20;
+    };
+
+    TextureLoader(std::shared_ptr<RenderBackend> backend, Settings settings);
+    explicit TextureLoader(std::shared_ptr<RenderBackend> backend)
+        : TextureLoader(std::move(backend), Settings{}) {
+    }
+    // Joins the decode threads; textures still pending keep the placeholder.
+    ~TextureLoader();
+
+    TextureLoader(const TextureLoader &) = delete;
+    TextureLoader &operator=(const TextureLoader &) = delete;
+
+    /// Pending texture for the image at `path`, decoded in the background.
+    std::shared_ptr<Texture> load(const std::string &path);
+
+    /// Upload decoded images within the frame budget; returns the bytes uploaded.
+    std::size_t upload();
+
+    /// True when nothing is queued, decoding or waiting for upload().
+    bool idle() const;
+
+    TextureLoadStats stats() const;
+
+private:
+    struct Request {
+        std::weak_ptr<Texture> texture;
+        std::string path;
+    };
+    struct Decoded {
+        std::weak_ptr<Texture> texture;
+        std::unique_ptr<unsigned char, void (*)(void *)> pixels{nullptr, nullptr};
+        int width = 0, height = 0;
+    };
+
+    void decodeThread();
+
+    std::shared_ptr<RenderBackend> m_backend;
+    Settings m_settings;
+    std::shared_ptr<Texture> m_placeholder;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::deque<Request> m_requests;
+    std::deque<Decoded> m_decoded;
+    std::size_t m_decoding = 0;
+    bool m_stop = false;
+    TextureLoadStats m_stats;
+
+    std::vector<std::thread> m_threads;
+};
+
+#endif  // INK_TEXTURELOADER_H
@@ -1,20 +1,29 @@
 // textureManager.cpp
 #include "textureManager.h"
-#include <stb_image.h>
-#include <glad/glad.h>
-#include <GLFW/glfw3.h>
+#include "textureAtlas.h"
+#include <algorithm>
 #include <iostream>
+#include <stb_image.h>
 using namespace std;
-// include your image‐loader (stb_image.h) and GL headers
+
+namespace {
+// Gutter around each atlas region; keeps mip levels 0-2 free of neighbours.
+constexpr int kAtlasPadding = 8;
+}  // namespace
 
 std::shared_ptr<TextureManager> TextureManager::instance() {
     static auto inst = std::make_shared<TextureManager>();
     return inst;
 }
 
+void TextureManager::setBackend(std::shared_ptr<RenderBackend> backend) {
+    m_loader.reset();  // textures it still had pending are never finished
+    m_backend = backend ? std::move(backend) : std::make_shared<NullRenderBackend>();
+}
+
 bool TextureManager::loadTexture(const std::string &name, const std::string &filePath) {
-    auto tex = std::make_shared<Texture>(filePath);
-    if (!tex || tex->m_rendererID == 0) {
+    auto tex = m_backend->loadTexture(filePath);
+    if (!tex) {
         std::cerr << "[TextureManager] Failed to load texture from " << filePath << "\n";
         return false;
     }
@@ -24,14 +33,28 @@ bool TextureManager::loadTexture(const std::string &name, const std::string &fil
     return true;
 }
 
+void TextureManager::loadTextureAsync(const std::string &name, const std::string &filePath) {
+    if (!m_loader)
+        m_loader = std::make_unique<TextureLoader>(m_backend);
+    sheetMap[name] = { m_loader->load(filePath), 0, 0 };
+}
+
+std::size_t TextureManager::uploadPendingTextures() {
+    return m_loader ? m_loader->upload() : 0;
+}
+
+TextureLoadStats TextureManager::textureLoadStats() const {
+    return m_loader ? m_loader->stats() : TextureLoadStats{};
+}
+
 // Create a GL texture intended for frequent CPU-side updates (RGBA8). Stores it
 // under `name` so other systems can fetch it by key and render it.
 bool TextureManager::createDynamicTexture(const std::string &name,
                                           int width,
                                           int height,
                                           const unsigned char *rgba) {
-    auto tex = std::make_shared<Texture>(width, height, rgba, /*generateMipmaps*/ false);
-    if (!tex || tex->m_rendererID == 0) {
+    auto tex = m_backend->createDynamicTexture(width, height, rgba);
+    if (!tex) {
         std::cerr << "[TextureManager] Failed to create dynamic texture: " << name << "\n";
         return false;
     }
@@ -51,10 +74,100 @@ bool TextureManager::updateDynamicTexture(const std::string &name,
         std::cerr << "[TextureManager] updateDynamicTexture: missing texture '" << name << "'\n";
         return false;
     }
-    it->second.texture->update(rgba, regenerateMipmaps);
+    Texture &texture = *it->second.texture;
+    m_backend->updateTexture(texture, rgba, {0, 0, texture.m_width, texture.m_height},
+                             regenerateMipmaps);
     return true;
 }
 
+bool TextureManager::updateDynamicTexture(const std::string &name,
+                                          const unsigned char *rgba,
+                                          uint64_t version,
+                                          const TextureRegion &dirty,
+                                          bool regenerateMipmaps) {
+    auto it = sheetMap.find(name);
+    if (it == sheetMap.end() || !it->second.texture) {
+        std::cerr << "[TextureManager] updateDynamicTexture: missing texture '" << name << "'\n";
+        return false;
+    }
+    Texture &texture = *it->second.texture;
+    if (version == texture.m_version)
+        return true;  // unchanged since the last upload
+    texture.m_version = version;
+
+    TextureRegion region;
+    region.x = std::max(dirty.x, 0);
+    region.y = std::max(dirty.y, 0);
+    region.width = std::min(dirty.x + dirty.width, texture.m_width) - region.x;
+    region.height = std::min(dirty.y + dirty.height, texture.m_height) - region.y;
+    if (!region.empty())
+        m_backend->updateTexture(texture, rgba, region, regenerateMipmaps);
+    return true;
+}
+
+std::size_t TextureManager::loadAtlas(const std::string &atlasName,
+                                     const std::vector<std::pair<string, string>> &files,
+                                     int maxPageSize) {
+    // Same orientation as the backends' loadTexture().
+    stbi_set_flip_vertically_on_load_thread(true);
+    std::vector<AtlasSource> sources;
+    for (const auto &[name, path]: files) {
+        if (hasTexture(name))
+            continue;
+        AtlasSource src;
+        int channels = 0;
+        src.name = name;
+        src.rgba = stbi_load(path.c_str(), &src.width, &src.height, &channels, 4);
+        if (!src.rgba) {
+            std::cerr << "[TextureManager] Failed to load texture from " << path << "\n";
+            continue;
+        }
+        sources.push_back(src);
+    }
+
+    const TextureAtlas atlas = buildTextureAtlas(
+            sources, std::min(maxPageSize, m_backend->maxTextureSize()), kAtlasPadding);
+    std::vector<shared_ptr<Texture>> pages;
+    for (const AtlasPage &page: atlas.pages)
+        pages.push_back(m_backend->createTexture(page.width, page.height, page.rgba.data()));
+
+    std::size_t packed = 0;
+    std::size_t pageTexels = 0;
+    for (const AtlasRegion &region: atlas.regions) {
+        const shared_ptr<Texture> &page = pages[region.page];
+        if (!page)
+            continue;
+        auto tex = std::make_shared<Texture>(*page);  // borrows the page's GL name
+        tex->m_atlasPage = page.get();
+        std::copy(region.uvRect, region.uvRect + 4, tex->m_atlasRect);
+        tex->m_width = static_cast<int>(region.uvRect[2] * page->m_width + 0.5f);
+        tex->m_height = static_cast<int>(region.uvRect[3] * page->m_height + 0.5f);
+        sheetMap[region.name] = { tex, 0, 0 };
+        ++packed;
+    }
+    for (const shared_ptr<Texture> &page: pages) {
+        if (page) {
+            pageTexels += static_cast<std::size_t>(page->m_width) * page->m_height;
+            m_atlasPages.push_back(page);
+        }
+    }
+    for (std::size_t i = 0; i < sources.size(); ++i) {
+        const AtlasSource &src = sources[i];
+        if (std::find(atlas.rejected.begin(), atlas.rejected.end(), src.name) !=
+            atlas.rejected.end()) {
+            if (auto tex = m_backend->createTexture(src.width, src.height, src.rgba))
+                sheetMap[src.name] = { tex, 0, 0 };
+        }
+        stbi_image_free(const_cast<unsigned char *>(src.rgba));
+    }
+
+    std::cout << "[TextureManager] Atlas '" << atlasName << "': " << packed << " textures on "
+              << pages.size() << " page(s), "
+              << (pageTexels ? 100.0 * double(atlas.usedTexels) / double(pageTexels) : 0.0)
+              << "% used, " << atlas.rejected.size() << " loaded separately\n";
+    return packed;
+}
+
 shared_ptr<Texture> TextureManager::getTexture(const string &name) const {
     auto it = sheetMap.find(name);
     if (it == sheetMap.end()) {
@@ -87,7 +200,18 @@ bool TextureManager::registerSprite(const string &spriteName, const string &shee
         return false;
     }
     const auto &sh = it->second;
-    spriteMap[spriteName] = {sh.texture, sh.spriteWidth, sh.spriteHeight, frameIndex};
+    // Frames run left to right, top to bottom; rows are stored bottom-up.
+    glm::vec4 uv(0.0f, 0.0f, 1.0f, 1.0f);
+    if (sh.texture && sh.spriteWidth > 0 && sh.spriteHeight > 0 && sh.texture->m_width > 0 &&
+        sh.texture->m_height > 0) {
+        const int columns = std::max(1, sh.texture->m_width / sh.spriteWidth);
+        const int column = frameIndex % columns, row = frameIndex / columns;
+        uv.z = float(sh.spriteWidth) / float(sh.texture->m_width);
+        uv.w = float(sh.spriteHeight) / float(sh.texture->m_height);
+        uv.x = column * uv.z;
+        uv.y = 1.0f - (row + 1) * uv.w;
+    }
+    spriteMap[spriteName] = {sh.texture, sh.spriteWidth, sh.spriteHeight, frameIndex, uv};
     return true;
 }
 
@@ -4,7 +4,12 @@
 #include <unordered_map>
 #include <memory>
 #include <cstdint>
+#include <utility>
+#include <vector>
+#include <glm/glm.hpp>
+#include "renderBackend.h"
 #include "texture.h"
+#include "textureLoader.h"
 
 using namespace std;
 
@@ -14,6 +19,8 @@ struct SpriteInfo {
     int spriteWidth;               // width of a single frame
     int spriteHeight;              // height of a single frame
     int frameIndex;                // index of the frame within the sheet
+    glm::vec4 uvRect;              // the frame within the sheet: xy offset, zw size
+                                   // (for SceneObject::m_uvRect)
 };
 
 class TextureManager {
@@ -21,9 +28,27 @@ public:
     /// Get the singleton instance
     static shared_ptr<TextureManager> instance();
 
+    /// Where textures are created; a null backend (no GL) until the app
+    /// installs GlRenderBackend. Passing nullptr restores the null backend.
+    void setBackend(std::shared_ptr<RenderBackend> backend);
+
     /// Load a plain texture under 'name'
     bool loadTexture(const string &name, const string &filePath);
 
+    /**
+     * Register a texture under 'name' right away and decode the file in the
+     * background (see TextureLoader); it draws as a placeholder until a later
+     * uploadPendingTextures() finishes it. Render thread, like loadTexture().
+     */
+    void loadTextureAsync(const string &name, const string &filePath);
+
+    /// Render thread, once per frame: upload decoded textures within the
+    /// loader's per-frame budget. Returns the bytes uploaded.
+    std::size_t uploadPendingTextures();
+
+    /// Decode/upload counters; all zero until the first loadTextureAsync().
+    TextureLoadStats textureLoadStats() const;
+
     /// Create a CPU-updatable RGBA texture under 'name'
     bool createDynamicTexture(const std::string &name,
                               int width,
@@ -35,6 +60,30 @@ public:
                               const unsigned char *rgba,
                               bool regenerateMipmaps = false);
 
+    /**
+     * Upload only `dirty` (clamped to the texture) of `rgba`, the whole
+     * image, and only if `version` differs from the stamp of the last
+     * upload: callers bump it whenever the pixels change and can call this
+     * every frame. Returns false only if there is no such texture.
+     */
+    bool updateDynamicTexture(const std::string &name,
+                              const unsigned char *rgba,
+                              uint64_t version,
+                              const TextureRegion &dirty,
+                              bool regenerateMipmaps = false);
+
+    /**
+     * Decode `files` ({name, path}) now and pack them into as few atlas
+     * pages as fit (textureAtlas.h), registering each name as a region of
+     * its page. Sprites of any of them then share one texture and batch
+     * together; Platform's repeat tiling wraps inside the region (sprite.fs).
+     * Names already loaded are skipped, images too large for a page are
+     * loaded on their own. Returns how many names were packed.
+     */
+    std::size_t loadAtlas(const string &atlasName,
+                          const std::vector<std::pair<string, string>> &files,
+                          int maxPageSize = 4096);
+
     /// Retrieve the Texture pointer you previously loaded (or nullptr)
     shared_ptr<Texture> getTexture(const string &name) const;
 
@@ -76,6 +125,9 @@ private:
         int spriteHeight;
     };
 
+    shared_ptr<RenderBackend> m_backend = std::make_shared<NullRenderBackend>();
+    unique_ptr<TextureLoader> m_loader;  // created by the first loadTextureAsync()
+    vector<shared_ptr<Texture>> m_atlasPages;  // what atlas regions draw from
     unordered_map<string, Sheet> sheetMap;      // sheetName -> sheet data
     unordered_map<string, SpriteInfo> spriteMap; // spriteName -> frame info
 };
@@ -0,0 +1,265 @@
+#!/usr/bin/env python3
+"""Cook conv-net weights for TinyCnn (source/core/tinyCnn.h).
+
+  cnn_export.py convert SPEC.json WEIGHTS.npz OUT.inkn [--int8]
+      Write the layers SPEC lists, with weights from an np.savez /
+      np.savez_compressed archive (e.g. a PyTorch state_dict saved with
+      numpy), as a cooked .inkn (source/core/cnnFormat.h).
+
+  cnn_export.py reference MODEL.inkn INPUTS.f32
+      Run MODEL on every input in INPUTS (raw little-endian float32, one
+      model input after another) in double precision and print the outputs
+      as C++ initializers, for checking the C++ kernels against.
+
+Needs only the standard library, so it runs wherever the game builds.
+"""
+import argparse
+import ast
+import io
+import json
+import math
+import struct
+import sys
+import zipfile
+
+MAGIC = b"INKN"
+VERSION = 1
+HEADER = struct.Struct("<4s9I")
+LAYER = struct.Struct("<10I")
+CONV2D, RELU, MAX_POOL, DENSE, SOFTMAX = 1, 2, 3, 4, 5
+NONE, F32, I8 = 0, 1, 2
+LAYER_TYPES = {"conv2d": CONV2D, "relu": RELU, "maxPool": MAX_POOL, "dense": DENSE,
+               "softmax": SOFTMAX}
+
+
+# ─────────────────────────────── .npz reading ───────────────────────────────
+def read_npy(data):
+    """(shape, flat list of floats) of a .npy file's bytes."""
+    if data[:6] != b"\x93NUMPY":
+        raise ValueError("not a .npy file")
+    major = data[6]
+    header_len_size = 2 if major == 1 else 4
+    header_len = int.from_bytes(data[8:8 + header_len_size], "little")
+    start = 8 + header_len_size
+    header = ast.literal_eval(data[start:start + header_len].decode("latin1"))
+    if header["fortran_order"]:
+        raise ValueError("Fortran-ordered arrays are not supported")
+    formats = {"<f4": "f", "<f8": "d", "|i1": "b"}
+    if header["descr"] not in formats:
+        raise ValueError("unsupported dtype " + header["descr"])
+    shape = tuple(header["shape"])
+    count = math.prod(shape)
+    values = struct.unpack_from("<%d%s" % (count, formats[header["descr"]]), data,
+                                start + header_len)
+    return shape, list(values)
+
+
+def read_npz(path):
+    arrays = {}
+    with zipfile.ZipFile(path) as archive:
+        for name in archive.namelist():
+            key = name[:-4] if name.endswith(".npy") else name
+            arrays[key] = read_npy(archive.read(name))
+    return arrays
+
+
+# ──────────────────────────────── writing ────────────────────────────────
+def pad4(buf):
+    buf.extend(b"\0" * (-len(buf) % 4))
+
+
+def quantize(weights, outputs):
+    """Per-output int8 weights and scales, as TinyCnn::quantize() makes them."""
+    per_output = len(weights) // outputs
+    q, scales = [], []
+    for o in range(outputs):
+        row = weights[o * per_output:(o + 1) * per_output]
+        peak = max(abs(w) for w in row)
+        scale = peak / 127.0 if peak > 0 else 1.0
+        # Half away from zero, like std::round.
+        q.extend(max(-127, min(127, int(math.copysign(math.floor(abs(w) / scale + 0.5), w))))
+                 for w in row)
+        scales.append(scale)
+    return q, scales
+
+
+def convert(spec_path, npz_path, out_path, int8):
+    with open(spec_path) as f:
+        spec = json.load(f)
+    arrays = read_npz(npz_path)
+    channels, height, width = spec["input"]
+    layer_count = len(spec["layers"])
+    data_offset = HEADER.size + layer_count * LAYER.size
+    records, data = [], bytearray()
+
+    for layer in spec["layers"]:
+        kind = LAYER_TYPES[layer["type"]]
+        outputs, kernel, stride, padding = 0, layer.get("size", 0), layer.get("stride", 1), \
+            layer.get("padding", 0)
+        weight_type, weight_count, weight_offset, bias_offset, scale_offset = NONE, 0, 0, 0, 0
+        if kind in (CONV2D, DENSE):
+            shape, weights = arrays[layer["weight"]]
+            _, bias = arrays[layer["bias"]]
+            outputs = shape[0]
+            if kind == CONV2D:
+                kernel = shape[2]
+                height = (height + 2 * padding - kernel) // stride + 1
+                width = (width + 2 * padding - kernel) // stride + 1
+                channels = outputs
+            else:
+                channels, height, width = outputs, 1, 1
+            weight_count = len(weights)
+            weight_offset = data_offset + len(data)
+            if int8:
+                q, scales = quantize(weights, outputs)
+                weight_type = I8
+                data.extend(struct.pack("<%db" % len(q), *q))
+                pad4(data)
+                scale_offset = data_offset + len(data)
+                data.extend(struct.pack("<%df" % outputs, *scales))
+            else:
+                weight_type = F32
+                data.extend(struct.pack("<%df" % weight_count, *weights))
+            bias_offset = data_offset + len(data)
+            data.extend(struct.pack("<%df" % outputs, *bias))
+        elif kind == MAX_POOL:
+            height, width = height // kernel, width // kernel
+        if kind == RELU or kind == SOFTMAX or kind == MAX_POOL:
+            outputs = channels
+        records.append(LAYER.pack(kind, outputs, kernel, stride, padding, weight_type,
+                                  weight_count, weight_offset, bias_offset, scale_offset))
+
+    labels = [label.encode() + b"\0" for label in spec.get("labels", [])]
+    table = bytearray()
+    offset = 4 * len(labels)
+    for label in labels:
+        table.extend(struct.pack("<I", offset))
+        offset += len(label)
+    for label in labels:
+        table.extend(label)
+    pad4(table)
+
+    label_offset = data_offset + len(data)
+    file_size = label_offset + len(table)
+    c, h, w = spec["input"]
+    with open(out_path, "wb") as f:
+        f.write(HEADER.pack(MAGIC, VERSION, file_size, c, h, w, layer_count, HEADER.size,
+                            len(labels), label_offset))
+        for record in records:
+            f.write(record)
+        f.write(data)
+        f.write(table)
+    print("[cnn_export] %s -> %s: %d layers, %d bytes%s"
+          % (npz_path, out_path, layer_count, file_size, " (int8)" if int8 else ""))
+
+
+# ─────────────────────────── reference forward ───────────────────────────
+def load_model(path):
+    with open(path, "rb") as f:
+        blob = f.read()
+    magic, version, file_size, c, h, w, layer_count, layer_offset, _, _ = \
+        HEADER.unpack_from(blob)
+    if magic != MAGIC or version != VERSION or file_size != len(blob):
+        raise ValueError(path + " is not a version %d model" % VERSION)
+    layers = []
+    for i in range(layer_count):
+        r = LAYER.unpack_from(blob, layer_offset + i * LAYER.size)
+        kind, outputs, kernel, stride, padding, weight_type, count, w_off, b_off, s_off = r
+        layer = {"type": kind, "outputs": outputs, "kernel": kernel, "stride": stride,
+                 "padding": padding}
+        if weight_type == F32:
+            layer["weights"] = struct.unpack_from("<%df" % count, blob, w_off)
+        elif weight_type == I8:
+            q = struct.unpack_from("<%db" % count, blob, w_off)
+            scales = struct.unpack_from("<%df" % outputs, blob, s_off)
+            per_output = count // outputs
+            layer["weights"] = [q[i] * scales[i // per_output] for i in range(count)]
+        if weight_type != NONE:
+            layer["bias"] = struct.unpack_from("<%df" % outputs, blob, b_off)
+        layers.append(layer)
+    return (c, h, w), layers
+
+
+def forward(shape, layers, x):
+    c, h, w = shape
+    for layer in layers:
+        kind = layer["type"]
+        if kind == CONV2D:
+            k, s, p, out_c = layer["kernel"], layer["stride"], layer["padding"], layer["outputs"]
+            out_h, out_w = (h + 2 * p - k) // s + 1, (w + 2 * p - k) // s + 1
+            weights, bias = layer["weights"], layer["bias"]
+            y = []
+            for o in range(out_c):
+                for oy in range(out_h):
+                    for ox in range(out_w):
+                        acc = bias[o]
+                        for i in range(c):
+                            for ky in range(k):
+                                iy = oy * s + ky - p
+                                if iy < 0 or iy >= h:
+                                    continue
+                                for kx in range(k):
+                                    ix = ox * s + kx - p
+                                    if 0 <= ix < w:
+                                        acc += weights[((o * c + i) * k + ky) * k + kx] * \
+                                            x[(i * h + iy) * w + ix]
+                        y.append(acc)
+            x, c, h, w = y, out_c, out_h, out_w
+        elif kind == DENSE:
+            weights, bias, n = layer["weights"], layer["bias"], len(x)
+            x = [bias[o] + sum(weights[o * n + i] * x[i] for i in range(n))
+                 for o in range(layer["outputs"])]
+            c, h, w = layer["outputs"], 1, 1
+        elif kind == RELU:
+            x = [max(v, 0.0) for v in x]
+        elif kind == MAX_POOL:
+            k = layer["kernel"]
+            out_h, out_w = h // k, w // k
+            x = [max(x[(i * h + oy * k + dy) * w + ox * k + dx]
+                     for dy in range(k) for dx in range(k))
+                 for i in range(c) for oy in range(out_h) for ox in range(out_w)]
+            h, w = out_h, out_w
+        elif kind == SOFTMAX:
+            m = max(x)
+            e = [math.exp(v - m) for v in x]
+            total = sum(e)
+            x = [v / total for v in e]
+    return x
+
+
+def reference(model_path, inputs_path):
+    shape, layers = load_model(model_path)
+    size = math.prod(shape)
+    with open(inputs_path, "rb") as f:
+        blob = f.read()
+    count = len(blob) // (4 * size)
+    out = io.StringIO()
+    for n in range(count):
+        x = list(struct.unpack_from("<%df" % size, blob, n * 4 * size))
+        y = forward(shape, layers, x)
+        values = ["%.9ef" % v for v in y]
+        rows = [", ".join(values[i:i + 5]) for i in range(0, len(values), 5)]
+        out.write("    {" + ",\n     ".join(rows) + "},\n")
+    sys.stdout.write(out.getvalue())
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    commands = parser.add_subparsers(dest="command", required=True)
+    c = commands.add_parser("convert", help="npz weights + layer spec -> .inkn")
+    c.add_argument("spec")
+    c.add_argument("weights")
+    c.add_argument("out")
+    c.add_argument("--int8", action="store_true", help="store conv/dense weights as int8")
+    r = commands.add_parser("reference", help="print a model's outputs for raw float inputs")
+    r.add_argument("model")
+    r.add_argument("inputs")
+    args = parser.parse_args()
+    if args.command == "convert":
+        convert(args.spec, args.weights, args.out, args.int8)
+    else:
+        reference(args.model, args.inputs)
+
+
+if __name__ == "__main__":
+    main()
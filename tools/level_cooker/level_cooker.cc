@@ -0,0 +1,27 @@
+// level_cooker: JSON levels (authoring format) -> cooked .inkl files.
+//
+//     InkLevelCooker assets/levels/level1.json [more.json ...]
+//
+// Each input is written next to itself with the .inkl extension, which is
+// where loadLevel() looks for it.
+#include "core/levelCooker.h"
+#include "core/levelFormat.h"
+
+#include <filesystem>
+#include <iostream>
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " level.json [level.json ...]\n";
+        return 2;
+    }
+    int failures = 0;
+    for (int i = 1; i < argc; ++i) {
+        const std::filesystem::path in(argv[i]);
+        const std::filesystem::path out =
+                std::filesystem::path(in).replace_extension(LevelFormat::kExtension);
+        if (!cookLevel(in.string(), out.string()))
+            ++failures;
+    }
+    return failures == 0 ? 0 : 1;
+}